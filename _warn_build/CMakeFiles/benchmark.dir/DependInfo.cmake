@@ -0,0 +1,37 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/benchmark_test.cpp" "CMakeFiles/benchmark.dir/benchmark_test.cpp.o" "gcc" "CMakeFiles/benchmark.dir/benchmark_test.cpp.o.d"
+  "/root/repo/src/bloom_filter/bloom_filter.cpp" "CMakeFiles/benchmark.dir/src/bloom_filter/bloom_filter.cpp.o" "gcc" "CMakeFiles/benchmark.dir/src/bloom_filter/bloom_filter.cpp.o.d"
+  "/root/repo/src/column_types/column_types.cpp" "CMakeFiles/benchmark.dir/src/column_types/column_types.cpp.o" "gcc" "CMakeFiles/benchmark.dir/src/column_types/column_types.cpp.o.d"
+  "/root/repo/src/csv_wrapper/csv_wrapper.cpp" "CMakeFiles/benchmark.dir/src/csv_wrapper/csv_wrapper.cpp.o" "gcc" "CMakeFiles/benchmark.dir/src/csv_wrapper/csv_wrapper.cpp.o.d"
+  "/root/repo/src/expressions/expressions.cpp" "CMakeFiles/benchmark.dir/src/expressions/expressions.cpp.o" "gcc" "CMakeFiles/benchmark.dir/src/expressions/expressions.cpp.o.d"
+  "/root/repo/src/external_sort/external_sort.cpp" "CMakeFiles/benchmark.dir/src/external_sort/external_sort.cpp.o" "gcc" "CMakeFiles/benchmark.dir/src/external_sort/external_sort.cpp.o.d"
+  "/root/repo/src/file_reader/file_reader.cpp" "CMakeFiles/benchmark.dir/src/file_reader/file_reader.cpp.o" "gcc" "CMakeFiles/benchmark.dir/src/file_reader/file_reader.cpp.o.d"
+  "/root/repo/src/file_writer/file_writer.cpp" "CMakeFiles/benchmark.dir/src/file_writer/file_writer.cpp.o" "gcc" "CMakeFiles/benchmark.dir/src/file_writer/file_writer.cpp.o.d"
+  "/root/repo/src/hash_set/hash_set.cpp" "CMakeFiles/benchmark.dir/src/hash_set/hash_set.cpp.o" "gcc" "CMakeFiles/benchmark.dir/src/hash_set/hash_set.cpp.o.d"
+  "/root/repo/src/hyperloglog/hyperloglog.cpp" "CMakeFiles/benchmark.dir/src/hyperloglog/hyperloglog.cpp.o" "gcc" "CMakeFiles/benchmark.dir/src/hyperloglog/hyperloglog.cpp.o.d"
+  "/root/repo/src/operators/operators.cpp" "CMakeFiles/benchmark.dir/src/operators/operators.cpp.o" "gcc" "CMakeFiles/benchmark.dir/src/operators/operators.cpp.o.d"
+  "/root/repo/src/query_arena/query_arena.cpp" "CMakeFiles/benchmark.dir/src/query_arena/query_arena.cpp.o" "gcc" "CMakeFiles/benchmark.dir/src/query_arena/query_arena.cpp.o.d"
+  "/root/repo/src/regex/regex.cpp" "CMakeFiles/benchmark.dir/src/regex/regex.cpp.o" "gcc" "CMakeFiles/benchmark.dir/src/regex/regex.cpp.o.d"
+  "/root/repo/src/scheme/scheme.cpp" "CMakeFiles/benchmark.dir/src/scheme/scheme.cpp.o" "gcc" "CMakeFiles/benchmark.dir/src/scheme/scheme.cpp.o.d"
+  "/root/repo/src/string_functions/string_functions.cpp" "CMakeFiles/benchmark.dir/src/string_functions/string_functions.cpp.o" "gcc" "CMakeFiles/benchmark.dir/src/string_functions/string_functions.cpp.o.d"
+  "/root/repo/src/thread_pool/thread_pool.cpp" "CMakeFiles/benchmark.dir/src/thread_pool/thread_pool.cpp.o" "gcc" "CMakeFiles/benchmark.dir/src/thread_pool/thread_pool.cpp.o.d"
+  "/root/repo/src/utilities/utilities.cpp" "CMakeFiles/benchmark.dir/src/utilities/utilities.cpp.o" "gcc" "CMakeFiles/benchmark.dir/src/utilities/utilities.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_warn_build/_deps/googletest-build/googletest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  "/root/repo/_warn_build/_deps/googletest-build/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,44 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchmark.dir/benchmark_test.cpp.o"
+  "CMakeFiles/benchmark.dir/benchmark_test.cpp.o.d"
+  "CMakeFiles/benchmark.dir/src/bloom_filter/bloom_filter.cpp.o"
+  "CMakeFiles/benchmark.dir/src/bloom_filter/bloom_filter.cpp.o.d"
+  "CMakeFiles/benchmark.dir/src/column_types/column_types.cpp.o"
+  "CMakeFiles/benchmark.dir/src/column_types/column_types.cpp.o.d"
+  "CMakeFiles/benchmark.dir/src/csv_wrapper/csv_wrapper.cpp.o"
+  "CMakeFiles/benchmark.dir/src/csv_wrapper/csv_wrapper.cpp.o.d"
+  "CMakeFiles/benchmark.dir/src/expressions/expressions.cpp.o"
+  "CMakeFiles/benchmark.dir/src/expressions/expressions.cpp.o.d"
+  "CMakeFiles/benchmark.dir/src/external_sort/external_sort.cpp.o"
+  "CMakeFiles/benchmark.dir/src/external_sort/external_sort.cpp.o.d"
+  "CMakeFiles/benchmark.dir/src/file_reader/file_reader.cpp.o"
+  "CMakeFiles/benchmark.dir/src/file_reader/file_reader.cpp.o.d"
+  "CMakeFiles/benchmark.dir/src/file_writer/file_writer.cpp.o"
+  "CMakeFiles/benchmark.dir/src/file_writer/file_writer.cpp.o.d"
+  "CMakeFiles/benchmark.dir/src/hash_set/hash_set.cpp.o"
+  "CMakeFiles/benchmark.dir/src/hash_set/hash_set.cpp.o.d"
+  "CMakeFiles/benchmark.dir/src/hyperloglog/hyperloglog.cpp.o"
+  "CMakeFiles/benchmark.dir/src/hyperloglog/hyperloglog.cpp.o.d"
+  "CMakeFiles/benchmark.dir/src/operators/operators.cpp.o"
+  "CMakeFiles/benchmark.dir/src/operators/operators.cpp.o.d"
+  "CMakeFiles/benchmark.dir/src/query_arena/query_arena.cpp.o"
+  "CMakeFiles/benchmark.dir/src/query_arena/query_arena.cpp.o.d"
+  "CMakeFiles/benchmark.dir/src/regex/regex.cpp.o"
+  "CMakeFiles/benchmark.dir/src/regex/regex.cpp.o.d"
+  "CMakeFiles/benchmark.dir/src/scheme/scheme.cpp.o"
+  "CMakeFiles/benchmark.dir/src/scheme/scheme.cpp.o.d"
+  "CMakeFiles/benchmark.dir/src/string_functions/string_functions.cpp.o"
+  "CMakeFiles/benchmark.dir/src/string_functions/string_functions.cpp.o.d"
+  "CMakeFiles/benchmark.dir/src/thread_pool/thread_pool.cpp.o"
+  "CMakeFiles/benchmark.dir/src/thread_pool/thread_pool.cpp.o.d"
+  "CMakeFiles/benchmark.dir/src/utilities/utilities.cpp.o"
+  "CMakeFiles/benchmark.dir/src/utilities/utilities.cpp.o.d"
+  "benchmark"
+  "benchmark.pdb"
+  "benchmark[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
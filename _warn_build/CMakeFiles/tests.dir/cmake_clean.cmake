@@ -0,0 +1,44 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tests.dir/src/bloom_filter/bloom_filter.cpp.o"
+  "CMakeFiles/tests.dir/src/bloom_filter/bloom_filter.cpp.o.d"
+  "CMakeFiles/tests.dir/src/column_types/column_types.cpp.o"
+  "CMakeFiles/tests.dir/src/column_types/column_types.cpp.o.d"
+  "CMakeFiles/tests.dir/src/csv_wrapper/csv_wrapper.cpp.o"
+  "CMakeFiles/tests.dir/src/csv_wrapper/csv_wrapper.cpp.o.d"
+  "CMakeFiles/tests.dir/src/expressions/expressions.cpp.o"
+  "CMakeFiles/tests.dir/src/expressions/expressions.cpp.o.d"
+  "CMakeFiles/tests.dir/src/external_sort/external_sort.cpp.o"
+  "CMakeFiles/tests.dir/src/external_sort/external_sort.cpp.o.d"
+  "CMakeFiles/tests.dir/src/file_reader/file_reader.cpp.o"
+  "CMakeFiles/tests.dir/src/file_reader/file_reader.cpp.o.d"
+  "CMakeFiles/tests.dir/src/file_writer/file_writer.cpp.o"
+  "CMakeFiles/tests.dir/src/file_writer/file_writer.cpp.o.d"
+  "CMakeFiles/tests.dir/src/hash_set/hash_set.cpp.o"
+  "CMakeFiles/tests.dir/src/hash_set/hash_set.cpp.o.d"
+  "CMakeFiles/tests.dir/src/hyperloglog/hyperloglog.cpp.o"
+  "CMakeFiles/tests.dir/src/hyperloglog/hyperloglog.cpp.o.d"
+  "CMakeFiles/tests.dir/src/operators/operators.cpp.o"
+  "CMakeFiles/tests.dir/src/operators/operators.cpp.o.d"
+  "CMakeFiles/tests.dir/src/query_arena/query_arena.cpp.o"
+  "CMakeFiles/tests.dir/src/query_arena/query_arena.cpp.o.d"
+  "CMakeFiles/tests.dir/src/regex/regex.cpp.o"
+  "CMakeFiles/tests.dir/src/regex/regex.cpp.o.d"
+  "CMakeFiles/tests.dir/src/scheme/scheme.cpp.o"
+  "CMakeFiles/tests.dir/src/scheme/scheme.cpp.o.d"
+  "CMakeFiles/tests.dir/src/string_functions/string_functions.cpp.o"
+  "CMakeFiles/tests.dir/src/string_functions/string_functions.cpp.o.d"
+  "CMakeFiles/tests.dir/src/thread_pool/thread_pool.cpp.o"
+  "CMakeFiles/tests.dir/src/thread_pool/thread_pool.cpp.o.d"
+  "CMakeFiles/tests.dir/src/utilities/utilities.cpp.o"
+  "CMakeFiles/tests.dir/src/utilities/utilities.cpp.o.d"
+  "CMakeFiles/tests.dir/test.cpp.o"
+  "CMakeFiles/tests.dir/test.cpp.o.d"
+  "tests"
+  "tests.pdb"
+  "tests[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_warn_build/benchmark[1]_tests.cmake")
+  include("/root/repo/_warn_build/benchmark[1]_tests.cmake")
+else()
+  add_test(benchmark_NOT_BUILT benchmark_NOT_BUILT)
+endif()
@@ -0,0 +1,91 @@
+add_test([=[ClickBenchQueriesTest.BuildHitsColumnarFile]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.BuildHitsColumnarFile]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.BuildHitsColumnarFile]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query1]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query1]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query1]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query2]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query2]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query2]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query3]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query3]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query3]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query4]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query4]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query4]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query5]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query5]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query5]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query6]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query6]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query6]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query7]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query7]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query7]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query8]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query8]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query8]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query9]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query9]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query9]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query10]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query10]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query10]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query11]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query11]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query11]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query12]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query12]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query12]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query13]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query13]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query13]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query14]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query14]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query14]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query15]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query15]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query15]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query16]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query16]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query16]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query16Parallel]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query16Parallel]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query16Parallel]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query17]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query17]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query17]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query18]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query18]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query18]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query19]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query19]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query19]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query20]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query20]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query20]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query21]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query21]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query21]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query22]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query22]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query22]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query23]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query23]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query23]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query24]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query24]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query24]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query25]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query25]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query25]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query26]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query26]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query26]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query27]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query27]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query27]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query28]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query28]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query28]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query29]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query29]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query29]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query30]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query30]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query30]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query31]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query31]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query31]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query32]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query32]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query32]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query33]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query33]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query33]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query34]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query34]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query34]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query35]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query35]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query35]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query36]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query36]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query36]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query37]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query37]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query37]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query38]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query38]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query38]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query39]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query39]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query39]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query40]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query40]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query40]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query41]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query41]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query41]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query42]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query42]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query42]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ClickBenchQueriesTest.Query43]=]  /root/repo/_warn_build/benchmark [==[--gtest_filter=ClickBenchQueriesTest.Query43]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ClickBenchQueriesTest.Query43]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  benchmark_TESTS ClickBenchQueriesTest.BuildHitsColumnarFile ClickBenchQueriesTest.Query1 ClickBenchQueriesTest.Query2 ClickBenchQueriesTest.Query3 ClickBenchQueriesTest.Query4 ClickBenchQueriesTest.Query5 ClickBenchQueriesTest.Query6 ClickBenchQueriesTest.Query7 ClickBenchQueriesTest.Query8 ClickBenchQueriesTest.Query9 ClickBenchQueriesTest.Query10 ClickBenchQueriesTest.Query11 ClickBenchQueriesTest.Query12 ClickBenchQueriesTest.Query13 ClickBenchQueriesTest.Query14 ClickBenchQueriesTest.Query15 ClickBenchQueriesTest.Query16 ClickBenchQueriesTest.Query16Parallel ClickBenchQueriesTest.Query17 ClickBenchQueriesTest.Query18 ClickBenchQueriesTest.Query19 ClickBenchQueriesTest.Query20 ClickBenchQueriesTest.Query21 ClickBenchQueriesTest.Query22 ClickBenchQueriesTest.Query23 ClickBenchQueriesTest.Query24 ClickBenchQueriesTest.Query25 ClickBenchQueriesTest.Query26 ClickBenchQueriesTest.Query27 ClickBenchQueriesTest.Query28 ClickBenchQueriesTest.Query29 ClickBenchQueriesTest.Query30 ClickBenchQueriesTest.Query31 ClickBenchQueriesTest.Query32 ClickBenchQueriesTest.Query33 ClickBenchQueriesTest.Query34 ClickBenchQueriesTest.Query35 ClickBenchQueriesTest.Query36 ClickBenchQueriesTest.Query37 ClickBenchQueriesTest.Query38 ClickBenchQueriesTest.Query39 ClickBenchQueriesTest.Query40 ClickBenchQueriesTest.Query41 ClickBenchQueriesTest.Query42 ClickBenchQueriesTest.Query43)
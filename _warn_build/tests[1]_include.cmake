@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_warn_build/tests[1]_tests.cmake")
+  include("/root/repo/_warn_build/tests[1]_tests.cmake")
+else()
+  add_test(tests_NOT_BUILT tests_NOT_BUILT)
+endif()
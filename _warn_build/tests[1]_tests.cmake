@@ -0,0 +1,109 @@
+add_test([=[CSVWrapperCreateFileTest.EmptyFile]=]  /root/repo/_warn_build/tests [==[--gtest_filter=CSVWrapperCreateFileTest.EmptyFile]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CSVWrapperCreateFileTest.EmptyFile]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CSVWrapperBasicFileTest.ReadBasicCSV]=]  /root/repo/_warn_build/tests [==[--gtest_filter=CSVWrapperBasicFileTest.ReadBasicCSV]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CSVWrapperBasicFileTest.ReadBasicCSV]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[RowGroupWriterTest.JustWorks]=]  /root/repo/_warn_build/tests [==[--gtest_filter=RowGroupWriterTest.JustWorks]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[RowGroupWriterTest.JustWorks]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[RowGroupWriterTest.ExtendedStatsTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=RowGroupWriterTest.ExtendedStatsTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[RowGroupWriterTest.ExtendedStatsTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[RowGroupReaderTest.SimpleTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=RowGroupReaderTest.SimpleTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[RowGroupReaderTest.SimpleTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[RowGroupReaderTest.ParallelDecodeTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=RowGroupReaderTest.ParallelDecodeTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[RowGroupReaderTest.ParallelDecodeTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[RowGroupReaderTest.RecycleBatchTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=RowGroupReaderTest.RecycleBatchTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[RowGroupReaderTest.RecycleBatchTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[RowGroupReaderTest.GenerateBigFileCsv]=]  /root/repo/_warn_build/tests [==[--gtest_filter=RowGroupReaderTest.GenerateBigFileCsv]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[RowGroupReaderTest.GenerateBigFileCsv]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[RowGroupReaderTest.BigFile]=]  /root/repo/_warn_build/tests [==[--gtest_filter=RowGroupReaderTest.BigFile]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[RowGroupReaderTest.BigFile]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BasicOperatorsTest.ScanOperatorTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=BasicOperatorsTest.ScanOperatorTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BasicOperatorsTest.ScanOperatorTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BasicOperatorsTest.ScanVectorSizeTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=BasicOperatorsTest.ScanVectorSizeTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BasicOperatorsTest.ScanVectorSizeTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BasicOperatorsTest.CompareOperatorTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=BasicOperatorsTest.CompareOperatorTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BasicOperatorsTest.CompareOperatorTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BasicOperatorsTest.AndFilterOperatorTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=BasicOperatorsTest.AndFilterOperatorTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BasicOperatorsTest.AndFilterOperatorTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BasicOperatorsTest.LikeFilterOperatorTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=BasicOperatorsTest.LikeFilterOperatorTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BasicOperatorsTest.LikeFilterOperatorTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BasicOperatorsTest.AdaptiveFilterOrderTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=BasicOperatorsTest.AdaptiveFilterOrderTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BasicOperatorsTest.AdaptiveFilterOrderTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BasicOperatorsTest.InFilterOperatorTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=BasicOperatorsTest.InFilterOperatorTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BasicOperatorsTest.InFilterOperatorTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BasicOperatorsTest.PruneFilterTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=BasicOperatorsTest.PruneFilterTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BasicOperatorsTest.PruneFilterTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BasicOperatorsTest.BloomFilterPruneTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=BasicOperatorsTest.BloomFilterPruneTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BasicOperatorsTest.BloomFilterPruneTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BasicOperatorsTest.NgramIndexPruneTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=BasicOperatorsTest.NgramIndexPruneTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BasicOperatorsTest.NgramIndexPruneTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BloomFilterTest.InsertAndSerialize]=]  /root/repo/_warn_build/tests [==[--gtest_filter=BloomFilterTest.InsertAndSerialize]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BloomFilterTest.InsertAndSerialize]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[StringFunctionsTest.LikeMatcher]=]  /root/repo/_warn_build/tests [==[--gtest_filter=StringFunctionsTest.LikeMatcher]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[StringFunctionsTest.LikeMatcher]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[StringFunctionsTest.UrlFunctions]=]  /root/repo/_warn_build/tests [==[--gtest_filter=StringFunctionsTest.UrlFunctions]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[StringFunctionsTest.UrlFunctions]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[RegexTest.SearchFindReplace]=]  /root/repo/_warn_build/tests [==[--gtest_filter=RegexTest.SearchFindReplace]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[RegexTest.SearchFindReplace]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[GlobalAggregationOperatorTest.Sum]=]  /root/repo/_warn_build/tests [==[--gtest_filter=GlobalAggregationOperatorTest.Sum]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[GlobalAggregationOperatorTest.Sum]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[GlobalAggregationOperatorTest.Max]=]  /root/repo/_warn_build/tests [==[--gtest_filter=GlobalAggregationOperatorTest.Max]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[GlobalAggregationOperatorTest.Max]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[GlobalAggregationOperatorTest.CountDistinct]=]  /root/repo/_warn_build/tests [==[--gtest_filter=GlobalAggregationOperatorTest.CountDistinct]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[GlobalAggregationOperatorTest.CountDistinct]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[GlobalAggregationOperatorTest.ApproxCountDistinct]=]  /root/repo/_warn_build/tests [==[--gtest_filter=GlobalAggregationOperatorTest.ApproxCountDistinct]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[GlobalAggregationOperatorTest.ApproxCountDistinct]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[GlobalAggregationOperatorTest.Avg]=]  /root/repo/_warn_build/tests [==[--gtest_filter=GlobalAggregationOperatorTest.Avg]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[GlobalAggregationOperatorTest.Avg]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[GlobalAggregationOperatorTest.ManyAggregations]=]  /root/repo/_warn_build/tests [==[--gtest_filter=GlobalAggregationOperatorTest.ManyAggregations]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[GlobalAggregationOperatorTest.ManyAggregations]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[GlobalAggregationOperatorTest.StatsOnlyTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=GlobalAggregationOperatorTest.StatsOnlyTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[GlobalAggregationOperatorTest.StatsOnlyTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[HashSetTest.DistinctSets]=]  /root/repo/_warn_build/tests [==[--gtest_filter=HashSetTest.DistinctSets]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[HashSetTest.DistinctSets]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[HyperLogLogTest.EstimateAndMerge]=]  /root/repo/_warn_build/tests [==[--gtest_filter=HyperLogLogTest.EstimateAndMerge]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[HyperLogLogTest.EstimateAndMerge]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[GroupByAggregationOperatorTest.BasicTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=GroupByAggregationOperatorTest.BasicTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[GroupByAggregationOperatorTest.BasicTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[GroupByAggregationOperatorTest.CountDistinctTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=GroupByAggregationOperatorTest.CountDistinctTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[GroupByAggregationOperatorTest.CountDistinctTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExpressionTest.FilterAndAggregateExpressions]=]  /root/repo/_warn_build/tests [==[--gtest_filter=ExpressionTest.FilterAndAggregateExpressions]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExpressionTest.FilterAndAggregateExpressions]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExpressionTest.DateTimeExpressions]=]  /root/repo/_warn_build/tests [==[--gtest_filter=ExpressionTest.DateTimeExpressions]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExpressionTest.DateTimeExpressions]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExpressionTest.StringAndRegexpExpressions]=]  /root/repo/_warn_build/tests [==[--gtest_filter=ExpressionTest.StringAndRegexpExpressions]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExpressionTest.StringAndRegexpExpressions]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ProjectionOperatorTest.DerivedColumns]=]  /root/repo/_warn_build/tests [==[--gtest_filter=ProjectionOperatorTest.DerivedColumns]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ProjectionOperatorTest.DerivedColumns]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ProjectionOperatorTest.PushPipelineTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=ProjectionOperatorTest.PushPipelineTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ProjectionOperatorTest.PushPipelineTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[QueryArenaTest.AllocationAndReleaseTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=QueryArenaTest.AllocationAndReleaseTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[QueryArenaTest.AllocationAndReleaseTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[QueryArenaTest.GroupByTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=QueryArenaTest.GroupByTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[QueryArenaTest.GroupByTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ThreadPoolTest.TaskGroupTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=ThreadPoolTest.TaskGroupTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ThreadPoolTest.TaskGroupTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ParallelOperatorTest.MergeAndGatherTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=ParallelOperatorTest.MergeAndGatherTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ParallelOperatorTest.MergeAndGatherTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ParallelOperatorTest.BoundedGatherTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=ParallelOperatorTest.BoundedGatherTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ParallelOperatorTest.BoundedGatherTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderByLimitKOperatorTest.BasicTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=OrderByLimitKOperatorTest.BasicTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderByLimitKOperatorTest.BasicTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderByLimitKOperatorTest.StatsOrderedScanTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=OrderByLimitKOperatorTest.StatsOrderedScanTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderByLimitKOperatorTest.StatsOrderedScanTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderByLimitKOperatorTest.LateMaterializedTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=OrderByLimitKOperatorTest.LateMaterializedTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderByLimitKOperatorTest.LateMaterializedTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderByLimitKOperatorTest.ThresholdFilterTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=OrderByLimitKOperatorTest.ThresholdFilterTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderByLimitKOperatorTest.ThresholdFilterTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderByOperatorTest.BasicTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=OrderByOperatorTest.BasicTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderByOperatorTest.BasicTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderByOperatorTest.MixedDirectionTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=OrderByOperatorTest.MixedDirectionTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderByOperatorTest.MixedDirectionTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderByOperatorTest.SpillTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=OrderByOperatorTest.SpillTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderByOperatorTest.SpillTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderByOperatorTest.SpillManyRunsTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=OrderByOperatorTest.SpillManyRunsTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderByOperatorTest.SpillManyRunsTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExternalSortTest.MergeRuns]=]  /root/repo/_warn_build/tests [==[--gtest_filter=ExternalSortTest.MergeRuns]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExternalSortTest.MergeRuns]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[GroupByOrderByLimitKOperatorTest.BasicTest]=]  /root/repo/_warn_build/tests [==[--gtest_filter=GroupByOrderByLimitKOperatorTest.BasicTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[GroupByOrderByLimitKOperatorTest.BasicTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  tests_TESTS CSVWrapperCreateFileTest.EmptyFile CSVWrapperBasicFileTest.ReadBasicCSV RowGroupWriterTest.JustWorks RowGroupWriterTest.ExtendedStatsTest RowGroupReaderTest.SimpleTest RowGroupReaderTest.ParallelDecodeTest RowGroupReaderTest.RecycleBatchTest RowGroupReaderTest.GenerateBigFileCsv RowGroupReaderTest.BigFile BasicOperatorsTest.ScanOperatorTest BasicOperatorsTest.ScanVectorSizeTest BasicOperatorsTest.CompareOperatorTest BasicOperatorsTest.AndFilterOperatorTest BasicOperatorsTest.LikeFilterOperatorTest BasicOperatorsTest.AdaptiveFilterOrderTest BasicOperatorsTest.InFilterOperatorTest BasicOperatorsTest.PruneFilterTest BasicOperatorsTest.BloomFilterPruneTest BasicOperatorsTest.NgramIndexPruneTest BloomFilterTest.InsertAndSerialize StringFunctionsTest.LikeMatcher StringFunctionsTest.UrlFunctions RegexTest.SearchFindReplace GlobalAggregationOperatorTest.Sum GlobalAggregationOperatorTest.Max GlobalAggregationOperatorTest.CountDistinct GlobalAggregationOperatorTest.ApproxCountDistinct GlobalAggregationOperatorTest.Avg GlobalAggregationOperatorTest.ManyAggregations GlobalAggregationOperatorTest.StatsOnlyTest HashSetTest.DistinctSets HyperLogLogTest.EstimateAndMerge GroupByAggregationOperatorTest.BasicTest GroupByAggregationOperatorTest.CountDistinctTest ExpressionTest.FilterAndAggregateExpressions ExpressionTest.DateTimeExpressions ExpressionTest.StringAndRegexpExpressions ProjectionOperatorTest.DerivedColumns ProjectionOperatorTest.PushPipelineTest QueryArenaTest.AllocationAndReleaseTest QueryArenaTest.GroupByTest ThreadPoolTest.TaskGroupTest ParallelOperatorTest.MergeAndGatherTest ParallelOperatorTest.BoundedGatherTest OrderByLimitKOperatorTest.BasicTest OrderByLimitKOperatorTest.StatsOrderedScanTest OrderByLimitKOperatorTest.LateMaterializedTest OrderByLimitKOperatorTest.ThresholdFilterTest OrderByOperatorTest.BasicTest OrderByOperatorTest.MixedDirectionTest OrderByOperatorTest.SpillTest OrderByOperatorTest.SpillManyRunsTest ExternalSortTest.MergeRuns GroupByOrderByLimitKOperatorTest.BasicTest)
@@ -6,6 +6,7 @@
 #include "src/file_reader/file_reader.h"
 #include "src/scheme/scheme.h"
 #include "src/operators/operators.h"
+#include "src/query_arena/query_arena.h"
 
 #include <filesystem>
 #include <sstream>
@@ -19,33 +20,6 @@ Scheme GetDbScheme(const char* input_db_file) {
     return reader.GetScheme();
 }
 
-std::string ExtractRefererHost(const std::string& referer) {
-    std::string_view host = referer;
-    constexpr std::string_view http_prefix = "http://";
-    constexpr std::string_view https_prefix = "https://";
-    if (host.starts_with(http_prefix)) {
-        host.remove_prefix(http_prefix.size());
-    } else if (host.starts_with(https_prefix)) {
-        host.remove_prefix(https_prefix.size());
-    }
-    constexpr std::string_view www_prefix = "www.";
-    if (host.starts_with(www_prefix)) {
-        host.remove_prefix(www_prefix.size());
-    }
-    size_t slash_pos = host.find('/');
-    if (slash_pos != std::string_view::npos) {
-        host = host.substr(0, slash_pos);
-    }
-    return std::string(host);
-}
-
-std::string TruncateToMinute(const std::string& event_time) {
-    if (event_time.size() < 16) {
-        return event_time;
-    }
-    return event_time.substr(0, 16) + ":00";
-}
-
 std::vector<int64_t> GetHitsColumnTypes() {
     return {
         static_cast<int64_t>(Types::TypeInt64),     // WatchID
@@ -167,6 +141,12 @@ TEST(ClickBenchQueriesTest, BuildHitsColumnarFile) {
     ASSERT_TRUE(output.is_open());
     RowGroupWriter writer(std::move(parser), output, scheme);
     writer.SetProgressLogging(true);
+    writer.SetExtendedStats(true);
+    writer.SetBloomFilter("CounterID");
+    writer.SetBloomFilter("RefererHash");
+    writer.SetBloomFilter("URLHash");
+    writer.SetNgramIndex("URL");
+    writer.SetNgramIndex("Title");
     writer.WriteAll();
     output.close();
     ASSERT_TRUE(std::filesystem::exists(output_file));
@@ -322,11 +302,11 @@ TEST(ClickBenchQueriesTest, Query9) {
     std::vector<std::string> group_by_fields{"RegionID"};
     std::vector<std::string> aggr_cols{"UserID"};
     std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::CountDistinct};
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{1};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 2);
@@ -352,11 +332,11 @@ TEST(ClickBenchQueriesTest, Query10) {
         GlobalAggregationOperator::Op::AVG,
         GlobalAggregationOperator::Op::CountDistinct
     };
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{2};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 5);
@@ -391,11 +371,11 @@ TEST(ClickBenchQueriesTest, Query11) {
     std::vector<std::string> group_by_fields{"MobilePhoneModel"};
     std::vector<std::string> aggr_cols{"UserID"};
     std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::CountDistinct};
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{1};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 2);
@@ -420,11 +400,11 @@ TEST(ClickBenchQueriesTest, Query12) {
     std::vector<std::string> group_by_fields{"MobilePhone", "MobilePhoneModel"};
     std::vector<std::string> aggr_cols{"UserID"};
     std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::CountDistinct};
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{2};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 3);
@@ -453,11 +433,11 @@ TEST(ClickBenchQueriesTest, Query13) {
     std::vector<std::string> group_by_fields{"SearchPhrase"};
     std::vector<std::string> aggr_cols{"SearchPhrase"};
     std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::COUNT};
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{1};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 2);
@@ -482,11 +462,11 @@ TEST(ClickBenchQueriesTest, Query14) {
     std::vector<std::string> group_by_fields{"SearchPhrase"};
     std::vector<std::string> aggr_cols{"UserID"};
     std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::CountDistinct};
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{1};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 2);
@@ -511,11 +491,11 @@ TEST(ClickBenchQueriesTest, Query15) {
     std::vector<std::string> group_by_fields{"SearchEngineID", "SearchPhrase"};
     std::vector<std::string> aggr_cols{"SearchPhrase"};
     std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::COUNT};
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{2};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 3);
@@ -540,11 +520,11 @@ TEST(ClickBenchQueriesTest, Query16) {
     std::vector<std::string> group_by_fields{"UserID"};
     std::vector<std::string> aggr_cols{"UserID"};
     std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::COUNT};
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{1};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 2);
@@ -557,6 +537,38 @@ TEST(ClickBenchQueriesTest, Query16) {
     }
 }
 
+TEST(ClickBenchQueriesTest, Query16Parallel) {
+    const char* input_db_file = "db_file_benchmark_test.egg";
+    Scheme scheme = GetDbScheme(input_db_file);
+    std::vector<std::string> columns{"UserID"};
+    std::vector<std::string> group_by_fields{"UserID"};
+    std::vector<std::string> aggr_cols{"UserID"};
+    std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::COUNT};
+    std::vector<int> order_by_ids{1};
+    bool is_desc = true;
+    int limit = 10;
+    std::vector<std::unique_ptr<QueryArena>> arenas;
+    ParallelOperator parallel_operator([&](std::shared_ptr<MorselQueue> morsels) -> std::unique_ptr<IOperator> {
+        auto scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+        scan_operator->SetMorselQueue(std::move(morsels));
+        auto group_by_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+            std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
+        arenas.push_back(std::make_unique<QueryArena>(true));
+        group_by_operator->SetMemoryResource(arenas.back().get());
+        return group_by_operator;
+    });
+    std::optional<Batch> batch = parallel_operator.Next();
+    ASSERT_TRUE(batch.has_value());
+    EXPECT_EQ(batch.value().size(), 2);
+    std::vector<std::string> user_ids = batch.value()[0]->GetColumnAsString();
+    std::vector<std::string> counts = batch.value()[1]->GetColumnAsString();
+    EXPECT_EQ(user_ids.size(), 10);
+    EXPECT_EQ(counts.size(), 10);
+    for (size_t i = 0; i < user_ids.size(); ++i) {
+        std::cout << user_ids[i] << "," << counts[i] << std::endl;
+    }
+}
+
 TEST(ClickBenchQueriesTest, Query17) {
     const char* input_db_file = "db_file_benchmark_test.egg";
     Scheme scheme = GetDbScheme(input_db_file);
@@ -565,11 +577,11 @@ TEST(ClickBenchQueriesTest, Query17) {
     std::vector<std::string> group_by_fields{"UserID", "SearchPhrase"};
     std::vector<std::string> aggr_cols{"SearchPhrase"};
     std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::COUNT};
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{2};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 3);
@@ -621,29 +633,26 @@ TEST(ClickBenchQueriesTest, Query19) {
     std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::COUNT};
 
     std::vector<AggregationTransform> group_by_transforms(3);
-    group_by_transforms[1].fn = [](const CellTypes& value) -> CellTypes {
-        const std::string& event_time = std::get<std::string>(value);
-        if (event_time.size() < 16) {
-            return static_cast<int64_t>(0);
-        }
-        return static_cast<int64_t>(std::stoll(event_time.substr(14, 2)));
-    };
-    group_by_transforms[1].output_type = static_cast<int64_t>(Types::TypeInt64);
+    group_by_transforms[1].expression = std::make_shared<ExtractExpression>(
+        DatePart::Minute,
+        std::make_shared<ColumnRefExpression>("EventTime", scheme)
+    );
 
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(
+    std::vector<int> order_by_ids{3};
+    bool is_desc = true;
+    int limit = 10;
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
         std::move(scan_operator),
         group_by_fields,
         aggr_cols,
         aggr_op,
         scheme,
+        limit,
+        is_desc,
+        order_by_ids,
         std::vector<AggregationTransform>{},
         group_by_transforms
     );
-    std::vector<int> order_by_ids{3};
-    bool is_desc = true;
-    int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator =
-        std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 4);
@@ -689,7 +698,7 @@ TEST(ClickBenchQueriesTest, Query21) {
     Scheme scheme = GetDbScheme(input_db_file);
     std::vector<std::string> columns{"URL"};
     std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
-    std::unique_ptr<FilterCondition> condition = std::make_unique<LikeFilter>("URL", "google", scheme);
+    std::unique_ptr<FilterCondition> condition = std::make_unique<LikeFilter>("URL", "%google%", scheme);
     std::unique_ptr<IOperator> filter_operator = std::make_unique<FilterOperator>(std::move(scan_operator), std::move(condition));
     std::vector<std::string> aggr_cols{"URL"};
     std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::COUNT};
@@ -706,7 +715,7 @@ TEST(ClickBenchQueriesTest, Query22) {
     std::vector<std::string> columns{"SearchPhrase", "URL"};
     std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
     std::unique_ptr<FilterCondition> condition = std::make_unique<AndFilter>(
-        std::make_unique<LikeFilter>("URL", "google", scheme),
+        std::make_unique<LikeFilter>("URL", "%google%", scheme),
         std::make_unique<CompareFilter<std::string>>("SearchPhrase", CompareFilter<std::string>::Op::NE, std::string(""), scheme)
     );
     std::unique_ptr<IOperator> filter_operator = std::make_unique<FilterOperator>(std::move(scan_operator), std::move(condition));
@@ -716,11 +725,11 @@ TEST(ClickBenchQueriesTest, Query22) {
         GlobalAggregationOperator::Op::MIN,
         GlobalAggregationOperator::Op::COUNT
     };
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{2};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 3);
@@ -743,9 +752,9 @@ TEST(ClickBenchQueriesTest, Query23) {
     std::vector<std::string> columns{"SearchPhrase", "URL", "Title", "UserID"};
     std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
     std::unique_ptr<FilterCondition> condition = std::make_unique<AndFilter>(
-        std::make_unique<LikeFilter>("Title", "Google", scheme),
+        std::make_unique<LikeFilter>("Title", "%Google%", scheme),
         std::make_unique<AndFilter>(
-            std::make_unique<NotFilter>(std::make_unique<LikeFilter>("URL", ".google.", scheme)),
+            std::make_unique<NotFilter>(std::make_unique<LikeFilter>("URL", "%.google.%", scheme)),
             std::make_unique<CompareFilter<std::string>>("SearchPhrase", CompareFilter<std::string>::Op::NE, std::string(""), scheme)
         )
     );
@@ -758,11 +767,11 @@ TEST(ClickBenchQueriesTest, Query23) {
         GlobalAggregationOperator::Op::COUNT,
         GlobalAggregationOperator::Op::CountDistinct
     };
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{3};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 5);
@@ -789,13 +798,16 @@ TEST(ClickBenchQueriesTest, Query24) {
     const char* input_db_file = "db_file_benchmark_test.egg";
     Scheme scheme = GetDbScheme(input_db_file);
     std::vector<std::string> columns = scheme.GetNamesOrdered();
-    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
-    std::unique_ptr<FilterCondition> condition = std::make_unique<LikeFilter>("URL", "google", scheme);
+    std::vector<std::string> narrow_columns{"URL", "EventTime"};
+    auto scan_operator = std::make_unique<ScanOperator>(input_db_file, narrow_columns);
+    scan_operator->EnableRowIds();
+    std::unique_ptr<FilterCondition> condition = std::make_unique<LikeFilter>("URL", "%google%", scheme);
     std::unique_ptr<IOperator> filter_operator = std::make_unique<FilterOperator>(std::move(scan_operator), std::move(condition));
-    std::vector<int> order_by_ids{scheme.GetColumnIndex("EventTime")};
+    std::vector<int> order_by_ids{1};
     bool is_desc = false;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(filter_operator), limit, is_desc, order_by_ids, scheme);
+    auto order_by_limit_operator = std::make_unique<LateMaterializedTopKOperator>(std::move(filter_operator), limit, is_desc, order_by_ids, input_db_file, columns, scheme);
+    order_by_limit_operator->EnableStatsOrderedScan();
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), columns.size());
@@ -824,7 +836,8 @@ TEST(ClickBenchQueriesTest, Query25) {
     std::vector<int> order_by_ids{1};
     bool is_desc = false;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(filter_operator), limit, is_desc, order_by_ids, scheme);
+    auto order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(filter_operator), limit, is_desc, order_by_ids, scheme);
+    order_by_limit_operator->EnableStatsOrderedScan();
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 2);
@@ -847,7 +860,8 @@ TEST(ClickBenchQueriesTest, Query26) {
     std::vector<int> order_by_ids{0};
     bool is_desc = false;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(filter_operator), limit, is_desc, order_by_ids, scheme);
+    auto order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(filter_operator), limit, is_desc, order_by_ids, scheme);
+    order_by_limit_operator->EnableStatsOrderedScan();
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 1);
@@ -870,7 +884,8 @@ TEST(ClickBenchQueriesTest, Query27) {
     std::vector<int> order_by_ids{1, 0};
     bool is_desc = false;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(filter_operator), limit, is_desc, order_by_ids, scheme);
+    auto order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(filter_operator), limit, is_desc, order_by_ids, scheme);
+    order_by_limit_operator->EnableStatsOrderedScan();
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 2);
@@ -889,29 +904,28 @@ TEST(ClickBenchQueriesTest, Query28) {
     std::unique_ptr<FilterCondition> where_condition =
         std::make_unique<CompareFilter<std::string>>("URL", CompareFilter<std::string>::Op::NE, std::string(""), scheme);
     std::unique_ptr<IOperator> where_operator = std::make_unique<FilterOperator>(std::move(scan_operator), std::move(where_condition));
+    auto projection_operator = std::make_unique<ProjectionOperator>(
+        std::move(where_operator),
+        std::vector<ExpressionPtr>{
+            std::make_shared<ColumnRefExpression>("CounterID", scheme),
+            std::make_shared<StringLengthExpression>(std::make_shared<ColumnRefExpression>("URL", scheme))
+        },
+        std::vector<std::string>{"CounterID", "UrlLength"}
+    );
+    Scheme projection_scheme = projection_operator->GetScheme();
 
     std::vector<std::string> group_by_fields{"CounterID"};
-    std::vector<std::string> aggr_cols{"URL", "URL"};
+    std::vector<std::string> aggr_cols{"UrlLength", "UrlLength"};
     std::vector<GlobalAggregationOperator::Op> aggr_op{
         GlobalAggregationOperator::Op::AVG,
         GlobalAggregationOperator::Op::COUNT
     };
-    AggregationTransform url_length_transform;
-    url_length_transform.fn = [](const CellTypes& value) -> CellTypes {
-        return static_cast<int64_t>(std::get<std::string>(value).size());
-    };
-    url_length_transform.output_type = static_cast<int64_t>(Types::TypeInt64);
-    std::vector<AggregationTransform> transforms{
-        url_length_transform,
-        {}
-    };
     std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(
-        std::move(where_operator),
+        std::move(projection_operator),
         group_by_fields,
         aggr_cols,
         aggr_op,
-        scheme,
-        transforms
+        projection_scheme
     );
 
     std::unique_ptr<FilterCondition> having_condition =
@@ -948,35 +962,33 @@ TEST(ClickBenchQueriesTest, Query29) {
     std::unique_ptr<FilterCondition> where_condition =
         std::make_unique<CompareFilter<std::string>>("Referer", CompareFilter<std::string>::Op::NE, std::string(""), scheme);
     std::unique_ptr<IOperator> where_operator = std::make_unique<FilterOperator>(std::move(scan_operator), std::move(where_condition));
+    auto projection_operator = std::make_unique<ProjectionOperator>(
+        std::move(where_operator),
+        std::vector<ExpressionPtr>{
+            std::make_shared<RegexpReplaceExpression>(
+                std::make_shared<ColumnRefExpression>("Referer", scheme), "^https?://(?:www\\.)?([^/]+)/.*$", "\\1"
+            ),
+            std::make_shared<StringLengthExpression>(std::make_shared<ColumnRefExpression>("Referer", scheme)),
+            std::make_shared<ColumnRefExpression>("Referer", scheme)
+        },
+        std::vector<std::string>{"Host", "RefererLength", "Referer"}
+    );
+    Scheme projection_scheme = projection_operator->GetScheme();
 
-    std::vector<std::string> group_by_fields{"Referer"};
-    std::vector<std::string> aggr_cols{"Referer", "Referer", "Referer"};
+    std::vector<std::string> group_by_fields{"Host"};
+    std::vector<std::string> aggr_cols{"RefererLength", "Referer", "Referer"};
     std::vector<GlobalAggregationOperator::Op> aggr_op{
         GlobalAggregationOperator::Op::AVG,
         GlobalAggregationOperator::Op::COUNT,
         GlobalAggregationOperator::Op::MIN
     };
 
-    AggregationTransform referer_length_transform;
-    referer_length_transform.fn = [](const CellTypes& value) -> CellTypes {
-        return static_cast<int64_t>(std::get<std::string>(value).size());
-    };
-    referer_length_transform.output_type = static_cast<int64_t>(Types::TypeInt64);
-
-    AggregationTransform referer_host_transform;
-    referer_host_transform.fn = [](const CellTypes& value) -> CellTypes {
-        return ExtractRefererHost(std::get<std::string>(value));
-    };
-    referer_host_transform.output_type = static_cast<int64_t>(Types::TypeString);
-
     std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(
-        std::move(where_operator),
+        std::move(projection_operator),
         group_by_fields,
         aggr_cols,
         aggr_op,
-        scheme,
-        std::vector<AggregationTransform>{referer_length_transform, {}, {}},
-        std::vector<AggregationTransform>{referer_host_transform}
+        projection_scheme
     );
 
     std::unique_ptr<FilterCondition> having_condition =
@@ -1018,12 +1030,14 @@ TEST(ClickBenchQueriesTest, Query30) {
     std::vector<AggregationTransform> transforms;
     transforms.reserve(kNumAggregations);
 
+    ExpressionPtr resolution_width = std::make_shared<ColumnRefExpression>("ResolutionWidth", scheme);
     for (int offset = 0; offset < kNumAggregations; ++offset) {
         AggregationTransform transform;
-        transform.fn = [offset](const CellTypes& value) -> CellTypes {
-            return std::get<int64_t>(value) + static_cast<int64_t>(offset);
-        };
-        transform.output_type = static_cast<int64_t>(Types::TypeInt64);
+        transform.expression = std::make_shared<ArithmeticExpression>(
+            ArithmeticOp::Add,
+            resolution_width,
+            std::make_shared<LiteralExpression>(static_cast<int64_t>(offset))
+        );
         transforms.push_back(std::move(transform));
     }
 
@@ -1062,11 +1076,11 @@ TEST(ClickBenchQueriesTest, Query31) {
         GlobalAggregationOperator::Op::SUM,
         GlobalAggregationOperator::Op::AVG
     };
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{2};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 5);
@@ -1105,11 +1119,11 @@ TEST(ClickBenchQueriesTest, Query32) {
         GlobalAggregationOperator::Op::SUM,
         GlobalAggregationOperator::Op::AVG
     };
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{2};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 5);
@@ -1144,11 +1158,11 @@ TEST(ClickBenchQueriesTest, Query33) {
         GlobalAggregationOperator::Op::SUM,
         GlobalAggregationOperator::Op::AVG
     };
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{2};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 5);
@@ -1179,11 +1193,11 @@ TEST(ClickBenchQueriesTest, Query34) {
     std::vector<std::string> group_by_fields{"URL"};
     std::vector<std::string> aggr_cols{"URL"};
     std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::COUNT};
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{1};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 2);
@@ -1204,11 +1218,11 @@ TEST(ClickBenchQueriesTest, Query35) {
     std::vector<std::string> group_by_fields{"URL"};
     std::vector<std::string> aggr_cols{"URL"};
     std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::COUNT};
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{1};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 2);
@@ -1229,13 +1243,11 @@ TEST(ClickBenchQueriesTest, Query36) {
     std::vector<std::string> group_by_fields{"ClientIP"};
     std::vector<std::string> aggr_cols{"ClientIP"};
     std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::COUNT};
-    std::unique_ptr<IOperator> group_by_operator =
-        std::make_unique<GroupByAggregationOperator>(std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{1};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator =
-        std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 2);
@@ -1278,11 +1290,11 @@ TEST(ClickBenchQueriesTest, Query37) {
     std::vector<std::string> group_by_fields{"URL"};
     std::vector<std::string> aggr_cols{"URL"};
     std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::COUNT};
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{1};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 2);
@@ -1320,11 +1332,11 @@ TEST(ClickBenchQueriesTest, Query38) {
     std::vector<std::string> group_by_fields{"Title"};
     std::vector<std::string> aggr_cols{"Title"};
     std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::COUNT};
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme);
     std::vector<int> order_by_ids{1};
     bool is_desc = true;
     int limit = 10;
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(group_by_operator), limit, is_desc, order_by_ids, scheme);
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, scheme, limit, is_desc, order_by_ids);
     std::optional<Batch> batch = order_by_limit_operator->Next();
     ASSERT_TRUE(batch.has_value());
     EXPECT_EQ(batch.value().size(), 2);
@@ -1389,9 +1401,8 @@ TEST(ClickBenchQueriesTest, Query41) {
     std::vector<std::string> columns{"CounterID", "EventDate", "IsRefresh", "TraficSourceID", "RefererHash", "URLHash"};
     std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
     int64_t referer_hash = 3594120000172545465;
-    std::unique_ptr<FilterCondition> trafic_source_condition = std::make_unique<OrFilter>(
-        std::make_unique<CompareFilter<int64_t>>("TraficSourceID", CompareFilter<int64_t>::Op::EQ, static_cast<int64_t>(-1), scheme),
-        std::make_unique<CompareFilter<int64_t>>("TraficSourceID", CompareFilter<int64_t>::Op::EQ, static_cast<int64_t>(6), scheme)
+    std::unique_ptr<FilterCondition> trafic_source_condition = std::make_unique<InFilter>(
+        "TraficSourceID", std::vector<CellTypes>{static_cast<int64_t>(-1), static_cast<int64_t>(6)}, scheme
     );
     std::unique_ptr<FilterCondition> condition = std::make_unique<AndFilter>(
         std::make_unique<CompareFilter<int64_t>>("CounterID", CompareFilter<int64_t>::Op::EQ, static_cast<int64_t>(62), scheme),
@@ -1504,10 +1515,10 @@ TEST(ClickBenchQueriesTest, Query43) {
     std::unique_ptr<IOperator> filter_operator = std::make_unique<FilterOperator>(std::move(scan_operator), std::move(condition));
 
     AggregationTransform minute_trunc_transform;
-    minute_trunc_transform.fn = [](const CellTypes& value) -> CellTypes {
-        return TruncateToMinute(std::get<std::string>(value));
-    };
-    minute_trunc_transform.output_type = static_cast<int64_t>(Types::TypeString);
+    minute_trunc_transform.expression = std::make_shared<DateTruncExpression>(
+        DatePart::Minute,
+        std::make_shared<ColumnRefExpression>("EventTime", scheme)
+    );
 
     std::vector<std::string> group_by_fields{"EventTime"};
     std::vector<std::string> aggr_cols{"EventTime"};
@@ -0,0 +1,79 @@
+#include "bloom_filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+constexpr uint32_t kSalts[8] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+};
+
+} // namespace
+
+BloomFilter::BloomFilter(uint64_t expected_count, double false_positive_rate) {
+    if (false_positive_rate <= 0.0 || false_positive_rate >= 1.0) {
+        throw std::runtime_error("Bloom filter false positive rate must be between 0 and 1.");
+    }
+    double bits_per_value = -8.0 / std::log(1.0 - std::pow(false_positive_rate, 1.0 / kWordsPerBlock));
+    double bits = std::max<double>(1.0, static_cast<double>(expected_count)) * bits_per_value;
+    size_t block_count = static_cast<size_t>(std::ceil(bits / (sizeof(Block) * 8)));
+    blocks_.resize(std::clamp<size_t>(block_count, 1, kMaxBlockCount), Block{});
+}
+
+void BloomFilter::Insert(uint64_t hash) {
+    Block& block = blocks_[GetBlockIndex(hash)];
+    Block mask = MakeMask(hash);
+    for (size_t i = 0; i < kWordsPerBlock; ++i) {
+        block[i] |= mask[i];
+    }
+}
+
+void BloomFilter::InsertHashes(const std::vector<uint64_t>& hashes) {
+    for (uint64_t hash : hashes) {
+        Insert(hash);
+    }
+}
+
+bool BloomFilter::MightContain(uint64_t hash) const {
+    const Block& block = blocks_[GetBlockIndex(hash)];
+    Block mask = MakeMask(hash);
+    for (size_t i = 0; i < kWordsPerBlock; ++i) {
+        if ((block[i] & mask[i]) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<uint8_t> BloomFilter::Serialize() const {
+    std::vector<uint8_t> result(GetByteSize());
+    std::memcpy(result.data(), blocks_.data(), result.size());
+    return result;
+}
+
+BloomFilter BloomFilter::Deserialize(const uint8_t* data, size_t size) {
+    if (size == 0 || size % sizeof(Block) != 0) {
+        throw std::runtime_error("Corrupted Bloom filter.");
+    }
+    BloomFilter result;
+    result.blocks_.resize(size / sizeof(Block));
+    std::memcpy(result.blocks_.data(), data, size);
+    return result;
+}
+
+size_t BloomFilter::GetBlockIndex(uint64_t hash) const {
+    return static_cast<size_t>(((hash >> 32) * blocks_.size()) >> 32);
+}
+
+BloomFilter::Block BloomFilter::MakeMask(uint64_t hash) {
+    uint32_t key = static_cast<uint32_t>(hash);
+    Block mask;
+    for (size_t i = 0; i < kWordsPerBlock; ++i) {
+        mask[i] = uint32_t{1} << ((key * kSalts[i]) >> 27);
+    }
+    return mask;
+}
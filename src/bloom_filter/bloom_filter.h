@@ -0,0 +1,31 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class BloomFilter {
+public:
+    static constexpr double kDefaultFalsePositiveRate = 0.01;
+
+    explicit BloomFilter(uint64_t expected_count, double false_positive_rate = kDefaultFalsePositiveRate);
+    void Insert(uint64_t hash);
+    void InsertHashes(const std::vector<uint64_t>& hashes);
+    bool MightContain(uint64_t hash) const;
+    size_t GetByteSize() const { return blocks_.size() * sizeof(Block); }
+    std::vector<uint8_t> Serialize() const;
+    static BloomFilter Deserialize(const uint8_t* data, size_t size);
+
+protected:
+    static constexpr size_t kWordsPerBlock = 8;
+    static constexpr size_t kMaxBlockCount = size_t{1} << 22;
+
+    using Block = std::array<uint32_t, kWordsPerBlock>;
+
+    BloomFilter() = default;
+    size_t GetBlockIndex(uint64_t hash) const;
+    static Block MakeMask(uint64_t hash);
+
+    std::vector<Block> blocks_;
+};
@@ -7,6 +7,7 @@
 #include <string_view>
 #include <cstring>
 #include <limits>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -114,8 +115,41 @@ std::vector<uint8_t> EncodeMinBitPacked(const std::vector<T>& values) {
     return output;
 }
 
+template <typename Fn>
+void BitUnpackRange(const uint8_t* base, size_t begin, size_t end, uint8_t bit_width, Fn&& fn) {
+    if (bit_width == 0) {
+        for (size_t i = begin; i < end; ++i) {
+            fn(i, 0);
+        }
+        return;
+    }
+    uint64_t bit_offset = static_cast<uint64_t>(begin) * bit_width;
+    const uint8_t* ptr = base + bit_offset / 8;
+    uint8_t skipped_bits = bit_offset % 8;
+    uint64_t buffer = 0;
+    uint8_t bits_in_buffer = 0;
+    if (skipped_bits > 0) {
+        buffer = *ptr++ >> skipped_bits;
+        bits_in_buffer = 8 - skipped_bits;
+    }
+    const uint64_t mask = (uint64_t{1} << bit_width) - 1;
+    for (size_t i = begin; i < end; ++i) {
+        while (bits_in_buffer < bit_width) {
+            buffer |= static_cast<uint64_t>(*ptr++) << bits_in_buffer;
+            bits_in_buffer += 8;
+        }
+        fn(i, buffer & mask);
+        buffer >>= bit_width;
+        bits_in_buffer -= bit_width;
+    }
+}
+
+void RunSequential(size_t count, const std::function<void(size_t, size_t)>& fn) {
+    fn(0, count);
+}
+
 template <typename T>
-void DecodeMinBitPacked(const std::vector<uint8_t>& data, std::vector<T>& values) {
+void DecodeMinBitPacked(const std::vector<uint8_t>& data, std::vector<T>& values, const RangeExecutor& executor = RunSequential) {
     const uint8_t* ptr = data.data();
     uint32_t count = ReadBytes<uint32_t>(ptr);
     values.resize(count);
@@ -124,10 +158,18 @@ void DecodeMinBitPacked(const std::vector<uint8_t>& data, std::vector<T>& values
     }
     int64_t min_value = ReadBytes<int64_t>(ptr);
     uint8_t bit_width = *ptr++;
-    std::vector<uint64_t> offsets = BitUnpack(ptr, count, bit_width);
-    for (uint32_t i = 0; i < count; ++i) {
-        values[i] = static_cast<T>(min_value + static_cast<int64_t>(offsets[i]));
+    if (bit_width > 56) {
+        std::vector<uint64_t> offsets = BitUnpack(ptr, count, bit_width);
+        for (uint32_t i = 0; i < count; ++i) {
+            values[i] = static_cast<T>(min_value + static_cast<int64_t>(offsets[i]));
+        }
+        return;
     }
+    executor(count, [&](size_t begin, size_t end) {
+        BitUnpackRange(ptr, begin, end, bit_width, [&](size_t i, uint64_t offset) {
+            values[i] = static_cast<T>(min_value + static_cast<int64_t>(offset));
+        });
+    });
 }
 
 template <typename T>
@@ -214,9 +256,15 @@ std::vector<uint8_t> EncodeStringDictionary(const std::vector<std::string>& valu
     return output;
 }
 
-void DecodeStringDictionary(const uint8_t*& ptr, uint32_t count, std::vector<std::string>& values) {
+void DecodeStringDictionary(
+    const uint8_t*& ptr,
+    uint32_t count,
+    std::vector<std::string>& values,
+    std::vector<std::string>& dictionary,
+    std::vector<uint32_t>& dictionary_ids
+) {
     uint32_t dictionary_size = ReadBytes<uint32_t>(ptr);
-    std::vector<std::string> dictionary;
+    dictionary.clear();
     dictionary.reserve(dictionary_size);
     for (uint32_t i = 0; i < dictionary_size; ++i) {
         uint32_t length = ReadBytes<uint32_t>(ptr);
@@ -225,8 +273,10 @@ void DecodeStringDictionary(const uint8_t*& ptr, uint32_t count, std::vector<std
     }
     uint8_t bit_width = *ptr++;
     std::vector<uint64_t> ids = BitUnpack(ptr, count, bit_width);
+    dictionary_ids.resize(count);
     for (uint32_t i = 0; i < count; ++i) {
         values[i] = dictionary[ids[i]];
+        dictionary_ids[i] = static_cast<uint32_t>(ids[i]);
     }
 }
 
@@ -279,17 +329,15 @@ void DecodeStringDeltaLengthByteArray(const uint8_t*& ptr, uint32_t count, std::
         return;
     }
     uint32_t first_length = ReadBytes<uint32_t>(ptr);
-    values[0] = std::string(reinterpret_cast<const char*>(ptr), first_length);
+    values[0].assign(reinterpret_cast<const char*>(ptr), first_length);
     ptr += first_length;
     for (uint32_t i = 1; i < count; ++i) {
         uint32_t prefix_len = ReadBytes<uint32_t>(ptr);
         uint32_t suffix_len = ReadBytes<uint32_t>(ptr);
-        std::string current;
-        current.reserve(prefix_len + suffix_len);
-        current.append(values[i - 1].data(), prefix_len);
+        std::string& current = values[i];
+        current.assign(values[i - 1], 0, prefix_len);
         current.append(reinterpret_cast<const char*>(ptr), suffix_len);
         ptr += suffix_len;
-        values[i] = std::move(current);
     }
 }
 
@@ -312,16 +360,23 @@ std::vector<uint8_t> EncodeStringColumn(const std::vector<std::string>& values)
     return output;
 }
 
-void DecodeStringColumn(const std::vector<uint8_t>& data, std::vector<std::string>& values) {
+void DecodeStringColumn(
+    const std::vector<uint8_t>& data,
+    std::vector<std::string>& values,
+    std::vector<std::string>& dictionary,
+    std::vector<uint32_t>& dictionary_ids
+) {
     const uint8_t* ptr = data.data();
     uint32_t count = ReadBytes<uint32_t>(ptr);
     values.resize(count);
+    dictionary.clear();
+    dictionary_ids.clear();
     if (count == 0) {
         return;
     }
     StringEncoding encoding = static_cast<StringEncoding>(*ptr++);
     if (encoding == StringEncoding::Dictionary) {
-        DecodeStringDictionary(ptr, count, values);
+        DecodeStringDictionary(ptr, count, values, dictionary, dictionary_ids);
     } else {
         DecodeStringDeltaLengthByteArray(ptr, count, values);
     }
@@ -351,7 +406,59 @@ std::string CellToString(const CellTypes& value) {
     }, value);
 }
 
-}  // namespace
+template <typename T>
+void AppendValueRange(std::vector<T>& values, const std::vector<T>& other, int64_t begin, int64_t end) {
+    values.insert(values.end(), other.begin() + begin, other.begin() + end);
+}
+
+void AppendSortKeyBytes(std::string& key, uint64_t value, size_t width, bool is_desc) {
+    for (size_t i = width; i-- > 0;) {
+        uint8_t byte = static_cast<uint8_t>(value >> (i * 8));
+        key.push_back(static_cast<char>(is_desc ? ~byte : byte));
+    }
+}
+
+template <typename T>
+void AppendIntegerSortKeys(const std::vector<T>& values, std::vector<std::string>& keys, bool is_desc) {
+    constexpr uint64_t sign_bit = 1ULL << (sizeof(T) * 8 - 1);
+    for (size_t i = 0; i < values.size(); ++i) {
+        uint64_t encoded = static_cast<std::make_unsigned_t<T>>(values[i]);
+        if constexpr (std::is_signed_v<T>) {
+            encoded ^= sign_bit;
+        }
+        AppendSortKeyBytes(keys[i], encoded, sizeof(T), is_desc);
+    }
+}
+
+void AppendStringSortKey(std::string& key, const std::string& value, bool is_desc) {
+    const uint8_t flip = is_desc ? 0xFF : 0x00;
+    for (unsigned char c : value) {
+        key.push_back(static_cast<char>(c ^ flip));
+        if (c == 0) {
+            key.push_back(static_cast<char>(0xFF ^ flip));
+        }
+    }
+    key.push_back(static_cast<char>(flip));
+    key.push_back(static_cast<char>(flip));
+}
+
+template <typename T, typename HashFn>
+void ComputeValueHashes(const std::vector<T>& values, std::vector<uint64_t>& hashes, HashFn hash) {
+    hashes.resize(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        hashes[i] = hash(values[i]);
+    }
+}
+
+template <typename T, typename HashFn>
+void ComputeValueHashes(const std::vector<T>& values, const std::vector<uint64_t>& mask, std::vector<uint64_t>& hashes, HashFn hash) {
+    hashes.resize(mask.size());
+    for (size_t i = 0; i < mask.size(); ++i) {
+        hashes[i] = hash(values[mask[i]]);
+    }
+}
+
+} // namespace
 
 std::vector<uint8_t> Int16::Encode() const {
     return EncodeMinBitPacked(value_);
@@ -445,16 +552,12 @@ void Int16::MergeHashes(
     }
 }
 
-void Int16::FillHashSet(std::unordered_set<int64_t>& set) const {
-    for (int16_t value : value_) {
-        set.insert(static_cast<int64_t>(value));
-    }
+void Int16::FillHashSet(Int64DistinctSet& set) const {
+    set.InsertBatch(value_.data(), value_.size());
 }
 
-void Int16::FillHashSet(std::unordered_set<int64_t>& set, const std::vector<uint64_t>& mask) const {
-    for (uint64_t id : mask) {
-        set.insert(static_cast<int64_t>(value_[id]));
-    }
+void Int16::FillHashSet(Int64DistinctSet& set, const std::vector<uint64_t>& mask) const {
+    set.InsertMasked(value_.data(), mask);
 }
 
 void Int16::FilterRows(const std::vector<int64_t>& mask) {
@@ -466,10 +569,34 @@ void Int16::FilterRows(const std::vector<int64_t>& mask) {
     value_ = std::move(new_values);
 }
 
+std::unique_ptr<Column> Int16::CreateEmpty() const {
+    return std::make_unique<Int16>();
+}
+
+void Int16::AppendRange(const Column& other, int64_t begin, int64_t end) {
+    AppendValueRange(value_, static_cast<const Int16&>(other).value_, begin, end);
+}
+
+void Int16::AppendSortKeys(std::vector<std::string>& keys, bool is_desc) const {
+    AppendIntegerSortKeys(value_, keys, is_desc);
+}
+
+void Int16::ComputeHashes(std::vector<uint64_t>& hashes) const {
+    ComputeValueHashes(value_, hashes, [](auto value) { return HashInt64(static_cast<int64_t>(value)); });
+}
+
+void Int16::ComputeHashes(const std::vector<uint64_t>& mask, std::vector<uint64_t>& hashes) const {
+    ComputeValueHashes(value_, mask, hashes, [](auto value) { return HashInt64(static_cast<int64_t>(value)); });
+}
+
 void Int16::SetData(const std::vector<uint8_t>& data) {
     Decode(data);
 }
 
+void Int16::SetData(const std::vector<uint8_t>& data, const RangeExecutor& executor) {
+    DecodeMinBitPacked(data, value_, executor);
+}
+
 std::vector<uint8_t> Int32::Encode() const {
     return EncodeMinBitPacked(value_);
 }
@@ -562,16 +689,12 @@ void Int32::MergeHashes(
     }
 }
 
-void Int32::FillHashSet(std::unordered_set<int64_t>& set) const {
-    for (int32_t value : value_) {
-        set.insert(static_cast<int64_t>(value));
-    }
+void Int32::FillHashSet(Int64DistinctSet& set) const {
+    set.InsertBatch(value_.data(), value_.size());
 }
 
-void Int32::FillHashSet(std::unordered_set<int64_t>& set, const std::vector<uint64_t>& mask) const {
-    for (uint64_t id : mask) {
-        set.insert(static_cast<int64_t>(value_[id]));
-    }
+void Int32::FillHashSet(Int64DistinctSet& set, const std::vector<uint64_t>& mask) const {
+    set.InsertMasked(value_.data(), mask);
 }
 
 void Int32::FilterRows(const std::vector<int64_t>& mask) {
@@ -583,10 +706,34 @@ void Int32::FilterRows(const std::vector<int64_t>& mask) {
     value_ = std::move(new_values);
 }
 
+std::unique_ptr<Column> Int32::CreateEmpty() const {
+    return std::make_unique<Int32>();
+}
+
+void Int32::AppendRange(const Column& other, int64_t begin, int64_t end) {
+    AppendValueRange(value_, static_cast<const Int32&>(other).value_, begin, end);
+}
+
+void Int32::AppendSortKeys(std::vector<std::string>& keys, bool is_desc) const {
+    AppendIntegerSortKeys(value_, keys, is_desc);
+}
+
+void Int32::ComputeHashes(std::vector<uint64_t>& hashes) const {
+    ComputeValueHashes(value_, hashes, [](auto value) { return HashInt64(static_cast<int64_t>(value)); });
+}
+
+void Int32::ComputeHashes(const std::vector<uint64_t>& mask, std::vector<uint64_t>& hashes) const {
+    ComputeValueHashes(value_, mask, hashes, [](auto value) { return HashInt64(static_cast<int64_t>(value)); });
+}
+
 void Int32::SetData(const std::vector<uint8_t>& data) {
     Decode(data);
 }
 
+void Int32::SetData(const std::vector<uint8_t>& data, const RangeExecutor& executor) {
+    DecodeMinBitPacked(data, value_, executor);
+}
+
 std::vector<uint8_t> Int64::Encode() const {
     return EncodeDeltaBitPacked(value_);
 }
@@ -654,6 +801,26 @@ void Int64::FilterRows(const std::vector<int64_t>& mask) {
     value_ = std::move(new_values);
 }
 
+std::unique_ptr<Column> Int64::CreateEmpty() const {
+    return std::make_unique<Int64>();
+}
+
+void Int64::AppendRange(const Column& other, int64_t begin, int64_t end) {
+    AppendValueRange(value_, static_cast<const Int64&>(other).value_, begin, end);
+}
+
+void Int64::AppendSortKeys(std::vector<std::string>& keys, bool is_desc) const {
+    AppendIntegerSortKeys(value_, keys, is_desc);
+}
+
+void Int64::ComputeHashes(std::vector<uint64_t>& hashes) const {
+    ComputeValueHashes(value_, hashes, [](auto value) { return HashInt64(static_cast<int64_t>(value)); });
+}
+
+void Int64::ComputeHashes(const std::vector<uint64_t>& mask, std::vector<uint64_t>& hashes) const {
+    ComputeValueHashes(value_, mask, hashes, [](auto value) { return HashInt64(static_cast<int64_t>(value)); });
+}
+
 int64_t Int64::GetSum(const std::function<int64_t(int64_t)>& transform) const {
     int64_t ans = 0;
     for (auto el : value_) {
@@ -672,16 +839,12 @@ CellTypes Int64::GetMin() const {
     return *it;
 }
 
-void Int64::FillHashSet(std::unordered_set<int64_t>& set) const {
-    for (const auto& el : value_) {
-        set.insert(el);
-    }
+void Int64::FillHashSet(Int64DistinctSet& set) const {
+    set.InsertBatch(value_.data(), value_.size());
 }
 
-void Int64::FillHashSet(std::unordered_set<int64_t>& set, const std::vector<uint64_t>& mask) const {
-    for (auto id : mask) {
-        set.insert(value_[id]);
-    }
+void Int64::FillHashSet(Int64DistinctSet& set, const std::vector<uint64_t>& mask) const {
+    set.InsertMasked(value_.data(), mask);
 }
 
 void Int64::AddCell(const CellTypes& cell) {
@@ -733,12 +896,29 @@ CellTypes Int64::GetMax(const std::vector<uint64_t>& mask) const {
     return ans;
 }
 
+String::String(std::vector<std::string> values) : value_(std::move(values)) {
+    for (const auto& value : value_) {
+        size_ += sizeof(int64_t) + value.size();
+    }
+}
+
+String::String(std::vector<std::string> dictionary, std::vector<uint32_t> dictionary_ids)
+    : dictionary_(std::make_shared<const std::vector<std::string>>(std::move(dictionary))), dictionary_ids_(std::move(dictionary_ids)) {
+    value_.reserve(dictionary_ids_.size());
+    for (uint32_t id : dictionary_ids_) {
+        value_.push_back((*dictionary_)[id]);
+        size_ += sizeof(int64_t) + value_.back().size();
+    }
+}
+
 std::vector<uint8_t> String::Encode() const {
     return EncodeStringColumn(value_);
 }
 
 void String::Decode(const std::vector<uint8_t>& data) {
-    DecodeStringColumn(data, value_);
+    std::vector<std::string> dictionary;
+    DecodeStringColumn(data, value_, dictionary, dictionary_ids_);
+    dictionary_ = dictionary_ids_.empty() ? nullptr : std::make_shared<const std::vector<std::string>>(std::move(dictionary));
     size_ = 0;
     for (const auto& value : value_) {
         size_ += sizeof(int64_t) + value.size();
@@ -746,12 +926,14 @@ void String::Decode(const std::vector<uint8_t>& data) {
 }
 
 void String::AddCell(const std::string& cell) {
+    ResetDictionary();
     size_ += sizeof(int64_t) + cell.size();
     value_.push_back(std::move(cell));
     
 }
 
 void String::AddColumn(const std::vector<std::string>& col) {
+    ResetDictionary();
     value_.reserve(value_.size() + col.size());
     for (const auto& cell : col) {
         try {
@@ -800,6 +982,57 @@ void String::FilterRows(const std::vector<int64_t>& mask) {
         ++i;
     }
     value_ = std::move(new_values);
+    if (!dictionary_ids_.empty()) {
+        std::vector<uint32_t> new_ids;
+        new_ids.reserve(mask.size());
+        for (int64_t id : mask) {
+            new_ids.push_back(dictionary_ids_[id]);
+        }
+        dictionary_ids_ = std::move(new_ids);
+    }
+}
+
+std::unique_ptr<Column> String::CreateEmpty() const {
+    return std::make_unique<String>();
+}
+
+void String::AppendRange(const Column& other, int64_t begin, int64_t end) {
+    const auto& typed = static_cast<const String&>(other);
+    ResetDictionary();
+    for (int64_t i = begin; i < end; ++i) {
+        size_ += sizeof(int64_t) + typed.value_[i].size();
+    }
+    AppendValueRange(value_, typed.value_, begin, end);
+}
+
+void String::AssignRange(const Column& other, int64_t begin, int64_t end) {
+    const auto& typed = static_cast<const String&>(other);
+    if (!typed.HasDictionary() || typed.dictionary_->size() > static_cast<size_t>(end - begin)) {
+        Column::AssignRange(other, begin, end);
+        return;
+    }
+    dictionary_ = typed.dictionary_;
+    dictionary_ids_.assign(typed.dictionary_ids_.begin() + begin, typed.dictionary_ids_.begin() + end);
+    value_.resize(end - begin);
+    size_ = 0;
+    for (int64_t i = begin; i < end; ++i) {
+        value_[i - begin] = typed.value_[i];
+        size_ += sizeof(int64_t) + typed.value_[i].size();
+    }
+}
+
+void String::AppendSortKeys(std::vector<std::string>& keys, bool is_desc) const {
+    for (size_t i = 0; i < value_.size(); ++i) {
+        AppendStringSortKey(keys[i], value_[i], is_desc);
+    }
+}
+
+void String::ComputeHashes(std::vector<uint64_t>& hashes) const {
+    ComputeValueHashes(value_, hashes, [](const std::string& value) { return HashString(value); });
+}
+
+void String::ComputeHashes(const std::vector<uint64_t>& mask, std::vector<uint64_t>& hashes) const {
+    ComputeValueHashes(value_, mask, hashes, [](const std::string& value) { return HashString(value); });
 }
 
 CellTypes String::GetMax() const {
@@ -812,19 +1045,16 @@ CellTypes String::GetMin() const {
     return *it;
 }
 
-void String::FillHashSet(std::unordered_set<std::string>& set) const {
-    for (const auto& el : value_) {
-        set.insert(el);
-    }
+void String::FillHashSet(StringHashSet& set) const {
+    set.InsertBatch(value_.data(), value_.size());
 }
 
-void String::FillHashSet(std::unordered_set<std::string>& set, const std::vector<uint64_t>& mask) const {
-    for (auto id : mask) {
-        set.insert(value_[id]);
-    }
+void String::FillHashSet(StringHashSet& set, const std::vector<uint64_t>& mask) const {
+    set.InsertMasked(value_.data(), mask);
 }
 
 void String::AddCell(const CellTypes& cell) {
+    ResetDictionary();
     std::string val = std::get<std::string>(cell);
     value_.emplace_back(val);
 }
@@ -1013,6 +1243,32 @@ void Double::FilterRows(const std::vector<int64_t>& mask) {
     value_ = std::move(new_values);
 }
 
+std::unique_ptr<Column> Double::CreateEmpty() const {
+    return std::make_unique<Double>();
+}
+
+void Double::AppendRange(const Column& other, int64_t begin, int64_t end) {
+    AppendValueRange(value_, static_cast<const Double&>(other).value_, begin, end);
+}
+
+void Double::AppendSortKeys(std::vector<std::string>& keys, bool is_desc) const {
+    for (size_t i = 0; i < value_.size(); ++i) {
+        double value = value_[i] == 0.0 ? 0.0 : value_[i];
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        bits = (bits >> 63) ? ~bits : (bits | (1ULL << 63));
+        AppendSortKeyBytes(keys[i], bits, sizeof(bits), is_desc);
+    }
+}
+
+void Double::ComputeHashes(std::vector<uint64_t>& hashes) const {
+    ComputeValueHashes(value_, hashes, [](double value) { return HashDouble(value); });
+}
+
+void Double::ComputeHashes(const std::vector<uint64_t>& mask, std::vector<uint64_t>& hashes) const {
+    ComputeValueHashes(value_, mask, hashes, [](double value) { return HashDouble(value); });
+}
+
 void Double::Clear() {
     value_.clear();
 }
@@ -1021,6 +1277,15 @@ void Double::SetData(const std::vector<uint8_t>& data) {
     Decode(data);
 }
 
+void Double::SetData(const std::vector<uint8_t>& data, const RangeExecutor& executor) {
+    const uint8_t* ptr = data.data();
+    uint32_t count = ReadBytes<uint32_t>(ptr);
+    value_.resize(count);
+    executor(count, [&](size_t begin, size_t end) {
+        std::memcpy(value_.data() + begin, ptr + begin * sizeof(double), (end - begin) * sizeof(double));
+    });
+}
+
 void Double::AddCell(const CellTypes& cell) {
     double val = std::get<double>(cell);
     value_.push_back(val);
@@ -1171,6 +1436,26 @@ void Date::FilterRows(const std::vector<int64_t>& mask) {
     value_ = std::move(new_values);
 }
 
+std::unique_ptr<Column> Date::CreateEmpty() const {
+    return std::make_unique<Date>();
+}
+
+void Date::AppendRange(const Column& other, int64_t begin, int64_t end) {
+    AppendValueRange(value_, static_cast<const Date&>(other).value_, begin, end);
+}
+
+void Date::AppendSortKeys(std::vector<std::string>& keys, bool is_desc) const {
+    AppendIntegerSortKeys(value_, keys, is_desc);
+}
+
+void Date::ComputeHashes(std::vector<uint64_t>& hashes) const {
+    ComputeValueHashes(value_, hashes, [](auto value) { return HashInt64(static_cast<int64_t>(value)); });
+}
+
+void Date::ComputeHashes(const std::vector<uint64_t>& mask, std::vector<uint64_t>& hashes) const {
+    ComputeValueHashes(value_, mask, hashes, [](auto value) { return HashInt64(static_cast<int64_t>(value)); });
+}
+
 void Date::SetData(const std::vector<uint8_t>& data) {
     Decode(data);
 }
@@ -1297,16 +1582,12 @@ void Timestamp::MergeHashes(
     }
 }
 
-void Timestamp::FillHashSet(std::unordered_set<int64_t>& set) const {
-    for (uint32_t value : value_) {
-        set.insert(static_cast<int64_t>(value));
-    }
+void Timestamp::FillHashSet(Int64DistinctSet& set) const {
+    set.InsertBatch(value_.data(), value_.size());
 }
 
-void Timestamp::FillHashSet(std::unordered_set<int64_t>& set, const std::vector<uint64_t>& mask) const {
-    for (uint64_t id : mask) {
-        set.insert(static_cast<int64_t>(value_[id]));
-    }
+void Timestamp::FillHashSet(Int64DistinctSet& set, const std::vector<uint64_t>& mask) const {
+    set.InsertMasked(value_.data(), mask);
 }
 
 void Timestamp::FilterRows(const std::vector<int64_t>& mask) {
@@ -1318,6 +1599,26 @@ void Timestamp::FilterRows(const std::vector<int64_t>& mask) {
     value_ = std::move(new_values);
 }
 
+std::unique_ptr<Column> Timestamp::CreateEmpty() const {
+    return std::make_unique<Timestamp>();
+}
+
+void Timestamp::AppendRange(const Column& other, int64_t begin, int64_t end) {
+    AppendValueRange(value_, static_cast<const Timestamp&>(other).value_, begin, end);
+}
+
+void Timestamp::AppendSortKeys(std::vector<std::string>& keys, bool is_desc) const {
+    AppendIntegerSortKeys(value_, keys, is_desc);
+}
+
+void Timestamp::ComputeHashes(std::vector<uint64_t>& hashes) const {
+    ComputeValueHashes(value_, hashes, [](auto value) { return HashInt64(static_cast<int64_t>(value)); });
+}
+
+void Timestamp::ComputeHashes(const std::vector<uint64_t>& mask, std::vector<uint64_t>& hashes) const {
+    ComputeValueHashes(value_, mask, hashes, [](auto value) { return HashInt64(static_cast<int64_t>(value)); });
+}
+
 void Timestamp::SetData(const std::vector<uint8_t>& data) {
     Decode(data);
 }
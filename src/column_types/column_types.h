@@ -8,7 +8,10 @@
 #include <memory>
 #include <unordered_set>
 
+#include "../hash_set/hash_set.h"
+
 using CellTypes = std::variant<int64_t, std::string, double>;
+using RangeExecutor = std::function<void(size_t count, const std::function<void(size_t begin, size_t end)>& fn)>;
 
 class Column {
 public:
@@ -39,14 +42,30 @@ public:
         const std::function<CellTypes(const CellTypes&)>& transform = {}
     ) const = 0;
     virtual void FilterRows(const std::vector<int64_t>& mask) = 0;
+    virtual std::unique_ptr<Column> CreateEmpty() const = 0;
+    virtual void AppendRange(const Column& other, int64_t begin, int64_t end) = 0;
+    virtual void AssignRange(const Column& other, int64_t begin, int64_t end) {
+        Clear();
+        AppendRange(other, begin, end);
+    }
+    std::unique_ptr<Column> Slice(int64_t begin, int64_t end) const {
+        std::unique_ptr<Column> result = CreateEmpty();
+        result->AssignRange(*this, begin, end);
+        return result;
+    }
+    virtual void AppendSortKeys(std::vector<std::string>& keys, bool is_desc) const = 0;
+    virtual void ComputeHashes(std::vector<uint64_t>& hashes) const = 0;
+    virtual void ComputeHashes(const std::vector<uint64_t>& mask, std::vector<uint64_t>& hashes) const = 0;
     virtual void Clear() = 0;
     virtual void SetData(const std::vector<uint8_t>& data) = 0;
+    virtual void SetData(const std::vector<uint8_t>& data, const RangeExecutor&) { SetData(data); }
     virtual ~Column() = default;
 };
 
 class Int16 : public Column {
 public:
     Int16(int16_t value) { value_.push_back(value); }
+    explicit Int16(std::vector<int16_t> values) : value_(std::move(values)) {}
     Int16() = default;
     std::vector<uint8_t> Encode() const override;
     void Decode(const std::vector<uint8_t>& data) override;
@@ -63,18 +82,25 @@ public:
     CellTypes GetMax() const override;
     CellTypes GetMax(const std::vector<uint64_t>& mask) const override;
     CellTypes Get(int64_t r) const override { return static_cast<int64_t>(value_[r]); }
+    const std::vector<int16_t>& GetValues() const { return value_; }
 
     void MergeHashes(
         std::vector<uint64_t>& hashes,
         std::vector<std::vector<std::string>>& group_name,
         const std::function<CellTypes(const CellTypes&)>& transform = {}
     ) const override;
-    void FillHashSet(std::unordered_set<int64_t>& set) const;
-    void FillHashSet(std::unordered_set<int64_t>& set, const std::vector<uint64_t>& mask) const;
+    void FillHashSet(Int64DistinctSet& set) const;
+    void FillHashSet(Int64DistinctSet& set, const std::vector<uint64_t>& mask) const;
     void FilterRows(const std::vector<int64_t>& mask) override;
+    std::unique_ptr<Column> CreateEmpty() const override;
+    void AppendRange(const Column& other, int64_t begin, int64_t end) override;
+    void AppendSortKeys(std::vector<std::string>& keys, bool is_desc) const override;
+    void ComputeHashes(std::vector<uint64_t>& hashes) const override;
+    void ComputeHashes(const std::vector<uint64_t>& mask, std::vector<uint64_t>& hashes) const override;
     bool Compare(int row, Op op, CellTypes value) const override;
     void Clear() override { value_.clear(); }
     void SetData(const std::vector<uint8_t>& data) override;
+    void SetData(const std::vector<uint8_t>& data, const RangeExecutor& executor) override;
 
 protected:
     std::vector<int16_t> value_;
@@ -83,6 +109,7 @@ protected:
 class Int32 : public Column {
 public:
     Int32(int32_t value) { value_.push_back(value); }
+    explicit Int32(std::vector<int32_t> values) : value_(std::move(values)) {}
     Int32() = default;
     std::vector<uint8_t> Encode() const override;
     void Decode(const std::vector<uint8_t>& data) override;
@@ -99,18 +126,25 @@ public:
     CellTypes GetMax() const override;
     CellTypes GetMax(const std::vector<uint64_t>& mask) const override;
     CellTypes Get(int64_t r) const override { return static_cast<int64_t>(value_[r]); }
+    const std::vector<int32_t>& GetValues() const { return value_; }
 
     void MergeHashes(
         std::vector<uint64_t>& hashes,
         std::vector<std::vector<std::string>>& group_name,
         const std::function<CellTypes(const CellTypes&)>& transform = {}
     ) const override;
-    void FillHashSet(std::unordered_set<int64_t>& set) const;
-    void FillHashSet(std::unordered_set<int64_t>& set, const std::vector<uint64_t>& mask) const;
+    void FillHashSet(Int64DistinctSet& set) const;
+    void FillHashSet(Int64DistinctSet& set, const std::vector<uint64_t>& mask) const;
     void FilterRows(const std::vector<int64_t>& mask) override;
+    std::unique_ptr<Column> CreateEmpty() const override;
+    void AppendRange(const Column& other, int64_t begin, int64_t end) override;
+    void AppendSortKeys(std::vector<std::string>& keys, bool is_desc) const override;
+    void ComputeHashes(std::vector<uint64_t>& hashes) const override;
+    void ComputeHashes(const std::vector<uint64_t>& mask, std::vector<uint64_t>& hashes) const override;
     bool Compare(int row, Op op, CellTypes value) const override;
     void Clear() override { value_.clear(); }
     void SetData(const std::vector<uint8_t>& data) override;
+    void SetData(const std::vector<uint8_t>& data, const RangeExecutor& executor) override;
 
 protected:
     std::vector<int32_t> value_;
@@ -119,6 +153,7 @@ protected:
 class Int64 : public Column {
 public:
     Int64(int64_t value) { value_.push_back(value); }
+    explicit Int64(std::vector<int64_t> values) : value_(std::move(values)) {}
     Int64() = default;
     std::vector<uint8_t> Encode() const override;
     void Decode(const std::vector<uint8_t>& data) override;
@@ -139,15 +174,21 @@ public:
     CellTypes GetMax() const override;
     CellTypes GetMax(const std::vector<uint64_t>& mask) const override;
     CellTypes Get(int64_t r) const override { return value_[r]; }
+    const std::vector<int64_t>& GetValues() const { return value_; }
 
     void MergeHashes(
         std::vector<uint64_t>& hashes,
         std::vector<std::vector<std::string>>& group_name,
         const std::function<CellTypes(const CellTypes&)>& transform = {}
     ) const override;
-    void FillHashSet(std::unordered_set<int64_t>& set) const;
-    void FillHashSet(std::unordered_set<int64_t>& set, const std::vector<uint64_t>& mask) const;
+    void FillHashSet(Int64DistinctSet& set) const;
+    void FillHashSet(Int64DistinctSet& set, const std::vector<uint64_t>& mask) const;
     void FilterRows(const std::vector<int64_t>& mask) override;
+    std::unique_ptr<Column> CreateEmpty() const override;
+    void AppendRange(const Column& other, int64_t begin, int64_t end) override;
+    void AppendSortKeys(std::vector<std::string>& keys, bool is_desc) const override;
+    void ComputeHashes(std::vector<uint64_t>& hashes) const override;
+    void ComputeHashes(const std::vector<uint64_t>& mask, std::vector<uint64_t>& hashes) const override;
     bool Compare(int row, Op op, CellTypes value) const override;
     void Clear() override { value_.clear(); }
     void SetData(const std::vector<uint8_t>& data) override;
@@ -158,6 +199,8 @@ protected:
 class String : public Column {
 public:
     String(const std::string& value) { value_.emplace_back(value); }
+    explicit String(std::vector<std::string> values);
+    String(std::vector<std::string> dictionary, std::vector<uint32_t> dictionary_ids);
     ~String() = default;
     String() = default;
     std::vector<uint8_t> Encode() const override;
@@ -178,31 +221,50 @@ public:
     CellTypes GetMin() const override;
     CellTypes GetMin(const std::vector<uint64_t>& mask) const override;
     CellTypes Get(int64_t r) const override { return value_[r]; }
+    const std::vector<std::string>& GetValues() const { return value_; }
+    bool HasDictionary() const { return !dictionary_ids_.empty(); }
+    const std::vector<std::string>& GetDictionary() const { return *dictionary_; }
+    const std::vector<uint32_t>& GetDictionaryIds() const { return dictionary_ids_; }
 
     void MergeHashes(
         std::vector<uint64_t>& hashes,
         std::vector<std::vector<std::string>>& group_name,
         const std::function<CellTypes(const CellTypes&)>& transform = {}
     ) const override;
-    void FillHashSet(std::unordered_set<std::string>& set) const;
-    void FillHashSet(std::unordered_set<std::string>& set, const std::vector<uint64_t>& mask) const;
+    void FillHashSet(StringHashSet& set) const;
+    void FillHashSet(StringHashSet& set, const std::vector<uint64_t>& mask) const;
     void FilterRows(const std::vector<int64_t>& mask) override;
+    std::unique_ptr<Column> CreateEmpty() const override;
+    void AppendRange(const Column& other, int64_t begin, int64_t end) override;
+    void AssignRange(const Column& other, int64_t begin, int64_t end) override;
+    void AppendSortKeys(std::vector<std::string>& keys, bool is_desc) const override;
+    void ComputeHashes(std::vector<uint64_t>& hashes) const override;
+    void ComputeHashes(const std::vector<uint64_t>& mask, std::vector<uint64_t>& hashes) const override;
     bool Compare(int row, Op op, CellTypes value) const override;
     void Clear() override {
         value_.clear();
         size_ = 0;
+        ResetDictionary();
     }
 
     void SetData(const std::vector<uint8_t>& data) override;
 protected:
+    void ResetDictionary() {
+        dictionary_.reset();
+        dictionary_ids_.clear();
+    }
+
     std::vector<std::string> value_;
     size_t size_ = 0;
+    std::shared_ptr<const std::vector<std::string>> dictionary_;
+    std::vector<uint32_t> dictionary_ids_;
 };
 
 class Double : public Column {
 public:
     Double() = default;
     Double(double value);
+    explicit Double(std::vector<double> values) : value_(std::move(values)) {}
 
     std::vector<uint8_t> Encode() const override;
     void Decode(const std::vector<uint8_t>& data) override;
@@ -222,6 +284,7 @@ public:
     CellTypes GetMax() const override;
     CellTypes GetMax(const std::vector<uint64_t>& mask) const override;
     CellTypes Get(int64_t r) const override { return value_[r]; }
+    const std::vector<double>& GetValues() const { return value_; }
 
     bool Compare(int row, Op op, CellTypes val) const override;
 
@@ -231,8 +294,14 @@ public:
         const std::function<CellTypes(const CellTypes&)>& transform = {}
     ) const override;
     void FilterRows(const std::vector<int64_t>& mask) override;
+    std::unique_ptr<Column> CreateEmpty() const override;
+    void AppendRange(const Column& other, int64_t begin, int64_t end) override;
+    void AppendSortKeys(std::vector<std::string>& keys, bool is_desc) const override;
+    void ComputeHashes(std::vector<uint64_t>& hashes) const override;
+    void ComputeHashes(const std::vector<uint64_t>& mask, std::vector<uint64_t>& hashes) const override;
     void Clear() override;
     void SetData(const std::vector<uint8_t>& data) override;
+    void SetData(const std::vector<uint8_t>& data, const RangeExecutor& executor) override;
 
 protected:
     std::vector<double> value_;
@@ -242,6 +311,7 @@ class Date : public Column {
 public:
     Date() = default;
     explicit Date(uint32_t value) { value_.push_back(value); }
+    explicit Date(std::vector<uint32_t> values) : value_(std::move(values)) {}
 
     std::vector<uint8_t> Encode() const override;
     void Decode(const std::vector<uint8_t>& data) override;
@@ -259,6 +329,7 @@ public:
     CellTypes GetMax() const override;
     CellTypes GetMax(const std::vector<uint64_t>& mask) const override;
     CellTypes Get(int64_t r) const override { return GetCellAsString(r); }
+    const std::vector<uint32_t>& GetValues() const { return value_; }
 
     bool Compare(int row, Op op, CellTypes val) const override;
     void MergeHashes(
@@ -266,9 +337,14 @@ public:
         std::vector<std::vector<std::string>>& group_name,
         const std::function<CellTypes(const CellTypes&)>& transform = {}
     ) const override;
-    void FillHashSet(std::unordered_set<int64_t>& set) const;
-    void FillHashSet(std::unordered_set<int64_t>& set, const std::vector<uint64_t>& mask) const;
+    void FillHashSet(Int64DistinctSet& set) const;
+    void FillHashSet(Int64DistinctSet& set, const std::vector<uint64_t>& mask) const;
     void FilterRows(const std::vector<int64_t>& mask) override;
+    std::unique_ptr<Column> CreateEmpty() const override;
+    void AppendRange(const Column& other, int64_t begin, int64_t end) override;
+    void AppendSortKeys(std::vector<std::string>& keys, bool is_desc) const override;
+    void ComputeHashes(std::vector<uint64_t>& hashes) const override;
+    void ComputeHashes(const std::vector<uint64_t>& mask, std::vector<uint64_t>& hashes) const override;
     void Clear() override { value_.clear(); }
     void SetData(const std::vector<uint8_t>& data) override;
 
@@ -280,6 +356,7 @@ class Timestamp : public Column {
 public:
     Timestamp() = default;
     explicit Timestamp(uint32_t value) { value_.push_back(value); }
+    explicit Timestamp(std::vector<uint32_t> values) : value_(std::move(values)) {}
 
     std::vector<uint8_t> Encode() const override;
     void Decode(const std::vector<uint8_t>& data) override;
@@ -297,6 +374,7 @@ public:
     CellTypes GetMax() const override;
     CellTypes GetMax(const std::vector<uint64_t>& mask) const override;
     CellTypes Get(int64_t r) const override { return GetCellAsString(r); }
+    const std::vector<uint32_t>& GetValues() const { return value_; }
 
     bool Compare(int row, Op op, CellTypes val) const override;
     void MergeHashes(
@@ -304,9 +382,14 @@ public:
         std::vector<std::vector<std::string>>& group_name,
         const std::function<CellTypes(const CellTypes&)>& transform = {}
     ) const override;
-    void FillHashSet(std::unordered_set<int64_t>& set) const;
-    void FillHashSet(std::unordered_set<int64_t>& set, const std::vector<uint64_t>& mask) const;
+    void FillHashSet(Int64DistinctSet& set) const;
+    void FillHashSet(Int64DistinctSet& set, const std::vector<uint64_t>& mask) const;
     void FilterRows(const std::vector<int64_t>& mask) override;
+    std::unique_ptr<Column> CreateEmpty() const override;
+    void AppendRange(const Column& other, int64_t begin, int64_t end) override;
+    void AppendSortKeys(std::vector<std::string>& keys, bool is_desc) const override;
+    void ComputeHashes(std::vector<uint64_t>& hashes) const override;
+    void ComputeHashes(const std::vector<uint64_t>& mask, std::vector<uint64_t>& hashes) const override;
     void Clear() override { value_.clear(); }
     void SetData(const std::vector<uint8_t>& data) override;
 
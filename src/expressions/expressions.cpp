@@ -0,0 +1,670 @@
+#include "expressions.h"
+
+#include "../string_functions/string_functions.h"
+#include "../utilities/utilities.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace {
+
+bool IsIntegralType(int64_t type) {
+    return type == static_cast<int64_t>(Types::TypeInt16) ||
+           type == static_cast<int64_t>(Types::TypeInt32) ||
+           type == static_cast<int64_t>(Types::TypeInt64) ||
+           type == static_cast<int64_t>(Types::TypeDate) ||
+           type == static_cast<int64_t>(Types::TypeTimestamp);
+}
+
+bool IsNumericType(int64_t type) {
+    return IsIntegralType(type) || type == static_cast<int64_t>(Types::TypeDouble);
+}
+
+bool IsTemporalType(int64_t type) {
+    return type == static_cast<int64_t>(Types::TypeDate) || type == static_cast<int64_t>(Types::TypeTimestamp);
+}
+
+template <typename T>
+struct Broadcast {
+    T value;
+    const T& operator[](size_t) const { return value; }
+};
+
+template <typename V>
+using ValueOf = std::decay_t<decltype(std::declval<const V&>()[0])>;
+
+template <typename T>
+int64_t OperandSize(const std::vector<T>& values, int64_t) {
+    return values.size();
+}
+
+template <typename T>
+int64_t OperandSize(const Broadcast<T>&, int64_t fallback) {
+    return fallback;
+}
+
+template <typename Fn>
+void VisitColumnValues(const Column& column, Fn&& fn) {
+    if (const auto* typed = dynamic_cast<const Int64*>(&column)) {
+        fn(typed->GetValues());
+    } else if (const auto* typed = dynamic_cast<const Int32*>(&column)) {
+        fn(typed->GetValues());
+    } else if (const auto* typed = dynamic_cast<const Int16*>(&column)) {
+        fn(typed->GetValues());
+    } else if (const auto* typed = dynamic_cast<const Double*>(&column)) {
+        fn(typed->GetValues());
+    } else if (const auto* typed = dynamic_cast<const String*>(&column)) {
+        fn(typed->GetValues());
+    } else if (const auto* typed = dynamic_cast<const Date*>(&column)) {
+        fn(typed->GetValues());
+    } else if (const auto* typed = dynamic_cast<const Timestamp*>(&column)) {
+        fn(typed->GetValues());
+    } else {
+        throw std::runtime_error("Unsupported column type in expression.");
+    }
+}
+
+template <typename Fn>
+void VisitOperand(const Expression& expression, const Batch& batch, std::unique_ptr<Column>& holder, Fn&& fn) {
+    if (std::optional<CellTypes> constant = expression.GetConstant()) {
+        std::visit([&](const auto& value) {
+            using T = std::decay_t<decltype(value)>;
+            fn(Broadcast<T>{value});
+        }, constant.value());
+        return;
+    }
+    VisitColumnValues(*expression.EvaluateInto(batch, holder), fn);
+}
+
+template <typename Out, typename L, typename R, typename Fn>
+std::vector<Out> ApplyBinary(const L& left, const R& right, int64_t row_count, Fn fn) {
+    std::vector<Out> result(row_count);
+    for (int64_t i = 0; i < row_count; ++i) {
+        result[i] = fn(static_cast<Out>(left[i]), static_cast<Out>(right[i]));
+    }
+    return result;
+}
+
+template <typename Out, typename L, typename R>
+std::vector<Out> ApplyArithmetic(ArithmeticOp op, const L& left, const R& right, int64_t row_count) {
+    switch (op) {
+        case ArithmeticOp::Add:
+            return ApplyBinary<Out>(left, right, row_count, std::plus<Out>{});
+        case ArithmeticOp::Subtract:
+            return ApplyBinary<Out>(left, right, row_count, std::minus<Out>{});
+        case ArithmeticOp::Multiply:
+            return ApplyBinary<Out>(left, right, row_count, std::multiplies<Out>{});
+        case ArithmeticOp::Divide:
+            return ApplyBinary<Out>(left, right, row_count, std::divides<Out>{});
+        case ArithmeticOp::Modulo:
+            if constexpr (std::is_integral_v<Out>) {
+                for (int64_t i = 0; i < row_count; ++i) {
+                    if (right[i] == 0) {
+                        throw std::runtime_error("Division by zero in expression.");
+                    }
+                }
+                return ApplyBinary<Out>(left, right, row_count, std::modulus<Out>{});
+            } else {
+                return ApplyBinary<Out>(left, right, row_count, [](Out a, Out b) { return std::fmod(a, b); });
+            }
+    }
+    throw std::runtime_error("Unknown arithmetic op.");
+}
+
+template <typename C, typename L, typename R, typename Fn>
+std::vector<int64_t> ApplyComparison(const L& left, const R& right, int64_t row_count, Fn fn) {
+    std::vector<int64_t> result(row_count);
+    for (int64_t i = 0; i < row_count; ++i) {
+        result[i] = fn(static_cast<const C&>(left[i]), static_cast<const C&>(right[i])) ? 1 : 0;
+    }
+    return result;
+}
+
+template <typename C, typename L, typename R>
+std::vector<int64_t> ApplyComparison(Column::Op op, const L& left, const R& right, int64_t row_count) {
+    switch (op) {
+        case Column::Op::EQ:
+            return ApplyComparison<C>(left, right, row_count, std::equal_to<C>{});
+        case Column::Op::NE:
+            return ApplyComparison<C>(left, right, row_count, std::not_equal_to<C>{});
+        case Column::Op::LT:
+            return ApplyComparison<C>(left, right, row_count, std::less<C>{});
+        case Column::Op::LE:
+            return ApplyComparison<C>(left, right, row_count, std::less_equal<C>{});
+        case Column::Op::GT:
+            return ApplyComparison<C>(left, right, row_count, std::greater<C>{});
+        case Column::Op::GE:
+            return ApplyComparison<C>(left, right, row_count, std::greater_equal<C>{});
+    }
+    throw std::runtime_error("Unknown comparison op.");
+}
+
+std::string CellToString(const CellTypes& value) {
+    return std::visit([](auto&& arg) -> std::string {
+        using T = std::decay_t<decltype(arg)>;
+        if constexpr (std::is_same_v<T, std::string>) {
+            return arg;
+        } else {
+            return std::to_string(arg);
+        }
+    }, value);
+}
+
+template <typename Out>
+std::vector<Out> Materialize(const Expression& expression, const Batch& batch, int64_t row_count) {
+    std::vector<Out> result;
+    std::unique_ptr<Column> holder;
+    if constexpr (std::is_same_v<Out, std::string>) {
+        if (std::optional<CellTypes> constant = expression.GetConstant()) {
+            result.assign(row_count, CellToString(constant.value()));
+            return result;
+        }
+        const Column* column = expression.EvaluateInto(batch, holder);
+        if (const auto* string_column = dynamic_cast<const String*>(column)) {
+            return string_column->GetValues();
+        }
+        result.reserve(row_count);
+        for (int64_t i = 0; i < row_count; ++i) {
+            result.push_back(column->GetCellAsString(i));
+        }
+    } else {
+        VisitOperand(expression, batch, holder, [&](const auto& values) {
+            using V = ValueOf<std::decay_t<decltype(values)>>;
+            if constexpr (std::is_same_v<V, std::string>) {
+                throw std::runtime_error("Expression expects a numeric value.");
+            } else {
+                result.resize(row_count);
+                for (int64_t i = 0; i < row_count; ++i) {
+                    result[i] = static_cast<Out>(values[i]);
+                }
+            }
+        });
+    }
+    return result;
+}
+
+template <typename Out>
+std::unique_ptr<Column> MakeColumn(int64_t type, std::vector<Out> values) {
+    if constexpr (std::is_same_v<Out, std::string>) {
+        return std::make_unique<String>(std::move(values));
+    } else if constexpr (std::is_same_v<Out, double>) {
+        return std::make_unique<Double>(std::move(values));
+    } else if constexpr (std::is_same_v<Out, uint32_t>) {
+        if (type == static_cast<int64_t>(Types::TypeDate)) {
+            return std::make_unique<Date>(std::move(values));
+        }
+        return std::make_unique<Timestamp>(std::move(values));
+    } else {
+        return std::make_unique<Int64>(std::move(values));
+    }
+}
+
+template <typename Out>
+std::unique_ptr<Column> SelectBranches(
+    const std::vector<std::pair<ExpressionPtr, ExpressionPtr>>& branches,
+    const Expression& else_value,
+    const Batch& batch,
+    int64_t type
+) {
+    int64_t row_count = GetBatchRowCount(batch);
+    std::vector<Out> result = Materialize<Out>(else_value, batch, row_count);
+    for (auto it = branches.rbegin(); it != branches.rend(); ++it) {
+        std::vector<int64_t> condition = Materialize<int64_t>(*it->first, batch, row_count);
+        std::vector<Out> value = Materialize<Out>(*it->second, batch, row_count);
+        for (int64_t i = 0; i < row_count; ++i) {
+            if (condition[i] != 0) {
+                result[i] = std::move(value[i]);
+            }
+        }
+    }
+    return MakeColumn<Out>(type, std::move(result));
+}
+
+std::string_view SubstringView(std::string_view value, int64_t start, std::optional<int64_t> length) {
+    int64_t size = value.size();
+    int64_t begin = start > 0 ? start - 1 : (start < 0 ? std::max<int64_t>(size + start, 0) : size);
+    if (begin >= size) {
+        return {};
+    }
+    int64_t count = length.has_value() ? std::max<int64_t>(length.value(), 0) : size - begin;
+    return value.substr(begin, count);
+}
+
+template <typename Fn>
+std::unique_ptr<Column> MapStrings(const String& column, Fn fn) {
+    using Out = std::invoke_result_t<Fn, const std::string&>;
+    if (column.HasDictionary()) {
+        const auto& dictionary = column.GetDictionary();
+        const auto& ids = column.GetDictionaryIds();
+        std::vector<Out> mapped;
+        mapped.reserve(dictionary.size());
+        for (const auto& value : dictionary) {
+            mapped.push_back(fn(value));
+        }
+        if constexpr (std::is_same_v<Out, std::string>) {
+            return std::make_unique<String>(std::move(mapped), ids);
+        } else {
+            std::vector<Out> result(ids.size());
+            for (size_t i = 0; i < ids.size(); ++i) {
+                result[i] = mapped[ids[i]];
+            }
+            return MakeColumn<Out>(static_cast<int64_t>(Types::TypeInt64), std::move(result));
+        }
+    }
+    const auto& values = column.GetValues();
+    std::vector<Out> result(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        result[i] = fn(values[i]);
+    }
+    if constexpr (std::is_same_v<Out, std::string>) {
+        return std::make_unique<String>(std::move(result));
+    } else {
+        return MakeColumn<Out>(static_cast<int64_t>(Types::TypeInt64), std::move(result));
+    }
+}
+
+const String& EvaluateString(const Expression& argument, const Batch& batch, std::unique_ptr<Column>& holder) {
+    return *static_cast<const String*>(argument.EvaluateInto(batch, holder));
+}
+
+class LocalTimeCache {
+public:
+    const std::tm& Get(std::time_t bucket) {
+        if (bucket != bucket_) {
+            localtime_r(&bucket, &tm_);
+            bucket_ = bucket;
+        }
+        return tm_;
+    }
+
+protected:
+    std::time_t bucket_ = -1;
+    std::tm tm_ = {};
+};
+
+template <typename Fn>
+std::vector<int64_t> ExtractFromTimestamps(const std::vector<uint32_t>& values, Fn fn) {
+    LocalTimeCache cache;
+    std::vector<int64_t> result(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        int64_t second = values[i] % 60;
+        result[i] = fn(cache.Get(static_cast<std::time_t>(values[i]) - second), second);
+    }
+    return result;
+}
+
+template <typename Fn>
+std::vector<int64_t> ExtractFromDates(const std::vector<uint32_t>& values, Fn fn) {
+    LocalTimeCache cache;
+    std::vector<int64_t> result(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        result[i] = fn(cache.Get(static_cast<std::time_t>(values[i]) * 86400), 0);
+    }
+    return result;
+}
+
+template <typename Extractor>
+std::vector<int64_t> ExtractPart(DatePart part, const std::vector<uint32_t>& values, Extractor extractor) {
+    switch (part) {
+        case DatePart::Year:
+            return extractor(values, [](const std::tm& tm, int64_t) -> int64_t { return tm.tm_year + 1900; });
+        case DatePart::Month:
+            return extractor(values, [](const std::tm& tm, int64_t) -> int64_t { return tm.tm_mon + 1; });
+        case DatePart::Day:
+            return extractor(values, [](const std::tm& tm, int64_t) -> int64_t { return tm.tm_mday; });
+        case DatePart::Hour:
+            return extractor(values, [](const std::tm& tm, int64_t) -> int64_t { return tm.tm_hour; });
+        case DatePart::Minute:
+            return extractor(values, [](const std::tm& tm, int64_t) -> int64_t { return tm.tm_min; });
+        case DatePart::Second:
+            return extractor(values, [](const std::tm&, int64_t second) -> int64_t { return second; });
+        case DatePart::DayOfWeek:
+            return extractor(values, [](const std::tm& tm, int64_t) -> int64_t { return tm.tm_wday == 0 ? 7 : tm.tm_wday; });
+    }
+    throw std::runtime_error("Unknown date part.");
+}
+
+} // namespace
+
+int64_t GetBatchRowCount(const Batch& batch) {
+    int64_t row_count = 0;
+    for (const auto& column : batch) {
+        if (column != nullptr) {
+            row_count = std::max(row_count, column->GetRowCount());
+        }
+    }
+    return row_count;
+}
+
+const Column* Expression::EvaluateInto(const Batch& batch, std::unique_ptr<Column>& holder) const {
+    if (const Column* column = TryBorrow(batch)) {
+        return column;
+    }
+    holder = Evaluate(batch);
+    return holder.get();
+}
+
+ColumnRefExpression::ColumnRefExpression(const std::string& column, const Scheme& scheme)
+    : column_index_(scheme.GetColumnIndex(column)), type_(scheme.GetTypeInfo(column)) {
+    if (column_index_ < 0) {
+        throw std::runtime_error("Unknown column in expression: " + column);
+    }
+}
+
+std::unique_ptr<Column> ColumnRefExpression::Evaluate(const Batch& batch) const {
+    const Column& column = *batch[column_index_];
+    std::unique_ptr<Column> result = column.CreateEmpty();
+    result->AppendRange(column, 0, column.GetRowCount());
+    return result;
+}
+
+LiteralExpression::LiteralExpression(CellTypes value) : value_(std::move(value)) {
+    if (std::holds_alternative<int64_t>(value_)) {
+        type_ = static_cast<int64_t>(Types::TypeInt64);
+    } else if (std::holds_alternative<double>(value_)) {
+        type_ = static_cast<int64_t>(Types::TypeDouble);
+    } else {
+        type_ = static_cast<int64_t>(Types::TypeString);
+    }
+}
+
+std::unique_ptr<Column> LiteralExpression::Evaluate(const Batch& batch) const {
+    int64_t row_count = GetBatchRowCount(batch);
+    return std::visit([&](const auto& value) -> std::unique_ptr<Column> {
+        using T = std::decay_t<decltype(value)>;
+        return MakeColumn<T>(type_, std::vector<T>(row_count, value));
+    }, value_);
+}
+
+ArithmeticExpression::ArithmeticExpression(ArithmeticOp op, ExpressionPtr left, ExpressionPtr right)
+    : op_(op), left_(std::move(left)), right_(std::move(right)) {
+    int64_t left_type = left_->GetOutputType();
+    int64_t right_type = right_->GetOutputType();
+    if (!IsNumericType(left_type) || !IsNumericType(right_type)) {
+        throw std::runtime_error("Arithmetic expression expects numeric operands.");
+    }
+    if (op_ == ArithmeticOp::Divide || !IsIntegralType(left_type) || !IsIntegralType(right_type)) {
+        type_ = static_cast<int64_t>(Types::TypeDouble);
+    } else {
+        type_ = static_cast<int64_t>(Types::TypeInt64);
+    }
+}
+
+std::unique_ptr<Column> ArithmeticExpression::Evaluate(const Batch& batch) const {
+    int64_t batch_rows = GetBatchRowCount(batch);
+    std::unique_ptr<Column> left_holder;
+    std::unique_ptr<Column> right_holder;
+    std::unique_ptr<Column> result;
+    VisitOperand(*left_, batch, left_holder, [&](const auto& left) {
+        VisitOperand(*right_, batch, right_holder, [&](const auto& right) {
+            using L = ValueOf<std::decay_t<decltype(left)>>;
+            using R = ValueOf<std::decay_t<decltype(right)>>;
+            if constexpr (std::is_same_v<L, std::string> || std::is_same_v<R, std::string>) {
+                throw std::runtime_error("Arithmetic expression expects numeric operands.");
+            } else {
+                int64_t row_count = std::min(OperandSize(left, batch_rows), OperandSize(right, batch_rows));
+                if (type_ == static_cast<int64_t>(Types::TypeDouble)) {
+                    result = std::make_unique<Double>(ApplyArithmetic<double>(op_, left, right, row_count));
+                } else {
+                    result = std::make_unique<Int64>(ApplyArithmetic<int64_t>(op_, left, right, row_count));
+                }
+            }
+        });
+    });
+    return result;
+}
+
+ComparisonExpression::ComparisonExpression(Op op, ExpressionPtr left, ExpressionPtr right)
+    : op_(op), left_(std::move(left)), right_(std::move(right)) {
+    auto coerce_literal = [](const ExpressionPtr& column, ExpressionPtr& literal) {
+        std::optional<CellTypes> constant = literal->GetConstant();
+        if (!constant.has_value() || !std::holds_alternative<std::string>(constant.value())) {
+            return;
+        }
+        const std::string& text = std::get<std::string>(constant.value());
+        if (column->GetOutputType() == static_cast<int64_t>(Types::TypeDate)) {
+            literal = std::make_shared<LiteralExpression>(static_cast<int64_t>(ParseDate(text)));
+        } else if (column->GetOutputType() == static_cast<int64_t>(Types::TypeTimestamp)) {
+            literal = std::make_shared<LiteralExpression>(static_cast<int64_t>(ParseTimestamp(text)));
+        }
+    };
+    coerce_literal(left_, right_);
+    coerce_literal(right_, left_);
+    bool is_left_string = left_->GetOutputType() == static_cast<int64_t>(Types::TypeString);
+    bool is_right_string = right_->GetOutputType() == static_cast<int64_t>(Types::TypeString);
+    if (is_left_string != is_right_string) {
+        throw std::runtime_error("Comparison expression operands have incompatible types.");
+    }
+}
+
+std::unique_ptr<Column> ComparisonExpression::Evaluate(const Batch& batch) const {
+    int64_t batch_rows = GetBatchRowCount(batch);
+    std::unique_ptr<Column> left_holder;
+    std::unique_ptr<Column> right_holder;
+    std::unique_ptr<Column> result;
+    VisitOperand(*left_, batch, left_holder, [&](const auto& left) {
+        VisitOperand(*right_, batch, right_holder, [&](const auto& right) {
+            using L = ValueOf<std::decay_t<decltype(left)>>;
+            using R = ValueOf<std::decay_t<decltype(right)>>;
+            int64_t row_count = std::min(OperandSize(left, batch_rows), OperandSize(right, batch_rows));
+            if constexpr (std::is_same_v<L, std::string> && std::is_same_v<R, std::string>) {
+                result = std::make_unique<Int64>(ApplyComparison<std::string>(op_, left, right, row_count));
+            } else if constexpr (std::is_same_v<L, std::string> || std::is_same_v<R, std::string>) {
+                throw std::runtime_error("Comparison expression operands have incompatible types.");
+            } else if constexpr (std::is_floating_point_v<L> || std::is_floating_point_v<R>) {
+                result = std::make_unique<Int64>(ApplyComparison<double>(op_, left, right, row_count));
+            } else {
+                result = std::make_unique<Int64>(ApplyComparison<int64_t>(op_, left, right, row_count));
+            }
+        });
+    });
+    return result;
+}
+
+CaseExpression::CaseExpression(std::vector<std::pair<ExpressionPtr, ExpressionPtr>> branches, ExpressionPtr else_value)
+    : branches_(std::move(branches)), else_value_(std::move(else_value)) {
+    std::vector<int64_t> types{else_value_->GetOutputType()};
+    for (const auto& [condition, value] : branches_) {
+        if (condition->GetOutputType() == static_cast<int64_t>(Types::TypeString)) {
+            throw std::runtime_error("CASE condition must be numeric.");
+        }
+        types.push_back(value->GetOutputType());
+    }
+    auto has_type = [&](Types type) {
+        return std::find(types.begin(), types.end(), static_cast<int64_t>(type)) != types.end();
+    };
+    bool is_uniform = std::all_of(types.begin(), types.end(), [&](int64_t type) { return type == types.front(); });
+    if (has_type(Types::TypeString)) {
+        type_ = static_cast<int64_t>(Types::TypeString);
+    } else if (has_type(Types::TypeDouble)) {
+        type_ = static_cast<int64_t>(Types::TypeDouble);
+    } else if (is_uniform && IsTemporalType(types.front())) {
+        type_ = types.front();
+    } else {
+        type_ = static_cast<int64_t>(Types::TypeInt64);
+    }
+}
+
+std::unique_ptr<Column> CaseExpression::Evaluate(const Batch& batch) const {
+    if (type_ == static_cast<int64_t>(Types::TypeString)) {
+        return SelectBranches<std::string>(branches_, *else_value_, batch, type_);
+    }
+    if (type_ == static_cast<int64_t>(Types::TypeDouble)) {
+        return SelectBranches<double>(branches_, *else_value_, batch, type_);
+    }
+    if (IsTemporalType(type_)) {
+        return SelectBranches<uint32_t>(branches_, *else_value_, batch, type_);
+    }
+    return SelectBranches<int64_t>(branches_, *else_value_, batch, type_);
+}
+
+void CaseExpression::CollectColumns(std::vector<int>& column_ids) const {
+    for (const auto& [condition, value] : branches_) {
+        condition->CollectColumns(column_ids);
+        value->CollectColumns(column_ids);
+    }
+    else_value_->CollectColumns(column_ids);
+}
+
+StringLengthExpression::StringLengthExpression(ExpressionPtr argument) : argument_(std::move(argument)) {
+    if (argument_->GetOutputType() != static_cast<int64_t>(Types::TypeString)) {
+        throw std::runtime_error("length() expects a string argument.");
+    }
+}
+
+std::unique_ptr<Column> StringLengthExpression::Evaluate(const Batch& batch) const {
+    std::unique_ptr<Column> holder;
+    const auto& values = static_cast<const String*>(argument_->EvaluateInto(batch, holder))->GetValues();
+    std::vector<int64_t> result(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        result[i] = values[i].size();
+    }
+    return std::make_unique<Int64>(std::move(result));
+}
+
+SubstringExpression::SubstringExpression(ExpressionPtr argument, int64_t start, std::optional<int64_t> length)
+    : argument_(std::move(argument)), start_(start), length_(length) {
+    if (argument_->GetOutputType() != static_cast<int64_t>(Types::TypeString)) {
+        throw std::runtime_error("substring() expects a string argument.");
+    }
+}
+
+std::unique_ptr<Column> SubstringExpression::Evaluate(const Batch& batch) const {
+    std::unique_ptr<Column> holder;
+    const auto& values = static_cast<const String*>(argument_->EvaluateInto(batch, holder))->GetValues();
+    std::vector<std::string> result(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        result[i] = SubstringView(values[i], start_, length_);
+    }
+    return std::make_unique<String>(std::move(result));
+}
+
+PositionExpression::PositionExpression(ExpressionPtr haystack, std::string needle)
+    : haystack_(std::move(haystack)), needle_(std::move(needle)) {
+    if (haystack_->GetOutputType() != static_cast<int64_t>(Types::TypeString)) {
+        throw std::runtime_error("position() expects a string argument.");
+    }
+}
+
+std::unique_ptr<Column> PositionExpression::Evaluate(const Batch& batch) const {
+    std::unique_ptr<Column> holder;
+    const auto& values = static_cast<const String*>(haystack_->EvaluateInto(batch, holder))->GetValues();
+    std::vector<int64_t> result(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        size_t position = std::string_view(values[i]).find(needle_);
+        result[i] = position == std::string_view::npos ? 0 : static_cast<int64_t>(position) + 1;
+    }
+    return std::make_unique<Int64>(std::move(result));
+}
+
+StringFunctionExpression::StringFunctionExpression(StringFunction function, ExpressionPtr argument)
+    : function_(function), argument_(std::move(argument)) {
+    if (argument_->GetOutputType() != static_cast<int64_t>(Types::TypeString)) {
+        throw std::runtime_error("String function expects a string argument.");
+    }
+}
+
+std::unique_ptr<Column> StringFunctionExpression::Evaluate(const Batch& batch) const {
+    std::unique_ptr<Column> holder;
+    const String& column = EvaluateString(*argument_, batch, holder);
+    switch (function_) {
+        case StringFunction::Lower:
+            return MapStrings(column, [](const std::string& value) { return ToLower(value); });
+        case StringFunction::Upper:
+            return MapStrings(column, [](const std::string& value) { return ToUpper(value); });
+        case StringFunction::Domain:
+            return MapStrings(column, [](const std::string& value) { return std::string(ExtractUrlDomain(value)); });
+        case StringFunction::DomainWithoutWww:
+            return MapStrings(column, [](const std::string& value) { return std::string(ExtractUrlDomainWithoutWww(value)); });
+        case StringFunction::Path:
+            return MapStrings(column, [](const std::string& value) { return std::string(ExtractUrlPath(value)); });
+        case StringFunction::QueryString:
+            return MapStrings(column, [](const std::string& value) { return std::string(ExtractUrlQueryString(value)); });
+    }
+    throw std::runtime_error("Unknown string function.");
+}
+
+RegexpReplaceExpression::RegexpReplaceExpression(ExpressionPtr argument, std::string_view pattern, std::string replacement)
+    : argument_(std::move(argument)), regex_(pattern), replacement_(std::move(replacement)) {
+    if (argument_->GetOutputType() != static_cast<int64_t>(Types::TypeString)) {
+        throw std::runtime_error("replaceRegexp() expects a string argument.");
+    }
+}
+
+std::unique_ptr<Column> RegexpReplaceExpression::Evaluate(const Batch& batch) const {
+    std::unique_ptr<Column> holder;
+    return MapStrings(EvaluateString(*argument_, batch, holder), [this](const std::string& value) {
+        return regex_.Replace(value, replacement_);
+    });
+}
+
+RegexpMatchExpression::RegexpMatchExpression(ExpressionPtr argument, std::string_view pattern)
+    : argument_(std::move(argument)), regex_(pattern) {
+    if (argument_->GetOutputType() != static_cast<int64_t>(Types::TypeString)) {
+        throw std::runtime_error("match() expects a string argument.");
+    }
+}
+
+std::unique_ptr<Column> RegexpMatchExpression::Evaluate(const Batch& batch) const {
+    std::unique_ptr<Column> holder;
+    return MapStrings(EvaluateString(*argument_, batch, holder), [this](const std::string& value) {
+        return static_cast<int64_t>(regex_.Search(value));
+    });
+}
+
+ExtractExpression::ExtractExpression(DatePart part, ExpressionPtr argument) : part_(part), argument_(std::move(argument)) {
+    if (!IsTemporalType(argument_->GetOutputType())) {
+        throw std::runtime_error("extract() expects a date or timestamp argument.");
+    }
+}
+
+std::unique_ptr<Column> ExtractExpression::Evaluate(const Batch& batch) const {
+    std::unique_ptr<Column> holder;
+    const Column* column = argument_->EvaluateInto(batch, holder);
+    if (const auto* timestamps = dynamic_cast<const Timestamp*>(column)) {
+        return std::make_unique<Int64>(ExtractPart(part_, timestamps->GetValues(), [](const auto& values, auto fn) {
+            return ExtractFromTimestamps(values, fn);
+        }));
+    }
+    return std::make_unique<Int64>(ExtractPart(part_, static_cast<const Date*>(column)->GetValues(), [](const auto& values, auto fn) {
+        return ExtractFromDates(values, fn);
+    }));
+}
+
+DateTruncExpression::DateTruncExpression(DatePart unit, ExpressionPtr argument) : unit_(unit), argument_(std::move(argument)) {
+    int64_t type = argument_->GetOutputType();
+    if (type == static_cast<int64_t>(Types::TypeTimestamp)) {
+        if (unit_ != DatePart::Minute && unit_ != DatePart::Hour && unit_ != DatePart::Day) {
+            throw std::runtime_error("date_trunc() supports minute, hour and day for timestamps.");
+        }
+    } else if (type != static_cast<int64_t>(Types::TypeDate) || unit_ != DatePart::Day) {
+        throw std::runtime_error("date_trunc() supports only day for dates.");
+    }
+}
+
+std::unique_ptr<Column> DateTruncExpression::Evaluate(const Batch& batch) const {
+    if (argument_->GetOutputType() == static_cast<int64_t>(Types::TypeDate)) {
+        return argument_->Evaluate(batch);
+    }
+    std::unique_ptr<Column> holder;
+    const auto& values = static_cast<const Timestamp*>(argument_->EvaluateInto(batch, holder))->GetValues();
+    std::vector<uint32_t> result(values.size());
+    if (unit_ == DatePart::Minute) {
+        for (size_t i = 0; i < values.size(); ++i) {
+            result[i] = values[i] - values[i] % 60;
+        }
+        return std::make_unique<Timestamp>(std::move(result));
+    }
+    LocalTimeCache cache;
+    for (size_t i = 0; i < values.size(); ++i) {
+        uint32_t minute = values[i] - values[i] % 60;
+        const std::tm& tm = cache.Get(minute);
+        result[i] = minute - tm.tm_min * 60 - (unit_ == DatePart::Day ? tm.tm_hour * 3600 : 0);
+    }
+    return std::make_unique<Timestamp>(std::move(result));
+}
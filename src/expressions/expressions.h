@@ -0,0 +1,205 @@
+#pragma once
+
+#include "../column_types/column_types.h"
+#include "../regex/regex.h"
+#include "../scheme/scheme.h"
+#include "../utilities/utilities.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+using Batch = std::vector<std::unique_ptr<Column>>;
+
+int64_t GetBatchRowCount(const Batch& batch);
+
+class Expression {
+public:
+    virtual ~Expression() = default;
+    virtual std::unique_ptr<Column> Evaluate(const Batch& batch) const = 0;
+    virtual int64_t GetOutputType() const = 0;
+    virtual const Column* TryBorrow(const Batch&) const { return nullptr; }
+    virtual std::optional<CellTypes> GetConstant() const { return std::nullopt; }
+    virtual void CollectColumns(std::vector<int>&) const {}
+    const Column* EvaluateInto(const Batch& batch, std::unique_ptr<Column>& holder) const;
+};
+
+using ExpressionPtr = std::shared_ptr<Expression>;
+
+class ColumnRefExpression : public Expression {
+public:
+    ColumnRefExpression(const std::string& column, const Scheme& scheme);
+    std::unique_ptr<Column> Evaluate(const Batch& batch) const override;
+    int64_t GetOutputType() const override { return type_; }
+    const Column* TryBorrow(const Batch& batch) const override { return batch[column_index_].get(); }
+    void CollectColumns(std::vector<int>& column_ids) const override { column_ids.push_back(column_index_); }
+    int GetColumnIndex() const { return column_index_; }
+
+protected:
+    int column_index_;
+    int64_t type_;
+};
+
+class LiteralExpression : public Expression {
+public:
+    explicit LiteralExpression(CellTypes value);
+    std::unique_ptr<Column> Evaluate(const Batch& batch) const override;
+    int64_t GetOutputType() const override { return type_; }
+    std::optional<CellTypes> GetConstant() const override { return value_; }
+
+protected:
+    CellTypes value_;
+    int64_t type_;
+};
+
+enum class ArithmeticOp { Add, Subtract, Multiply, Divide, Modulo };
+
+class ArithmeticExpression : public Expression {
+public:
+    ArithmeticExpression(ArithmeticOp op, ExpressionPtr left, ExpressionPtr right);
+    std::unique_ptr<Column> Evaluate(const Batch& batch) const override;
+    int64_t GetOutputType() const override { return type_; }
+    void CollectColumns(std::vector<int>& column_ids) const override {
+        left_->CollectColumns(column_ids);
+        right_->CollectColumns(column_ids);
+    }
+
+protected:
+    ArithmeticOp op_;
+    ExpressionPtr left_;
+    ExpressionPtr right_;
+    int64_t type_;
+};
+
+class ComparisonExpression : public Expression {
+public:
+    using Op = Column::Op;
+    ComparisonExpression(Op op, ExpressionPtr left, ExpressionPtr right);
+    std::unique_ptr<Column> Evaluate(const Batch& batch) const override;
+    int64_t GetOutputType() const override { return static_cast<int64_t>(Types::TypeInt64); }
+    void CollectColumns(std::vector<int>& column_ids) const override {
+        left_->CollectColumns(column_ids);
+        right_->CollectColumns(column_ids);
+    }
+
+protected:
+    Op op_;
+    ExpressionPtr left_;
+    ExpressionPtr right_;
+};
+
+class CaseExpression : public Expression {
+public:
+    CaseExpression(std::vector<std::pair<ExpressionPtr, ExpressionPtr>> branches, ExpressionPtr else_value);
+    std::unique_ptr<Column> Evaluate(const Batch& batch) const override;
+    int64_t GetOutputType() const override { return type_; }
+    void CollectColumns(std::vector<int>& column_ids) const override;
+
+protected:
+    std::vector<std::pair<ExpressionPtr, ExpressionPtr>> branches_;
+    ExpressionPtr else_value_;
+    int64_t type_;
+};
+
+class StringLengthExpression : public Expression {
+public:
+    explicit StringLengthExpression(ExpressionPtr argument);
+    std::unique_ptr<Column> Evaluate(const Batch& batch) const override;
+    int64_t GetOutputType() const override { return static_cast<int64_t>(Types::TypeInt64); }
+    void CollectColumns(std::vector<int>& column_ids) const override { argument_->CollectColumns(column_ids); }
+
+protected:
+    ExpressionPtr argument_;
+};
+
+class SubstringExpression : public Expression {
+public:
+    SubstringExpression(ExpressionPtr argument, int64_t start, std::optional<int64_t> length = std::nullopt);
+    std::unique_ptr<Column> Evaluate(const Batch& batch) const override;
+    int64_t GetOutputType() const override { return static_cast<int64_t>(Types::TypeString); }
+    void CollectColumns(std::vector<int>& column_ids) const override { argument_->CollectColumns(column_ids); }
+
+protected:
+    ExpressionPtr argument_;
+    int64_t start_;
+    std::optional<int64_t> length_;
+};
+
+class PositionExpression : public Expression {
+public:
+    PositionExpression(ExpressionPtr haystack, std::string needle);
+    std::unique_ptr<Column> Evaluate(const Batch& batch) const override;
+    int64_t GetOutputType() const override { return static_cast<int64_t>(Types::TypeInt64); }
+    void CollectColumns(std::vector<int>& column_ids) const override { haystack_->CollectColumns(column_ids); }
+
+protected:
+    ExpressionPtr haystack_;
+    std::string needle_;
+};
+
+enum class StringFunction { Lower, Upper, Domain, DomainWithoutWww, Path, QueryString };
+
+class StringFunctionExpression : public Expression {
+public:
+    StringFunctionExpression(StringFunction function, ExpressionPtr argument);
+    std::unique_ptr<Column> Evaluate(const Batch& batch) const override;
+    int64_t GetOutputType() const override { return static_cast<int64_t>(Types::TypeString); }
+    void CollectColumns(std::vector<int>& column_ids) const override { argument_->CollectColumns(column_ids); }
+
+protected:
+    StringFunction function_;
+    ExpressionPtr argument_;
+};
+
+class RegexpReplaceExpression : public Expression {
+public:
+    RegexpReplaceExpression(ExpressionPtr argument, std::string_view pattern, std::string replacement);
+    std::unique_ptr<Column> Evaluate(const Batch& batch) const override;
+    int64_t GetOutputType() const override { return static_cast<int64_t>(Types::TypeString); }
+    void CollectColumns(std::vector<int>& column_ids) const override { argument_->CollectColumns(column_ids); }
+
+protected:
+    ExpressionPtr argument_;
+    Regex regex_;
+    std::string replacement_;
+};
+
+class RegexpMatchExpression : public Expression {
+public:
+    RegexpMatchExpression(ExpressionPtr argument, std::string_view pattern);
+    std::unique_ptr<Column> Evaluate(const Batch& batch) const override;
+    int64_t GetOutputType() const override { return static_cast<int64_t>(Types::TypeInt64); }
+    void CollectColumns(std::vector<int>& column_ids) const override { argument_->CollectColumns(column_ids); }
+
+protected:
+    ExpressionPtr argument_;
+    Regex regex_;
+};
+
+enum class DatePart { Year, Month, Day, Hour, Minute, Second, DayOfWeek };
+
+class ExtractExpression : public Expression {
+public:
+    ExtractExpression(DatePart part, ExpressionPtr argument);
+    std::unique_ptr<Column> Evaluate(const Batch& batch) const override;
+    int64_t GetOutputType() const override { return static_cast<int64_t>(Types::TypeInt64); }
+    void CollectColumns(std::vector<int>& column_ids) const override { argument_->CollectColumns(column_ids); }
+
+protected:
+    DatePart part_;
+    ExpressionPtr argument_;
+};
+
+class DateTruncExpression : public Expression {
+public:
+    DateTruncExpression(DatePart unit, ExpressionPtr argument);
+    std::unique_ptr<Column> Evaluate(const Batch& batch) const override;
+    int64_t GetOutputType() const override { return argument_->GetOutputType(); }
+    void CollectColumns(std::vector<int>& column_ids) const override { argument_->CollectColumns(column_ids); }
+
+protected:
+    DatePart unit_;
+    ExpressionPtr argument_;
+};
@@ -0,0 +1,135 @@
+#include "external_sort.h"
+
+#include <stdexcept>
+#include <cstdio>
+#include <utility>
+
+namespace {
+
+template <typename T>
+void WriteValue(std::ofstream& output, const T& value) {
+    output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadValue(std::ifstream& input, T& value) {
+    return static_cast<bool>(input.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+} // namespace
+
+SortRunWriter::SortRunWriter(const std::string& path, int64_t chunk_rows) : output_(path, std::ios::binary), chunk_rows_(chunk_rows) {
+    if (!output_) {
+        throw std::runtime_error("Cannot open sort run file for writing.");
+    }
+}
+
+void SortRunWriter::Write(const Batch& batch, const std::vector<std::string>& keys) {
+    int64_t row_count = keys.size();
+    for (int64_t begin = 0; begin < row_count; begin += chunk_rows_) {
+        WriteChunk(batch, keys, begin, std::min(begin + chunk_rows_, row_count));
+    }
+}
+
+void SortRunWriter::WriteChunk(const Batch& batch, const std::vector<std::string>& keys, int64_t begin, int64_t end) {
+    WriteValue<int64_t>(output_, end - begin);
+    for (int64_t r = begin; r < end; ++r) {
+        WriteValue<int64_t>(output_, keys[r].size());
+        output_.write(keys[r].data(), keys[r].size());
+    }
+    for (const auto& column : batch) {
+        auto slice = column->CreateEmpty();
+        slice->AppendRange(*column, begin, end);
+        std::vector<uint8_t> encoded = slice->Encode();
+        WriteValue<int64_t>(output_, encoded.size());
+        output_.write(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+    }
+    if (!output_) {
+        throw std::runtime_error("Failed to write sort run chunk.");
+    }
+}
+
+SortRunWriter::~SortRunWriter() = default;
+
+SortRunReader::SortRunReader(const std::string& path, const Batch& prototype) : path_(path), input_(path, std::ios::binary) {
+    if (!input_) {
+        throw std::runtime_error("Cannot open sort run file for reading.");
+    }
+    for (const auto& column : prototype) {
+        chunk_.push_back(column->CreateEmpty());
+    }
+    ReadChunk();
+}
+
+void SortRunReader::ReadChunk() {
+    int64_t row_count = 0;
+    if (!ReadValue(input_, row_count)) {
+        is_exhausted_ = true;
+        keys_.clear();
+        for (auto& column : chunk_) {
+            column->Clear();
+        }
+        return;
+    }
+    keys_.resize(row_count);
+    for (auto& key : keys_) {
+        int64_t key_size = 0;
+        ReadValue(input_, key_size);
+        key.resize(key_size);
+        input_.read(key.data(), key_size);
+    }
+    std::vector<uint8_t> data;
+    for (auto& column : chunk_) {
+        int64_t data_size = 0;
+        ReadValue(input_, data_size);
+        data.resize(data_size);
+        input_.read(reinterpret_cast<char*>(data.data()), data_size);
+        column->Clear();
+        column->SetData(data);
+    }
+    if (!input_) {
+        throw std::runtime_error("Sort run file is truncated.");
+    }
+    row_ = 0;
+}
+
+void SortRunReader::Advance() {
+    ++row_;
+    if (row_ == static_cast<int64_t>(keys_.size())) {
+        ReadChunk();
+    }
+}
+
+SortRunReader::~SortRunReader() {
+    input_.close();
+    std::remove(path_.c_str());
+}
+
+LoserTree::LoserTree(int64_t leaf_count, std::function<bool(int64_t, int64_t)> less) : leaf_count_(leaf_count), less_(std::move(less)), losers_(leaf_count) {
+    if (leaf_count_ <= 0) {
+        throw std::runtime_error("Loser tree needs at least one leaf.");
+    }
+    winner_ = Build(1);
+}
+
+int64_t LoserTree::Build(int64_t node) {
+    if (node >= leaf_count_) {
+        return node - leaf_count_;
+    }
+    int64_t left = Build(2 * node);
+    int64_t right = Build(2 * node + 1);
+    if (less_(right, left)) {
+        losers_[node] = left;
+        return right;
+    }
+    losers_[node] = right;
+    return left;
+}
+
+void LoserTree::Replay() {
+    for (int64_t node = (winner_ + leaf_count_) / 2; node >= 1; node /= 2) {
+        if (less_(losers_[node], winner_)) {
+            std::swap(losers_[node], winner_);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../column_types/column_types.h"
+
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+using Batch = std::vector<std::unique_ptr<Column>>;
+
+class SortRunWriter {
+public:
+    SortRunWriter(const std::string& path, int64_t chunk_rows);
+    void Write(const Batch& batch, const std::vector<std::string>& keys);
+    ~SortRunWriter();
+
+protected:
+    void WriteChunk(const Batch& batch, const std::vector<std::string>& keys, int64_t begin, int64_t end);
+
+    std::ofstream output_;
+    int64_t chunk_rows_;
+};
+
+class SortRunReader {
+public:
+    SortRunReader(const std::string& path, const Batch& prototype);
+    bool IsExhausted() const { return is_exhausted_; }
+    const std::string& GetKey() const { return keys_[row_]; }
+    const Batch& GetChunk() const { return chunk_; }
+    int64_t GetRow() const { return row_; }
+    int64_t GetChunkRowCount() const { return static_cast<int64_t>(keys_.size()); }
+    void Advance();
+    ~SortRunReader();
+
+protected:
+    void ReadChunk();
+
+    std::string path_;
+    std::ifstream input_;
+    Batch chunk_;
+    std::vector<std::string> keys_;
+    int64_t row_ = 0;
+    bool is_exhausted_ = false;
+};
+
+class LoserTree {
+public:
+    LoserTree(int64_t leaf_count, std::function<bool(int64_t, int64_t)> less);
+    int64_t GetWinner() const { return winner_; }
+    void Replay();
+
+protected:
+    int64_t Build(int64_t node);
+
+    int64_t leaf_count_;
+    std::function<bool(int64_t, int64_t)> less_;
+    std::vector<int64_t> losers_;
+    int64_t winner_;
+};
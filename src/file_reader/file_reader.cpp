@@ -2,29 +2,119 @@
 
 #include "../utilities/utilities.h"
 
+#include <algorithm>
 #include <vector>
 #include <stdexcept>
 #include <cstring>
 
 namespace {
 
+constexpr size_t kDecodeSplitRows = 1 << 18;
+constexpr size_t kMaxRecycledColumns = 2;
+constexpr size_t kStatsSectionHeaderSize = 2 * sizeof(uint32_t) + sizeof(int64_t);
+
 template <typename T>
-T ReadStatBytes(const uint8_t*& ptr) {
+T ReadStatBytes(const uint8_t*& ptr, const uint8_t* end) {
+    if (end - ptr < static_cast<std::ptrdiff_t>(sizeof(T))) {
+        throw std::runtime_error("Truncated column statistics.");
+    }
     T value;
     std::memcpy(&value, ptr, sizeof(T));
     ptr += sizeof(T);
     return value;
 }
 
-std::string ReadStatString(const uint8_t*& ptr) {
-    int64_t len = ReadStatBytes<int64_t>(ptr);
+int64_t ReadStatSize(const uint8_t*& ptr, const uint8_t* end) {
+    int64_t size = ReadStatBytes<int64_t>(ptr, end);
+    if (size < 0 || size > end - ptr) {
+        throw std::runtime_error("Corrupted column statistics size.");
+    }
+    return size;
+}
+
+std::string ReadStatString(const uint8_t*& ptr, const uint8_t* end) {
+    int64_t len = ReadStatSize(ptr, end);
     std::string value(reinterpret_cast<const char*>(ptr), len);
     ptr += len;
     return value;
 }
 
+CellTypes ReadStatValue(const uint8_t*& ptr, const uint8_t* end, int64_t type) {
+    switch (type) {
+        case static_cast<int64_t>(Types::TypeInt16):
+        case static_cast<int64_t>(Types::TypeInt32):
+        case static_cast<int64_t>(Types::TypeInt64):
+            return ReadStatBytes<int64_t>(ptr, end);
+        case static_cast<int64_t>(Types::TypeDouble):
+            return ReadStatBytes<double>(ptr, end);
+        case static_cast<int64_t>(Types::TypeString):
+        case static_cast<int64_t>(Types::TypeDate):
+        case static_cast<int64_t>(Types::TypeTimestamp):
+            return ReadStatString(ptr, end);
+    }
+    throw std::runtime_error("Unknown column type.");
+}
+
+std::vector<StatsBucket> ReadStatBuckets(const uint8_t*& ptr, const uint8_t* end, int64_t type) {
+    uint32_t count = ReadStatBytes<uint32_t>(ptr, end);
+    std::vector<StatsBucket> buckets;
+    buckets.reserve(std::min<size_t>(count, static_cast<size_t>(end - ptr) / sizeof(int64_t)));
+    for (uint32_t i = 0; i < count; ++i) {
+        CellTypes value = ReadStatValue(ptr, end, type);
+        buckets.push_back(StatsBucket{std::move(value), ReadStatBytes<int64_t>(ptr, end)});
+    }
+    return buckets;
+}
+
+std::shared_ptr<const ExtendedColumnStats> ReadExtendedStats(const uint8_t*& ptr, const uint8_t* end, int64_t type) {
+    uint8_t fields = ReadStatBytes<uint8_t>(ptr, end);
+    if (fields == 0) {
+        return nullptr;
+    }
+    auto stats = std::make_shared<ExtendedColumnStats>();
+    if (fields & static_cast<uint8_t>(ExtendedStatsField::Sum)) {
+        if (type == static_cast<int64_t>(Types::TypeDouble)) {
+            stats->sum = ReadStatBytes<double>(ptr, end);
+        } else {
+            stats->sum = ReadStatBytes<int64_t>(ptr, end);
+        }
+    }
+    if (fields & static_cast<uint8_t>(ExtendedStatsField::Distinct)) {
+        int64_t size = ReadStatSize(ptr, end);
+        stats->distinct = HyperLogLog::Deserialize(ptr, size);
+        ptr += size;
+    }
+    if (fields & static_cast<uint8_t>(ExtendedStatsField::Histogram)) {
+        stats->histogram = ReadStatBuckets(ptr, end, type);
+    }
+    if (fields & static_cast<uint8_t>(ExtendedStatsField::TopValues)) {
+        stats->top_values = ReadStatBuckets(ptr, end, type);
+    }
+    return stats;
+}
+
 } // namespace
 
+std::unique_ptr<Column> CreateColumn(int64_t type) {
+    switch (type) {
+        case static_cast<int64_t>(Types::TypeInt16):
+            return std::make_unique<Int16>();
+        case static_cast<int64_t>(Types::TypeInt32):
+            return std::make_unique<Int32>();
+        case static_cast<int64_t>(Types::TypeInt64):
+            return std::make_unique<Int64>();
+        case static_cast<int64_t>(Types::TypeString):
+            return std::make_unique<String>();
+        case static_cast<int64_t>(Types::TypeDouble):
+            return std::make_unique<Double>();
+        case static_cast<int64_t>(Types::TypeDate):
+            return std::make_unique<Date>();
+        case static_cast<int64_t>(Types::TypeTimestamp):
+            return std::make_unique<Timestamp>();
+    }
+    throw std::runtime_error("Unknown column type.");
+}
+
 RowGroupReader::RowGroupReader(std::istream& input) : impl_(std::make_unique<Impl>(input)) {}
 
 class RowGroupReader::Impl {
@@ -37,23 +127,65 @@ public:
         if (curr_batch >= metadata_.GetBatchStartPos().size()) {
             return std::nullopt;
         }
-        InitRowGroup();
-        input_.seekg(metadata_.GetBatchStartPos()[curr_batch], std::ios::beg);
+        Batch batch = ReadBatch(GetBatchIndex(), ids);
+        ++curr_batch;
+        return batch;
+    }
+
+    Batch ReadBatch(int64_t batch_index, const std::vector<int>& ids) {
+        if (batch_index < 0 || batch_index >= GetBatchCount()) {
+            throw std::runtime_error("Batch index out of range.");
+        }
+        input_.seekg(metadata_.GetBatchStartPos()[batch_index], std::ios::beg);
         if (!input_) {
                 throw std::runtime_error("Cannot read batch.");
             }
-        std::vector<int64_t> batch_metadata = metadata_.GetBatchMetadata(curr_batch);
+        std::vector<int64_t> batch_metadata = metadata_.GetBatchMetadata(batch_index);
         std::vector<int64_t> column_sizes;
         for (int64_t i = 0; i < metadata_.GetColumnNum(); ++i) {
             column_sizes.push_back(batch_metadata[i + 1]);
         }
+        Batch batch(metadata_.GetColumnNum());
         for (int i : ids) {
-            std::vector<uint8_t> column_data = GetColumnData(i, column_sizes);
-            row_group_[i]->SetData(column_data);
+            batch[i] = AcquireColumn(i);
         }
-        ++curr_batch;
-        return std::move(row_group_);
+        if (decode_pool_ == nullptr) {
+            for (int i : ids) {
+                std::vector<uint8_t> column_data = GetColumnData(i, column_sizes);
+                batch[i]->SetData(column_data);
+            }
+            return batch;
+        }
+        std::vector<std::vector<uint8_t>> column_data;
+        column_data.reserve(ids.size());
+        for (int i : ids) {
+            column_data.push_back(GetColumnData(i, column_sizes));
+        }
+        RangeExecutor executor = [this](size_t count, const std::function<void(size_t, size_t)>& fn) {
+            if (count <= kDecodeSplitRows) {
+                fn(0, count);
+                return;
+            }
+            TaskGroup group(*decode_pool_);
+            for (size_t begin = 0; begin < count; begin += kDecodeSplitRows) {
+                size_t end = std::min(count, begin + kDecodeSplitRows);
+                group.Submit([&fn, begin, end]() { fn(begin, end); });
+            }
+            group.Wait();
+        };
+        TaskGroup group(*decode_pool_);
+        for (size_t k = 0; k < ids.size(); ++k) {
+            group.Submit([&, k]() { batch[ids[k]]->SetData(column_data[k], executor); });
+        }
+        group.Wait();
+        return batch;
+    }
 
+    int64_t GetNextBatchIndex() const {
+        if (curr_batch >= GetBatchCount()) {
+            return -1;
+        }
+        return GetBatchIndex();
     }
 
     void ReadToCSV(const char* filename) {
@@ -114,7 +246,7 @@ public:
         if (curr_batch >= metadata_.GetBatchStartPos().size()) {
             return std::nullopt;
         }
-        return metadata_.GetBatchBlockStats(curr_batch);
+        return metadata_.GetBatchBlockStats(GetBatchIndex());
     }
 
     void SkipNextBatch() {
@@ -123,41 +255,72 @@ public:
         }
     }
 
+    int64_t GetBatchCount() const {
+        return metadata_.GetBatchStartPos().size();
+    }
+
+    BatchBlockStats GetBatchBlockStats(int64_t index) const {
+        return metadata_.GetBatchBlockStats(index);
+    }
+
+    int64_t GetBatchRowCount(int64_t index) const {
+        return metadata_.GetBatchMetadata(index).back();
+    }
+
+    void SetBatchOrder(const std::vector<int64_t>& order) {
+        if (static_cast<int64_t>(order.size()) != GetBatchCount()) {
+            throw std::runtime_error("Batch order must list every batch.");
+        }
+        batch_order_ = order;
+    }
+
     Scheme GetScheme() const {
         return metadata_.GetScheme();
     }
+
+    void SetDecodePool(ThreadPool* pool) {
+        decode_pool_ = pool;
+    }
+
+    std::unique_ptr<Column> AcquireColumn(int id) {
+        {
+            std::lock_guard<std::mutex> lock(recycled_mutex_);
+            if (recycled_.empty()) {
+                recycled_.resize(metadata_.GetColumnNum());
+            }
+            if (!recycled_[id].empty()) {
+                std::unique_ptr<Column> column = std::move(recycled_[id].back());
+                recycled_[id].pop_back();
+                return column;
+            }
+        }
+        return CreateColumn(metadata_.GetTypesInfo()[id]);
+    }
+
+    void RecycleBatch(Batch&& batch) {
+        std::lock_guard<std::mutex> lock(recycled_mutex_);
+        if (recycled_.empty()) {
+            recycled_.resize(metadata_.GetColumnNum());
+        }
+        for (size_t i = 0; i < batch.size() && i < recycled_.size(); ++i) {
+            if (batch[i] != nullptr && recycled_[i].size() < kMaxRecycledColumns) {
+                recycled_[i].push_back(std::move(batch[i]));
+            }
+        }
+        batch.clear();
+    }
 protected:
     void InitRowGroup() {
         row_group_.clear();
         for (int64_t curr_type : metadata_.GetTypesInfo()) {
-            switch (curr_type) {
-                case static_cast<int64_t>(Types::TypeInt16):
-                    row_group_.push_back(std::make_unique<Int16>());
-                    break;
-                case static_cast<int64_t>(Types::TypeInt32):
-                    row_group_.push_back(std::make_unique<Int32>());
-                    break;
-                case static_cast<int64_t>(Types::TypeInt64):
-                    row_group_.push_back(std::make_unique<Int64>());
-                    break;
-                case static_cast<int64_t>(Types::TypeString):
-                    row_group_.push_back(std::make_unique<String>());
-                    break;
-                case static_cast<int64_t>(Types::TypeDouble):
-                    row_group_.push_back(std::make_unique<Double>());
-                    break;
-                case static_cast<int64_t>(Types::TypeDate):
-                    row_group_.push_back(std::make_unique<Date>());
-                    break;
-                case static_cast<int64_t>(Types::TypeTimestamp):
-                    row_group_.push_back(std::make_unique<Timestamp>());
-                    break;
-                default:
-                    break;
-            }
+            row_group_.push_back(CreateColumn(curr_type));
         }
     }
 
+    int64_t GetBatchIndex() const {
+        return batch_order_.empty() ? curr_batch : batch_order_[curr_batch];
+    }
+
     std::vector<uint8_t> GetColumnData(int i, const std::vector<int64_t>& column_sizes) {
         int64_t offset = 0;
         for (int j = 0; j < i; ++j) {
@@ -173,9 +336,13 @@ protected:
     }
 protected:
     int curr_batch = 0;
+    std::vector<int64_t> batch_order_;
     std::istream& input_;
     Metadata metadata_;
     std::vector<std::unique_ptr<Column>> row_group_;
+    ThreadPool* decode_pool_ = nullptr;
+    std::mutex recycled_mutex_;
+    std::vector<std::vector<std::unique_ptr<Column>>> recycled_;
 };
 
 RowGroupReader::~RowGroupReader() = default;
@@ -196,10 +363,46 @@ void RowGroupReader::SkipNextBatch() {
     impl_->SkipNextBatch();
 }
 
+Batch RowGroupReader::ReadBatch(int64_t index, const std::vector<int>& ids) {
+    return impl_->ReadBatch(index, ids);
+}
+
+int64_t RowGroupReader::GetNextBatchIndex() const {
+    return impl_->GetNextBatchIndex();
+}
+
+int64_t RowGroupReader::GetBatchCount() const {
+    return impl_->GetBatchCount();
+}
+
+BatchBlockStats RowGroupReader::GetBatchBlockStats(int64_t index) const {
+    return impl_->GetBatchBlockStats(index);
+}
+
+int64_t RowGroupReader::GetBatchRowCount(int64_t index) const {
+    return impl_->GetBatchRowCount(index);
+}
+
+void RowGroupReader::SetBatchOrder(const std::vector<int64_t>& order) {
+    impl_->SetBatchOrder(order);
+}
+
 Scheme RowGroupReader::GetScheme() const {
     return impl_->GetScheme();
 }
 
+void RowGroupReader::SetDecodePool(ThreadPool* pool) {
+    impl_->SetDecodePool(pool);
+}
+
+std::unique_ptr<Column> RowGroupReader::AcquireColumn(int id) {
+    return impl_->AcquireColumn(id);
+}
+
+void RowGroupReader::RecycleBatch(Batch&& batch) {
+    impl_->RecycleBatch(std::move(batch));
+}
+
 Metadata::Metadata(std::istream& input) : impl_(std::make_unique<Impl>(input)) {}
 
 class Metadata::Impl {
@@ -252,6 +455,9 @@ public:
         int64_t stats_blob_size;
         std::memcpy(&stats_blob_size, ptr, sizeof(int64_t));
         ptr += sizeof(int64_t);
+        if (stats_blob_size < 0 || stats_blob_size > end - ptr) {
+            throw std::runtime_error("Corrupted column statistics size.");
+        }
         const uint8_t* stats_end = ptr + stats_blob_size;
         all_batch_block_stats_.reserve(batch_count_);
         for (int64_t batch_idx = 0; batch_idx < batch_count_; ++batch_idx) {
@@ -263,18 +469,18 @@ public:
                     case static_cast<int64_t>(Types::TypeInt16):
                     case static_cast<int64_t>(Types::TypeInt32):
                     case static_cast<int64_t>(Types::TypeInt64):
-                        stats.min_value = ReadStatBytes<int64_t>(ptr);
-                        stats.max_value = ReadStatBytes<int64_t>(ptr);
+                        stats.min_value = ReadStatBytes<int64_t>(ptr, stats_end);
+                        stats.max_value = ReadStatBytes<int64_t>(ptr, stats_end);
                         break;
                     case static_cast<int64_t>(Types::TypeDouble):
-                        stats.min_value = ReadStatBytes<double>(ptr);
-                        stats.max_value = ReadStatBytes<double>(ptr);
+                        stats.min_value = ReadStatBytes<double>(ptr, stats_end);
+                        stats.max_value = ReadStatBytes<double>(ptr, stats_end);
                         break;
                     case static_cast<int64_t>(Types::TypeString):
                     case static_cast<int64_t>(Types::TypeDate):
                     case static_cast<int64_t>(Types::TypeTimestamp):
-                        stats.min_value = ReadStatString(ptr);
-                        stats.max_value = ReadStatString(ptr);
+                        stats.min_value = ReadStatString(ptr, stats_end);
+                        stats.max_value = ReadStatString(ptr, stats_end);
                         break;
                     default:
                         break;
@@ -283,6 +489,32 @@ public:
             }
             all_batch_block_stats_.push_back(std::move(batch_stats));
         }
+        while (stats_end - ptr >= static_cast<std::ptrdiff_t>(kStatsSectionHeaderSize)) {
+            uint32_t magic = ReadStatBytes<uint32_t>(ptr, stats_end);
+            uint32_t version = ReadStatBytes<uint32_t>(ptr, stats_end);
+            int64_t section_size = ReadStatSize(ptr, stats_end);
+            const uint8_t* section_end = ptr + section_size;
+            if (magic == kExtendedStatsMagic && version == kExtendedStatsVersion) {
+                for (auto& batch_stats : all_batch_block_stats_) {
+                    for (int64_t col_idx = 0; col_idx < column_num_; ++col_idx) {
+                        batch_stats[col_idx].extended = ReadExtendedStats(ptr, section_end, types_info_[col_idx]);
+                    }
+                }
+            } else if ((magic == kBloomFilterMagic && version == kBloomFilterVersion) ||
+                       (magic == kNgramIndexMagic && version == kNgramIndexVersion)) {
+                auto member = magic == kBloomFilterMagic ? &ColumnBlockStats::bloom_filter : &ColumnBlockStats::ngram_filter;
+                for (auto& batch_stats : all_batch_block_stats_) {
+                    for (auto& stats : batch_stats) {
+                        int64_t filter_size = ReadStatSize(ptr, section_end);
+                        if (filter_size > 0) {
+                            stats.*member = std::make_shared<const BloomFilter>(BloomFilter::Deserialize(ptr, filter_size));
+                            ptr += filter_size;
+                        }
+                    }
+                }
+            }
+            ptr = section_end;
+        }
         ptr = stats_end;
         while (ptr < end) {
             int64_t string_length;
@@ -2,6 +2,9 @@
 
 #include "../column_types/column_types.h"
 #include "../scheme/scheme.h"
+#include "../thread_pool/thread_pool.h"
+#include "../hyperloglog/hyperloglog.h"
+#include "../bloom_filter/bloom_filter.h"
 
 #include <memory>
 #include <fstream>
@@ -10,22 +13,48 @@
 
 using Batch = std::vector<std::unique_ptr<Column>>;
 
+struct StatsBucket {
+    CellTypes value;
+    int64_t row_count = 0;
+};
+
+struct ExtendedColumnStats {
+    std::optional<CellTypes> sum;
+    std::optional<HyperLogLog> distinct;
+    std::vector<StatsBucket> histogram;
+    std::vector<StatsBucket> top_values;
+};
+
 struct ColumnBlockStats {
     CellTypes min_value;
     CellTypes max_value;
+    std::shared_ptr<const ExtendedColumnStats> extended = nullptr;
+    std::shared_ptr<const BloomFilter> bloom_filter = nullptr;
+    std::shared_ptr<const BloomFilter> ngram_filter = nullptr;
 };
 
 using BatchBlockStats = std::vector<ColumnBlockStats>;
 
+std::unique_ptr<Column> CreateColumn(int64_t type);
+
 
 class RowGroupReader {
 public:
     RowGroupReader(std::istream& input);
     void ReadToCSV(const char* filename);
     std::optional<Batch> ReadNextBatch(const std::vector<int>& ids);
+    Batch ReadBatch(int64_t index, const std::vector<int>& ids);
+    int64_t GetNextBatchIndex() const;
     std::optional<BatchBlockStats> PeekNextBatchBlockStats() const;
     void SkipNextBatch();
+    int64_t GetBatchCount() const;
+    int64_t GetBatchRowCount(int64_t index) const;
+    BatchBlockStats GetBatchBlockStats(int64_t index) const;
+    void SetBatchOrder(const std::vector<int64_t>& order);
     Scheme GetScheme() const;
+    void SetDecodePool(ThreadPool* pool);
+    std::unique_ptr<Column> AcquireColumn(int id);
+    void RecycleBatch(Batch&& batch);
     ~RowGroupReader();
 
 protected:
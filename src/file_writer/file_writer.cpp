@@ -1,22 +1,36 @@
 #include "file_writer.h"
 
 #include "../column_types/column_types.h"
+#include "../file_reader/file_reader.h"
 #include "../utilities/utilities.h"
 
 
+#include <algorithm>
+#include <numeric>
 #include <vector>
 #include <string>
 #include <iostream>
 #include <chrono>
 #include <iomanip>
+#include <limits>
+#include <stdexcept>
 
 static inline constexpr int64_t RowGroupSize = 128 * 1024 * 1024;
 
 namespace {
 
+constexpr uint8_t kStatsSketchPrecision = 10;
+constexpr uint8_t kBloomSizingPrecision = 12;
+constexpr size_t kStatsSampleSize = 4096;
+constexpr size_t kHistogramBuckets = 8;
+constexpr size_t kTopValueCount = 4;
+
 struct ColumnBlockStatsData {
     CellTypes min_value;
     CellTypes max_value;
+    std::optional<ExtendedColumnStats> extended;
+    std::optional<BloomFilter> bloom_filter;
+    std::optional<BloomFilter> ngram_filter;
 };
 
 using BatchBlockStatsData = std::vector<ColumnBlockStatsData>;
@@ -33,42 +47,253 @@ void AppendStatString(std::vector<uint8_t>& output, const std::string& value) {
     output.insert(output.end(), value.begin(), value.end());
 }
 
-ColumnBlockStatsData ComputeColumnBlockStats(const Column* column) {
+void AppendStatValue(std::vector<uint8_t>& output, const CellTypes& value, int64_t type) {
+    switch (type) {
+        case static_cast<int64_t>(Types::TypeInt16):
+        case static_cast<int64_t>(Types::TypeInt32):
+        case static_cast<int64_t>(Types::TypeInt64):
+            AppendStatBytes<int64_t>(output, std::get<int64_t>(value));
+            break;
+        case static_cast<int64_t>(Types::TypeDouble):
+            AppendStatBytes<double>(output, std::get<double>(value));
+            break;
+        case static_cast<int64_t>(Types::TypeString):
+        case static_cast<int64_t>(Types::TypeDate):
+        case static_cast<int64_t>(Types::TypeTimestamp):
+            AppendStatString(output, std::get<std::string>(value));
+            break;
+        default:
+            break;
+    }
+}
+
+void AppendStatBuckets(std::vector<uint8_t>& output, const std::vector<StatsBucket>& buckets, int64_t type) {
+    AppendStatBytes<uint32_t>(output, static_cast<uint32_t>(buckets.size()));
+    for (const auto& bucket : buckets) {
+        AppendStatValue(output, bucket.value, type);
+        AppendStatBytes<int64_t>(output, bucket.row_count);
+    }
+}
+
+template <typename T>
+std::optional<CellTypes> SumIntegers(const std::vector<T>& values) {
+    __int128_t sum = 0;
+    for (T value : values) {
+        sum += value;
+    }
+    if (sum < std::numeric_limits<int64_t>::min() || sum > std::numeric_limits<int64_t>::max()) {
+        return std::nullopt;
+    }
+    return static_cast<int64_t>(sum);
+}
+
+std::optional<CellTypes> ComputeSum(const Column* column) {
+    if (const auto* col = dynamic_cast<const Int16*>(column)) {
+        return SumIntegers(col->GetValues());
+    }
+    if (const auto* col = dynamic_cast<const Int32*>(column)) {
+        return SumIntegers(col->GetValues());
+    }
+    if (const auto* col = dynamic_cast<const Int64*>(column)) {
+        return SumIntegers(col->GetValues());
+    }
+    if (const auto* col = dynamic_cast<const Double*>(column)) {
+        return std::accumulate(col->GetValues().begin(), col->GetValues().end(), 0.0);
+    }
+    return std::nullopt;
+}
+
+std::vector<StatsBucket> BuildHistogram(const std::vector<CellTypes>& sample, int64_t row_count) {
+    std::vector<StatsBucket> histogram;
+    size_t bucket_count = std::min(kHistogramBuckets, sample.size());
+    int64_t covered_rows = 0;
+    for (size_t b = 1; b <= bucket_count; ++b) {
+        size_t end = b * sample.size() / bucket_count;
+        int64_t rows = static_cast<int64_t>(end * row_count / sample.size()) - covered_rows;
+        covered_rows += rows;
+        if (!histogram.empty() && histogram.back().value == sample[end - 1]) {
+            histogram.back().row_count += rows;
+        } else {
+            histogram.push_back(StatsBucket{sample[end - 1], rows});
+        }
+    }
+    return histogram;
+}
+
+std::vector<StatsBucket> FindTopValues(const std::vector<CellTypes>& sample, int64_t row_count) {
+    std::vector<StatsBucket> runs;
+    for (size_t begin = 0; begin < sample.size();) {
+        size_t end = begin + 1;
+        while (end < sample.size() && sample[end] == sample[begin]) {
+            ++end;
+        }
+        if (end - begin > 1) {
+            runs.push_back(StatsBucket{sample[begin], static_cast<int64_t>((end - begin) * row_count / sample.size())});
+        }
+        begin = end;
+    }
+    size_t top_count = std::min(kTopValueCount, runs.size());
+    std::partial_sort(runs.begin(), runs.begin() + top_count, runs.end(), [](const StatsBucket& a, const StatsBucket& b) {
+        return a.row_count > b.row_count;
+    });
+    runs.resize(top_count);
+    return runs;
+}
+
+ExtendedColumnStats ComputeExtendedStats(const Column* column, std::vector<uint64_t>& hashes) {
+    ExtendedColumnStats stats;
+    stats.sum = ComputeSum(column);
+    HyperLogLog sketch(kStatsSketchPrecision);
+    column->ComputeHashes(hashes);
+    sketch.AddHashes(hashes);
+    stats.distinct = std::move(sketch);
+    int64_t row_count = column->GetRowCount();
+    int64_t step = std::max<int64_t>(1, row_count / kStatsSampleSize);
+    std::vector<CellTypes> sample;
+    sample.reserve(row_count / step + 1);
+    for (int64_t r = 0; r < row_count; r += step) {
+        sample.push_back(column->Get(r));
+    }
+    std::sort(sample.begin(), sample.end());
+    stats.histogram = BuildHistogram(sample, row_count);
+    stats.top_values = FindTopValues(sample, row_count);
+    return stats;
+}
+
+BloomFilter BuildBloomFilter(const Column* column, double false_positive_rate, std::vector<uint64_t>& hashes) {
+    column->ComputeHashes(hashes);
+    HyperLogLog sketch(kBloomSizingPrecision);
+    sketch.AddHashes(hashes);
+    BloomFilter filter(sketch.Estimate(), false_positive_rate);
+    filter.InsertHashes(hashes);
+    return filter;
+}
+
+BloomFilter BuildNgramFilter(const Column* column, double false_positive_rate, std::vector<uint64_t>& hashes) {
+    const auto& values = dynamic_cast<const String&>(*column).GetValues();
+    HyperLogLog sketch(kBloomSizingPrecision);
+    for (const std::string& value : values) {
+        hashes.clear();
+        AppendNgramHashes(value, hashes);
+        sketch.AddHashes(hashes);
+    }
+    BloomFilter filter(sketch.Estimate(), false_positive_rate);
+    for (const std::string& value : values) {
+        hashes.clear();
+        AppendNgramHashes(value, hashes);
+        filter.InsertHashes(hashes);
+    }
+    return filter;
+}
+
+ColumnBlockStatsData ComputeColumnBlockStats(
+    const Column* column,
+    bool with_extended,
+    std::optional<double> bloom_false_positive_rate,
+    std::optional<double> ngram_false_positive_rate,
+    std::vector<uint64_t>& hashes
+) {
     ColumnBlockStatsData stats;
     stats.min_value = column->GetMin();
     stats.max_value = column->GetMax();
+    if (with_extended) {
+        stats.extended = ComputeExtendedStats(column, hashes);
+    }
+    if (bloom_false_positive_rate.has_value()) {
+        stats.bloom_filter = BuildBloomFilter(column, bloom_false_positive_rate.value(), hashes);
+    }
+    if (ngram_false_positive_rate.has_value()) {
+        stats.ngram_filter = BuildNgramFilter(column, ngram_false_positive_rate.value(), hashes);
+    }
     return stats;
 }
 
+void AppendStatsSection(std::vector<uint8_t>& output, uint32_t magic, uint32_t version, const std::vector<uint8_t>& payload) {
+    AppendStatBytes<uint32_t>(output, magic);
+    AppendStatBytes<uint32_t>(output, version);
+    AppendStatBytes<int64_t>(output, static_cast<int64_t>(payload.size()));
+    output.insert(output.end(), payload.begin(), payload.end());
+}
+
+void AppendFilterSection(
+    std::vector<uint8_t>& output,
+    uint32_t magic,
+    uint32_t version,
+    const std::vector<BatchBlockStatsData>& all_batch_block_stats,
+    std::optional<BloomFilter> ColumnBlockStatsData::*member
+) {
+    std::vector<uint8_t> payload;
+    for (const auto& batch_stats : all_batch_block_stats) {
+        for (const auto& stats : batch_stats) {
+            const std::optional<BloomFilter>& bloom_filter = stats.*member;
+            std::vector<uint8_t> filter = bloom_filter.has_value() ? bloom_filter->Serialize() : std::vector<uint8_t>();
+            AppendStatBytes<int64_t>(payload, static_cast<int64_t>(filter.size()));
+            payload.insert(payload.end(), filter.begin(), filter.end());
+        }
+    }
+    AppendStatsSection(output, magic, version, payload);
+}
+
+void AppendExtendedStats(std::vector<uint8_t>& output, const std::optional<ExtendedColumnStats>& stats, int64_t type) {
+    uint8_t fields = 0;
+    if (stats.has_value()) {
+        fields |= stats->sum.has_value() ? static_cast<uint8_t>(ExtendedStatsField::Sum) : 0;
+        fields |= stats->distinct.has_value() ? static_cast<uint8_t>(ExtendedStatsField::Distinct) : 0;
+        fields |= !stats->histogram.empty() ? static_cast<uint8_t>(ExtendedStatsField::Histogram) : 0;
+        fields |= !stats->top_values.empty() ? static_cast<uint8_t>(ExtendedStatsField::TopValues) : 0;
+    }
+    AppendStatBytes<uint8_t>(output, fields);
+    if (fields & static_cast<uint8_t>(ExtendedStatsField::Sum)) {
+        if (std::holds_alternative<double>(stats->sum.value())) {
+            AppendStatBytes<double>(output, std::get<double>(stats->sum.value()));
+        } else {
+            AppendStatBytes<int64_t>(output, std::get<int64_t>(stats->sum.value()));
+        }
+    }
+    if (fields & static_cast<uint8_t>(ExtendedStatsField::Distinct)) {
+        std::vector<uint8_t> sketch = stats->distinct->Serialize();
+        AppendStatBytes<int64_t>(output, static_cast<int64_t>(sketch.size()));
+        output.insert(output.end(), sketch.begin(), sketch.end());
+    }
+    if (fields & static_cast<uint8_t>(ExtendedStatsField::Histogram)) {
+        AppendStatBuckets(output, stats->histogram, type);
+    }
+    if (fields & static_cast<uint8_t>(ExtendedStatsField::TopValues)) {
+        AppendStatBuckets(output, stats->top_values, type);
+    }
+}
+
 std::vector<uint8_t> SerializeBatchBlockStats(
     const std::vector<BatchBlockStatsData>& all_batch_block_stats,
     const std::vector<int64_t>& types
 ) {
     std::vector<uint8_t> output;
+    bool has_extended = false;
+    bool has_bloom_filters = false;
+    bool has_ngram_filters = false;
     for (const auto& batch_stats : all_batch_block_stats) {
         for (size_t i = 0; i < batch_stats.size(); ++i) {
-            const auto& stats = batch_stats[i];
-            switch (types[i]) {
-                case static_cast<int64_t>(Types::TypeInt16):
-                case static_cast<int64_t>(Types::TypeInt32):
-                case static_cast<int64_t>(Types::TypeInt64):
-                    AppendStatBytes<int64_t>(output, std::get<int64_t>(stats.min_value));
-                    AppendStatBytes<int64_t>(output, std::get<int64_t>(stats.max_value));
-                    break;
-                case static_cast<int64_t>(Types::TypeDouble):
-                    AppendStatBytes<double>(output, std::get<double>(stats.min_value));
-                    AppendStatBytes<double>(output, std::get<double>(stats.max_value));
-                    break;
-                case static_cast<int64_t>(Types::TypeString):
-                case static_cast<int64_t>(Types::TypeDate):
-                case static_cast<int64_t>(Types::TypeTimestamp):
-                    AppendStatString(output, std::get<std::string>(stats.min_value));
-                    AppendStatString(output, std::get<std::string>(stats.max_value));
-                    break;
-                default:
-                    break;
+            AppendStatValue(output, batch_stats[i].min_value, types[i]);
+            AppendStatValue(output, batch_stats[i].max_value, types[i]);
+            has_extended = has_extended || batch_stats[i].extended.has_value();
+            has_bloom_filters = has_bloom_filters || batch_stats[i].bloom_filter.has_value();
+            has_ngram_filters = has_ngram_filters || batch_stats[i].ngram_filter.has_value();
+        }
+    }
+    if (has_extended) {
+        std::vector<uint8_t> payload;
+        for (const auto& batch_stats : all_batch_block_stats) {
+            for (size_t i = 0; i < batch_stats.size(); ++i) {
+                AppendExtendedStats(payload, batch_stats[i].extended, types[i]);
             }
         }
+        AppendStatsSection(output, kExtendedStatsMagic, kExtendedStatsVersion, payload);
+    }
+    if (has_bloom_filters) {
+        AppendFilterSection(output, kBloomFilterMagic, kBloomFilterVersion, all_batch_block_stats, &ColumnBlockStatsData::bloom_filter);
+    }
+    if (has_ngram_filters) {
+        AppendFilterSection(output, kNgramIndexMagic, kNgramIndexVersion, all_batch_block_stats, &ColumnBlockStatsData::ngram_filter);
     }
     return output;
 }
@@ -84,6 +309,8 @@ public:
         csv_reader_ = std::move(reader);
         column_num_ = csv_reader_.GetColumnNum();
         types_ = scheme.GetTypesInfo();
+        bloom_false_positive_rates_.resize(column_num_);
+        ngram_false_positive_rates_.resize(column_num_);
         for (int64_t i = 0; i < column_num_; ++i) {
             switch (types_[i]) {
                 case static_cast<int64_t>(Types::TypeInt16):
@@ -119,6 +346,40 @@ public:
         progress_logging_enabled_ = enabled;
     }
 
+    void SetRowGroupSize(int64_t bytes) {
+        if (bytes <= 0) {
+            throw std::runtime_error("Row group size must be positive.");
+        }
+        row_group_size_ = bytes;
+    }
+
+    void SetExtendedStats(bool enabled) {
+        extended_stats_enabled_ = enabled;
+    }
+
+    void SetBloomFilter(const std::string& column, double false_positive_rate) {
+        int64_t column_id = scheme_.GetColumnIndex(column);
+        if (types_[column_id] == static_cast<int64_t>(Types::TypeDate) ||
+            types_[column_id] == static_cast<int64_t>(Types::TypeTimestamp)) {
+            throw std::runtime_error("Bloom filters are not supported for date and time columns.");
+        }
+        if (false_positive_rate <= 0.0 || false_positive_rate >= 1.0) {
+            throw std::runtime_error("Bloom filter false positive rate must be between 0 and 1.");
+        }
+        bloom_false_positive_rates_[column_id] = false_positive_rate;
+    }
+
+    void SetNgramIndex(const std::string& column, double false_positive_rate) {
+        int64_t column_id = scheme_.GetColumnIndex(column);
+        if (types_[column_id] != static_cast<int64_t>(Types::TypeString)) {
+            throw std::runtime_error("N-gram indexes are only supported for string columns.");
+        }
+        if (false_positive_rate <= 0.0 || false_positive_rate >= 1.0) {
+            throw std::runtime_error("N-gram index false positive rate must be between 0 and 1.");
+        }
+        ngram_false_positive_rates_[column_id] = false_positive_rate;
+    }
+
     void WriteAll() {
         std::vector<int64_t> file_metadata;
         std::vector<int64_t> batch_start_pos;
@@ -179,7 +440,7 @@ protected:
         int64_t group_capacity = 0;
         int64_t row_count = 0;
         std::vector<std::vector<std::string>> str_batch(column_num_);
-        while (group_capacity <= RowGroupSize && !csv_reader_.IsEnd()) {
+        while (group_capacity <= row_group_size_ && !csv_reader_.IsEnd()) {
             std::vector<std::string> row = csv_reader_.GetNextLineAndSplitIntoTokens();
             if (row.size() == 0) {
                 break;
@@ -218,7 +479,9 @@ protected:
         BatchBlockStatsData batch_stats;
         batch_stats.reserve(column_num_);
         for (int64_t i = 0; i < column_num_; ++i) {
-            batch_stats.push_back(ComputeColumnBlockStats(row_group_[i].get()));
+            batch_stats.push_back(ComputeColumnBlockStats(
+                row_group_[i].get(), extended_stats_enabled_, bloom_false_positive_rates_[i],
+                ngram_false_positive_rates_[i], hashes_));
         }
         std::vector<int64_t> encoded_sizes;
         int64_t encoded_group_size = 0;
@@ -249,7 +512,12 @@ protected:
     std::vector<int64_t> all_batch_metadata_;
     std::vector<BatchBlockStatsData> all_batch_block_stats_;
     std::vector<int64_t> types_;
+    int64_t row_group_size_ = RowGroupSize;
     bool progress_logging_enabled_ = false;
+    bool extended_stats_enabled_ = false;
+    std::vector<std::optional<double>> bloom_false_positive_rates_;
+    std::vector<std::optional<double>> ngram_false_positive_rates_;
+    std::vector<uint64_t> hashes_;
 
 };
 
@@ -257,6 +525,22 @@ void RowGroupWriter::SetProgressLogging(bool enabled) {
     impl_->SetProgressLogging(enabled);
 }
 
+void RowGroupWriter::SetRowGroupSize(int64_t bytes) {
+    impl_->SetRowGroupSize(bytes);
+}
+
+void RowGroupWriter::SetExtendedStats(bool enabled) {
+    impl_->SetExtendedStats(enabled);
+}
+
+void RowGroupWriter::SetBloomFilter(const std::string& column, double false_positive_rate) {
+    impl_->SetBloomFilter(column, false_positive_rate);
+}
+
+void RowGroupWriter::SetNgramIndex(const std::string& column, double false_positive_rate) {
+    impl_->SetNgramIndex(column, false_positive_rate);
+}
+
 void RowGroupWriter::WriteAll() {
     impl_->WriteAll();
 }
@@ -2,8 +2,10 @@
 
 #include "../csv_wrapper/csv_wrapper.h"
 #include "../scheme/scheme.h"
+#include "../bloom_filter/bloom_filter.h"
 
 #include <memory>
+#include <string>
 #include <ostream>
 #include <istream>
 
@@ -11,6 +13,10 @@ class RowGroupWriter {
 public:
     RowGroupWriter(CSVWrapper&& reader, std::ostream& output, Scheme& scheme);
     void SetProgressLogging(bool enabled);
+    void SetRowGroupSize(int64_t bytes);
+    void SetExtendedStats(bool enabled);
+    void SetBloomFilter(const std::string& column, double false_positive_rate = BloomFilter::kDefaultFalsePositiveRate);
+    void SetNgramIndex(const std::string& column, double false_positive_rate = BloomFilter::kDefaultFalsePositiveRate);
     void WriteAll();
     ~RowGroupWriter();
 protected:
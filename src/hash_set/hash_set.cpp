@@ -0,0 +1,347 @@
+#include "hash_set.h"
+
+#include "../utilities/utilities.h"
+
+#include <cstring>
+
+namespace {
+
+constexpr size_t kInitialCapacity = 16;
+constexpr size_t kPrefetchBlock = 16;
+
+size_t GetCapacityFor(size_t count) {
+    size_t capacity = kInitialCapacity;
+    while (capacity < count * 2) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+} // namespace
+
+FlatInt64Set::FlatInt64Set(std::pmr::memory_resource* resource)
+    : slots_(kInitialCapacity, kEmpty, resource), mask_(kInitialCapacity - 1) {}
+
+bool FlatInt64Set::Insert(int64_t value) {
+    Reserve(size_ + 1);
+    return InsertHashed(value, HashInt64(value));
+}
+
+void FlatInt64Set::InsertBatch(const int64_t* values, size_t count) {
+    uint64_t hashes[kPrefetchBlock];
+    for (size_t i = 0; i < count; i += kPrefetchBlock) {
+        size_t block = std::min(kPrefetchBlock, count - i);
+        Reserve(size_ + block);
+        for (size_t j = 0; j < block; ++j) {
+            hashes[j] = HashInt64(values[i + j]);
+            __builtin_prefetch(&slots_[hashes[j] & mask_]);
+        }
+        for (size_t j = 0; j < block; ++j) {
+            InsertHashed(values[i + j], hashes[j]);
+        }
+    }
+}
+
+bool FlatInt64Set::Contains(int64_t value) const {
+    if (value == kEmpty) {
+        return has_empty_marker_;
+    }
+    uint64_t pos = HashInt64(value) & mask_;
+    while (slots_[pos] != kEmpty) {
+        if (slots_[pos] == value) {
+            return true;
+        }
+        pos = (pos + 1) & mask_;
+    }
+    return false;
+}
+
+bool FlatInt64Set::InsertHashed(int64_t value, uint64_t hash) {
+    if (value == kEmpty) {
+        bool is_new = !has_empty_marker_;
+        has_empty_marker_ = true;
+        return is_new;
+    }
+    uint64_t pos = hash & mask_;
+    while (slots_[pos] != kEmpty) {
+        if (slots_[pos] == value) {
+            return false;
+        }
+        pos = (pos + 1) & mask_;
+    }
+    slots_[pos] = value;
+    ++size_;
+    return true;
+}
+
+void FlatInt64Set::Reserve(size_t count) {
+    if (count * 2 <= slots_.size()) {
+        return;
+    }
+    size_t capacity = GetCapacityFor(count);
+    std::pmr::vector<int64_t> old_slots(capacity, kEmpty, slots_.get_allocator());
+    old_slots.swap(slots_);
+    mask_ = capacity - 1;
+    size_ = 0;
+    for (int64_t value : old_slots) {
+        if (value != kEmpty) {
+            InsertHashed(value, HashInt64(value));
+        }
+    }
+}
+
+FlatPairSet::FlatPairSet(std::pmr::memory_resource* resource)
+    : slots_(kInitialCapacity, resource), mask_(kInitialCapacity - 1) {}
+
+bool FlatPairSet::Insert(int64_t first, int64_t second) {
+    Reserve(size_ + 1);
+    return InsertHashed(first, second, HashCombine(HashInt64(first), HashInt64(second)));
+}
+
+bool FlatPairSet::InsertHashed(int64_t first, int64_t second, uint64_t hash) {
+    uint64_t pos = hash & mask_;
+    while (slots_[pos].first != kEmpty) {
+        if (slots_[pos].first == first && slots_[pos].second == second) {
+            return false;
+        }
+        pos = (pos + 1) & mask_;
+    }
+    slots_[pos] = Slot{first, second};
+    ++size_;
+    return true;
+}
+
+void FlatPairSet::Reserve(size_t count) {
+    if (count * 2 <= slots_.size()) {
+        return;
+    }
+    size_t capacity = GetCapacityFor(count);
+    std::pmr::vector<Slot> old_slots(capacity, slots_.get_allocator());
+    old_slots.swap(slots_);
+    mask_ = capacity - 1;
+    size_ = 0;
+    for (const Slot& slot : old_slots) {
+        if (slot.first != kEmpty) {
+            InsertHashed(slot.first, slot.second, HashCombine(HashInt64(slot.first), HashInt64(slot.second)));
+        }
+    }
+}
+
+bool ChunkedBitmap::Insert(uint64_t value) {
+    uint64_t high = value >> 16;
+    uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+    if (high >= containers_.size()) {
+        containers_.resize(high + 1);
+    }
+    Container& container = containers_[high];
+    if (!container.bits.empty()) {
+        uint64_t& word = container.bits[low >> 6];
+        uint64_t bit = uint64_t{1} << (low & 63);
+        if ((word & bit) != 0) {
+            return false;
+        }
+        word |= bit;
+        ++size_;
+        return true;
+    }
+    auto it = std::lower_bound(container.array.begin(), container.array.end(), low);
+    if (it != container.array.end() && *it == low) {
+        return false;
+    }
+    if (container.array.size() < kMaxArraySize) {
+        container.array.insert(it, low);
+    } else {
+        container.bits.assign(1 << 10, 0);
+        for (uint16_t existing : container.array) {
+            container.bits[existing >> 6] |= uint64_t{1} << (existing & 63);
+        }
+        container.bits[low >> 6] |= uint64_t{1} << (low & 63);
+        container.array.clear();
+        container.array.shrink_to_fit();
+    }
+    ++size_;
+    return true;
+}
+
+void Int64DistinctSet::Merge(const Int64DistinctSet& other) {
+    std::vector<int64_t> values;
+    values.reserve(other.Size());
+    if (other.mode_ == Mode::Bitmap) {
+        other.bitmap_.ForEach([&](uint64_t offset) {
+            values.push_back(static_cast<int64_t>(static_cast<uint64_t>(other.bitmap_base_) + offset));
+        });
+    } else {
+        other.hash_set_.ForEach([&](int64_t value) { values.push_back(value); });
+    }
+    InsertBatch(values.data(), values.size());
+}
+
+uint64_t Int64DistinctSet::Size() const {
+    return mode_ == Mode::Bitmap ? bitmap_.Size() : hash_set_.Size();
+}
+
+void Int64DistinctSet::InsertChunk(const int64_t* values, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    if (mode_ == Mode::Undecided) {
+        auto [min_it, max_it] = std::minmax_element(values, values + count);
+        uint64_t span = static_cast<uint64_t>(*max_it) - static_cast<uint64_t>(*min_it);
+        if (span < kMaxBitmapSpan && span <= count * kDensityFactor) {
+            mode_ = Mode::Bitmap;
+            bitmap_base_ = *min_it;
+        } else {
+            mode_ = Mode::HashSet;
+        }
+    }
+    if (mode_ == Mode::Bitmap) {
+        size_t i = 0;
+        for (; i < count; ++i) {
+            if (values[i] < bitmap_base_) {
+                break;
+            }
+            uint64_t offset = static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(bitmap_base_);
+            if (offset >= kMaxBitmapSpan) {
+                break;
+            }
+            bitmap_.Insert(offset);
+        }
+        if (i == count) {
+            return;
+        }
+        MigrateToHashSet();
+        values += i;
+        count -= i;
+    }
+    hash_set_.InsertBatch(values, count);
+}
+
+void Int64DistinctSet::MigrateToHashSet() {
+    bitmap_.ForEach([this](uint64_t offset) {
+        hash_set_.Insert(static_cast<int64_t>(static_cast<uint64_t>(bitmap_base_) + offset));
+    });
+    bitmap_ = ChunkedBitmap();
+    mode_ = Mode::HashSet;
+}
+
+StringHashSet::StringHashSet(std::pmr::memory_resource* resource)
+    : slots_(kInitialCapacity, resource), mask_(kInitialCapacity - 1) {}
+
+bool StringHashSet::Insert(std::string_view value) {
+    Reserve(size_ + 1);
+    return InsertHashed(value, HashString(value));
+}
+
+void StringHashSet::InsertBatch(const std::string* values, size_t count) {
+    uint64_t hashes[kPrefetchBlock];
+    for (size_t i = 0; i < count; i += kPrefetchBlock) {
+        size_t block = std::min(kPrefetchBlock, count - i);
+        Reserve(size_ + block);
+        for (size_t j = 0; j < block; ++j) {
+            hashes[j] = HashString(values[i + j]);
+            __builtin_prefetch(&slots_[hashes[j] & mask_]);
+        }
+        for (size_t j = 0; j < block; ++j) {
+            InsertHashed(values[i + j], hashes[j]);
+        }
+    }
+}
+
+void StringHashSet::InsertMasked(const std::string* values, const std::vector<uint64_t>& mask) {
+    uint64_t hashes[kPrefetchBlock];
+    for (size_t i = 0; i < mask.size(); i += kPrefetchBlock) {
+        size_t block = std::min(kPrefetchBlock, mask.size() - i);
+        Reserve(size_ + block);
+        for (size_t j = 0; j < block; ++j) {
+            hashes[j] = HashString(values[mask[i + j]]);
+            __builtin_prefetch(&slots_[hashes[j] & mask_]);
+        }
+        for (size_t j = 0; j < block; ++j) {
+            InsertHashed(values[mask[i + j]], hashes[j]);
+        }
+    }
+}
+
+bool StringHashSet::InsertHashed(std::string_view value, uint64_t hash) {
+    uint64_t size_before = size_;
+    FindOrInsertHashed(value, hash);
+    return size_ != size_before;
+}
+
+bool StringHashSet::Contains(std::string_view value) const {
+    uint64_t hash = HashString(value);
+    uint64_t pos = hash & mask_;
+    while (slots_[pos].data != nullptr) {
+        const Entry& entry = slots_[pos];
+        if (entry.hash == hash && entry.size == value.size() && std::memcmp(entry.data, value.data(), value.size()) == 0) {
+            return true;
+        }
+        pos = (pos + 1) & mask_;
+    }
+    return false;
+}
+
+uint64_t StringHashSet::GetOrInsert(std::string_view value) {
+    Reserve(size_ + 1);
+    return FindOrInsertHashed(value, HashString(value));
+}
+
+uint64_t StringHashSet::FindOrInsertHashed(std::string_view value, uint64_t hash) {
+    uint64_t pos = hash & mask_;
+    while (slots_[pos].data != nullptr) {
+        const Entry& entry = slots_[pos];
+        if (entry.hash == hash && entry.size == value.size() && std::memcmp(entry.data, value.data(), value.size()) == 0) {
+            return entry.id;
+        }
+        pos = (pos + 1) & mask_;
+    }
+    slots_[pos] = Entry{hash, CopyToArena(value), value.size(), size_};
+    return size_++;
+}
+
+const char* StringHashSet::CopyToArena(std::string_view value) {
+    static const char kEmptyString[] = "";
+    if (value.empty()) {
+        return kEmptyString;
+    }
+    if (value.size() > kArenaBlockSize) {
+        arena_blocks_.push_back(AllocateArenaBlock(value.size()));
+        arena_used_ = kArenaBlockSize;
+        std::memcpy(arena_blocks_.back().get(), value.data(), value.size());
+        return arena_blocks_.back().get();
+    }
+    if (value.size() > kArenaBlockSize - arena_used_) {
+        arena_blocks_.push_back(AllocateArenaBlock(kArenaBlockSize));
+        arena_used_ = 0;
+    }
+    char* data = arena_blocks_.back().get() + arena_used_;
+    std::memcpy(data, value.data(), value.size());
+    arena_used_ += value.size();
+    return data;
+}
+
+std::unique_ptr<char, StringHashSet::ArenaBlockDeleter> StringHashSet::AllocateArenaBlock(size_t size) {
+    std::pmr::memory_resource* resource = slots_.get_allocator().resource();
+    char* data = static_cast<char*>(resource->allocate(size, 1));
+    return std::unique_ptr<char, ArenaBlockDeleter>(data, ArenaBlockDeleter{resource, size});
+}
+
+void StringHashSet::Reserve(size_t count) {
+    if (count * 2 <= slots_.size()) {
+        return;
+    }
+    size_t capacity = GetCapacityFor(count);
+    std::pmr::vector<Entry> old_slots(capacity, slots_.get_allocator());
+    old_slots.swap(slots_);
+    mask_ = capacity - 1;
+    for (const Entry& entry : old_slots) {
+        if (entry.data == nullptr) {
+            continue;
+        }
+        uint64_t pos = entry.hash & mask_;
+        while (slots_[pos].data != nullptr) {
+            pos = (pos + 1) & mask_;
+        }
+        slots_[pos] = entry;
+    }
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class FlatInt64Set {
+public:
+    explicit FlatInt64Set(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    bool Insert(int64_t value);
+    void InsertBatch(const int64_t* values, size_t count);
+    bool Contains(int64_t value) const;
+    uint64_t Size() const { return size_ + (has_empty_marker_ ? 1 : 0); }
+    template <typename Fn>
+    void ForEach(Fn&& fn) const {
+        for (int64_t slot : slots_) {
+            if (slot != kEmpty) {
+                fn(slot);
+            }
+        }
+        if (has_empty_marker_) {
+            fn(kEmpty);
+        }
+    }
+
+protected:
+    static constexpr int64_t kEmpty = INT64_MIN;
+
+    bool InsertHashed(int64_t value, uint64_t hash);
+    void Reserve(size_t count);
+
+    std::pmr::vector<int64_t> slots_;
+    uint64_t mask_;
+    uint64_t size_ = 0;
+    bool has_empty_marker_ = false;
+};
+
+class FlatPairSet {
+public:
+    explicit FlatPairSet(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    bool Insert(int64_t first, int64_t second);
+    uint64_t Size() const { return size_; }
+    template <typename Fn>
+    void ForEach(Fn&& fn) const {
+        for (const Slot& slot : slots_) {
+            if (slot.first != kEmpty) {
+                fn(slot.first, slot.second);
+            }
+        }
+    }
+
+protected:
+    static constexpr int64_t kEmpty = INT64_MIN;
+
+    struct Slot {
+        int64_t first = kEmpty;
+        int64_t second = 0;
+    };
+
+    bool InsertHashed(int64_t first, int64_t second, uint64_t hash);
+    void Reserve(size_t count);
+
+    std::pmr::vector<Slot> slots_;
+    uint64_t mask_;
+    uint64_t size_ = 0;
+};
+
+class ChunkedBitmap {
+public:
+    bool Insert(uint64_t value);
+    uint64_t Size() const { return size_; }
+    template <typename Fn>
+    void ForEach(Fn&& fn) const {
+        for (uint64_t high = 0; high < containers_.size(); ++high) {
+            const Container& container = containers_[high];
+            for (uint16_t low : container.array) {
+                fn((high << 16) | low);
+            }
+            for (uint64_t word = 0; word < container.bits.size(); ++word) {
+                uint64_t bits = container.bits[word];
+                while (bits != 0) {
+                    uint64_t bit = __builtin_ctzll(bits);
+                    fn((high << 16) | (word << 6) | bit);
+                    bits &= bits - 1;
+                }
+            }
+        }
+    }
+
+protected:
+    static constexpr size_t kMaxArraySize = 4096;
+
+    struct Container {
+        std::vector<uint16_t> array;
+        std::vector<uint64_t> bits;
+    };
+
+    std::vector<Container> containers_;
+    uint64_t size_ = 0;
+};
+
+class Int64DistinctSet {
+public:
+    template <typename T>
+    void InsertBatch(const T* values, size_t count) {
+        int64_t buffer[kChunkSize];
+        for (size_t i = 0; i < count; i += kChunkSize) {
+            size_t chunk = std::min(kChunkSize, count - i);
+            for (size_t j = 0; j < chunk; ++j) {
+                buffer[j] = static_cast<int64_t>(values[i + j]);
+            }
+            InsertChunk(buffer, chunk);
+        }
+    }
+    template <typename T>
+    void InsertMasked(const T* values, const std::vector<uint64_t>& mask) {
+        int64_t buffer[kChunkSize];
+        for (size_t i = 0; i < mask.size(); i += kChunkSize) {
+            size_t chunk = std::min(kChunkSize, mask.size() - i);
+            for (size_t j = 0; j < chunk; ++j) {
+                buffer[j] = static_cast<int64_t>(values[mask[i + j]]);
+            }
+            InsertChunk(buffer, chunk);
+        }
+    }
+    void Merge(const Int64DistinctSet& other);
+    uint64_t Size() const;
+    bool IsBitmap() const { return mode_ == Mode::Bitmap; }
+
+protected:
+    static constexpr size_t kChunkSize = 256;
+    static constexpr uint64_t kMaxBitmapSpan = uint64_t{1} << 32;
+    static constexpr uint64_t kDensityFactor = 64;
+
+    enum class Mode { Undecided, Bitmap, HashSet };
+
+    void InsertChunk(const int64_t* values, size_t count);
+    void MigrateToHashSet();
+
+    Mode mode_ = Mode::Undecided;
+    int64_t bitmap_base_ = 0;
+    ChunkedBitmap bitmap_;
+    FlatInt64Set hash_set_;
+};
+
+class StringHashSet {
+public:
+    explicit StringHashSet(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    bool Insert(std::string_view value);
+    uint64_t GetOrInsert(std::string_view value);
+    void InsertBatch(const std::string* values, size_t count);
+    void InsertMasked(const std::string* values, const std::vector<uint64_t>& mask);
+    bool Contains(std::string_view value) const;
+    uint64_t Size() const { return size_; }
+    template <typename Fn>
+    void ForEach(Fn&& fn) const {
+        for (const Entry& entry : slots_) {
+            if (entry.data != nullptr) {
+                fn(std::string_view(entry.data, entry.size), entry.id);
+            }
+        }
+    }
+
+protected:
+    static constexpr size_t kArenaBlockSize = 1 << 20;
+
+    struct ArenaBlockDeleter {
+        std::pmr::memory_resource* resource;
+        size_t size;
+        void operator()(char* data) const { resource->deallocate(data, size); }
+    };
+
+    struct Entry {
+        uint64_t hash = 0;
+        const char* data = nullptr;
+        uint64_t size = 0;
+        uint64_t id = 0;
+    };
+
+    bool InsertHashed(std::string_view value, uint64_t hash);
+    uint64_t FindOrInsertHashed(std::string_view value, uint64_t hash);
+    const char* CopyToArena(std::string_view value);
+    std::unique_ptr<char, ArenaBlockDeleter> AllocateArenaBlock(size_t size);
+    void Reserve(size_t count);
+
+    std::pmr::vector<Entry> slots_;
+    uint64_t mask_;
+    uint64_t size_ = 0;
+    std::vector<std::unique_ptr<char, ArenaBlockDeleter>> arena_blocks_;
+    size_t arena_used_ = kArenaBlockSize;
+};
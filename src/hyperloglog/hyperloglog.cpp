@@ -0,0 +1,170 @@
+#include "hyperloglog.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+double Tau(double x) {
+    if (x == 0.0 || x == 1.0) {
+        return 0.0;
+    }
+    double y = 1.0;
+    double z = 1.0 - x;
+    double z_prev;
+    do {
+        x = std::sqrt(x);
+        z_prev = z;
+        y *= 0.5;
+        z -= (1.0 - x) * (1.0 - x) * y;
+    } while (z_prev != z);
+    return z / 3.0;
+}
+
+double Sigma(double x) {
+    if (x == 1.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    double y = 1.0;
+    double z = x;
+    double z_prev;
+    do {
+        x *= x;
+        z_prev = z;
+        z += x * y;
+        y += y;
+    } while (z_prev != z);
+    return z;
+}
+
+} // namespace
+
+HyperLogLog::HyperLogLog(uint8_t precision) : precision_(precision) {
+    if (precision_ < kMinPrecision || precision_ > kMaxPrecision) {
+        throw std::runtime_error("HyperLogLog precision must be between 4 and 18.");
+    }
+    sparse_limit_ = (size_t{1} << precision_) / sizeof(uint64_t);
+}
+
+void HyperLogLog::Add(uint64_t hash) {
+    if (!IsSparse()) {
+        AddToRegisters(hash);
+        return;
+    }
+    sparse_hashes_.push_back(hash);
+    if (sparse_hashes_.size() >= 2 * sparse_limit_) {
+        CompactSparse();
+        if (sparse_hashes_.size() > sparse_limit_) {
+            ConvertToDense();
+        }
+    }
+}
+
+void HyperLogLog::AddHashes(const std::vector<uint64_t>& hashes) {
+    for (uint64_t hash : hashes) {
+        Add(hash);
+    }
+}
+
+void HyperLogLog::Merge(const HyperLogLog& other) {
+    if (precision_ != other.precision_) {
+        throw std::runtime_error("Cannot merge HyperLogLog sketches with different precision.");
+    }
+    if (other.IsSparse()) {
+        for (uint64_t hash : other.sparse_hashes_) {
+            Add(hash);
+        }
+        return;
+    }
+    if (IsSparse()) {
+        ConvertToDense();
+    }
+    for (size_t i = 0; i < registers_.size(); ++i) {
+        registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+}
+
+uint64_t HyperLogLog::Estimate() const {
+    if (IsSparse()) {
+        std::vector<uint64_t> hashes = sparse_hashes_;
+        std::sort(hashes.begin(), hashes.end());
+        return std::unique(hashes.begin(), hashes.end()) - hashes.begin();
+    }
+    const int q = 64 - precision_;
+    const double m = static_cast<double>(registers_.size());
+    std::vector<int64_t> histogram(q + 2, 0);
+    for (uint8_t value : registers_) {
+        ++histogram[value];
+    }
+    double z = m * Tau(1.0 - histogram[q + 1] / m);
+    for (int k = q; k >= 1; --k) {
+        z = 0.5 * (z + histogram[k]);
+    }
+    z += m * Sigma(histogram[0] / m);
+    const double alpha = 0.5 / std::log(2.0);
+    return static_cast<uint64_t>(std::llround(alpha * m * m / z));
+}
+
+std::vector<uint8_t> HyperLogLog::Serialize() const {
+    if (!IsSparse()) {
+        std::vector<uint8_t> result(2 + registers_.size());
+        result[0] = precision_;
+        result[1] = 0;
+        std::memcpy(result.data() + 2, registers_.data(), registers_.size());
+        return result;
+    }
+    std::vector<uint64_t> hashes = sparse_hashes_;
+    std::sort(hashes.begin(), hashes.end());
+    hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+    std::vector<uint8_t> result(2 + hashes.size() * sizeof(uint64_t));
+    result[0] = precision_;
+    result[1] = 1;
+    std::memcpy(result.data() + 2, hashes.data(), hashes.size() * sizeof(uint64_t));
+    return result;
+}
+
+HyperLogLog HyperLogLog::Deserialize(const uint8_t* data, size_t size) {
+    if (size < 2) {
+        throw std::runtime_error("Truncated HyperLogLog sketch.");
+    }
+    HyperLogLog result(data[0]);
+    size_t payload_size = size - 2;
+    if (data[1] == 0) {
+        if (payload_size != (size_t{1} << result.precision_)) {
+            throw std::runtime_error("Corrupted HyperLogLog registers.");
+        }
+        result.registers_.assign(data + 2, data + size);
+        return result;
+    }
+    if (payload_size % sizeof(uint64_t) != 0) {
+        throw std::runtime_error("Corrupted HyperLogLog sparse hashes.");
+    }
+    result.sparse_hashes_.resize(payload_size / sizeof(uint64_t));
+    std::memcpy(result.sparse_hashes_.data(), data + 2, payload_size);
+    return result;
+}
+
+void HyperLogLog::AddToRegisters(uint64_t hash) {
+    uint64_t index = hash >> (64 - precision_);
+    uint64_t rest = (hash << precision_) | (uint64_t{1} << (precision_ - 1));
+    uint8_t rank = static_cast<uint8_t>(std::countl_zero(rest) + 1);
+    registers_[index] = std::max(registers_[index], rank);
+}
+
+void HyperLogLog::CompactSparse() {
+    std::sort(sparse_hashes_.begin(), sparse_hashes_.end());
+    sparse_hashes_.erase(std::unique(sparse_hashes_.begin(), sparse_hashes_.end()), sparse_hashes_.end());
+}
+
+void HyperLogLog::ConvertToDense() {
+    registers_.assign(size_t{1} << precision_, 0);
+    for (uint64_t hash : sparse_hashes_) {
+        AddToRegisters(hash);
+    }
+    sparse_hashes_.clear();
+    sparse_hashes_.shrink_to_fit();
+}
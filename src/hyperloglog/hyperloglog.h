@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class HyperLogLog {
+public:
+    static constexpr uint8_t kMinPrecision = 4;
+    static constexpr uint8_t kMaxPrecision = 18;
+    static constexpr uint8_t kDefaultPrecision = 14;
+
+    explicit HyperLogLog(uint8_t precision = kDefaultPrecision);
+    void Add(uint64_t hash);
+    void AddHashes(const std::vector<uint64_t>& hashes);
+    void Merge(const HyperLogLog& other);
+    uint64_t Estimate() const;
+    std::vector<uint8_t> Serialize() const;
+    static HyperLogLog Deserialize(const uint8_t* data, size_t size);
+    uint8_t GetPrecision() const { return precision_; }
+    bool IsSparse() const { return registers_.empty(); }
+
+protected:
+    void AddToRegisters(uint64_t hash);
+    void CompactSparse();
+    void ConvertToDense();
+
+    uint8_t precision_;
+    std::vector<uint8_t> registers_;
+    std::vector<uint64_t> sparse_hashes_;
+    size_t sparse_limit_;
+};
@@ -3,12 +3,22 @@
 #include "../utilities/utilities.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <numeric>
 #include <queue>
 #include <stdexcept>
+#include <thread>
 #include <unordered_map>
+#include <unistd.h>
 
 namespace {
 
+constexpr int64_t kMaxBloomProbes = 1024;
+
 void EnsureTransformsSize(size_t expected_size, std::vector<AggregationTransform>& transforms) {
     if (transforms.empty()) {
         transforms.resize(expected_size);
@@ -27,6 +37,9 @@ bool IsIntegralType(int64_t type) {
 }
 
 int64_t GetEffectiveType(int64_t source_type, const AggregationTransform& transform) {
+    if (transform.expression != nullptr) {
+        return transform.expression->GetOutputType();
+    }
     if (!transform.HasValue()) {
         return source_type;
     }
@@ -47,25 +60,103 @@ std::string CellToString(const CellTypes& value) {
     }, value);
 }
 
-std::vector<std::string> BuildGroupKeyNames(
+uint64_t HashCell(const CellTypes& value) {
+    if (std::holds_alternative<int64_t>(value)) {
+        return HashInt64(std::get<int64_t>(value));
+    }
+    if (std::holds_alternative<double>(value)) {
+        return HashDouble(std::get<double>(value));
+    }
+    return HashString(std::get<std::string>(value));
+}
+
+bool MightContainValue(const ColumnBlockStats& stats, const CellTypes& value) {
+    return stats.bloom_filter == nullptr || stats.bloom_filter->MightContain(HashCell(value));
+}
+
+template <typename It>
+bool MightContainAny(const ColumnBlockStats& stats, It begin, It end) {
+    if (stats.bloom_filter == nullptr || end - begin > kMaxBloomProbes) {
+        return true;
+    }
+    for (It it = begin; it != end; ++it) {
+        if (stats.bloom_filter->MightContain(HashCell(*it))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MightContainLiterals(const ColumnBlockStats& stats, const std::vector<std::string>& literals) {
+    if (stats.ngram_filter == nullptr) {
+        return true;
+    }
+    std::vector<uint64_t> hashes;
+    for (const std::string& literal : literals) {
+        AppendNgramHashes(literal, hashes);
+    }
+    if (static_cast<int64_t>(hashes.size()) > kMaxBloomProbes) {
+        return true;
+    }
+    return std::all_of(hashes.begin(), hashes.end(), [&](uint64_t hash) {
+        return stats.ngram_filter->MightContain(hash);
+    });
+}
+
+template <typename Fn>
+bool VisitIntegerValues(const Column* column, Fn&& fn) {
+    if (const auto* int64_column = dynamic_cast<const Int64*>(column)) {
+        fn(int64_column->GetValues());
+    } else if (const auto* int32_column = dynamic_cast<const Int32*>(column)) {
+        fn(int32_column->GetValues());
+    } else if (const auto* int16_column = dynamic_cast<const Int16*>(column)) {
+        fn(int16_column->GetValues());
+    } else if (const auto* date_column = dynamic_cast<const Date*>(column)) {
+        fn(date_column->GetValues());
+    } else if (const auto* timestamp_column = dynamic_cast<const Timestamp*>(column)) {
+        fn(timestamp_column->GetValues());
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const Column* GetTransformInput(
     const Batch& batch,
-    const std::vector<int>& group_by_ids,
+    int column_id,
+    const AggregationTransform& transform,
+    std::unique_ptr<Column>& holder
+) {
+    if (transform.expression != nullptr) {
+        return transform.expression->EvaluateInto(batch, holder);
+    }
+    return batch[column_id].get();
+}
+
+GroupKey BuildGroupKeyNames(
+    const std::vector<const Column*>& key_columns,
     const std::vector<AggregationTransform>& group_by_transforms,
-    int64_t row_id
+    int64_t row_id,
+    std::pmr::memory_resource* resource
 ) {
-    std::vector<std::string> result;
-    result.reserve(group_by_ids.size());
-    for (size_t i = 0; i < group_by_ids.size(); ++i) {
-        CellTypes value = batch[group_by_ids[i]]->Get(row_id);
+    GroupKey result(resource);
+    result.reserve(key_columns.size());
+    for (size_t i = 0; i < key_columns.size(); ++i) {
+        CellTypes value = key_columns[i]->Get(row_id);
         if (group_by_transforms[i].HasValue()) {
             value = group_by_transforms[i].Apply(value);
         }
-        result.push_back(CellToString(value));
+        result.emplace_back(CellToString(value));
     }
     return result;
 }
 
-std::unique_ptr<IAccumulator> CreateAccumulator(GlobalAggregationOperator::Op op, int64_t effective_type, const AggregationTransform& transform) {
+std::unique_ptr<IAccumulator> CreateAccumulator(
+    GlobalAggregationOperator::Op op,
+    int64_t effective_type,
+    const AggregationTransform& transform,
+    uint8_t approx_precision = HyperLogLog::kDefaultPrecision
+) {
     switch (op) {
         case GlobalAggregationOperator::Op::SUM:
             if (IsIntegralType(effective_type)) {
@@ -88,6 +179,8 @@ std::unique_ptr<IAccumulator> CreateAccumulator(GlobalAggregationOperator::Op op
                 return std::make_unique<CountDistinctIntAccumulator>();
             }
             return std::make_unique<CountDistinctStringAccumulator>();
+        case GlobalAggregationOperator::Op::ApproxCountDistinct:
+            return std::make_unique<ApproxCountDistinctAccumulator>(approx_precision, transform);
     }
     throw std::runtime_error("Unknown aggregation op.");
 }
@@ -143,12 +236,71 @@ void AddResultColumn(Batch& batch, std::vector<int64_t>& curr_types, GlobalAggre
             return;
         case GlobalAggregationOperator::Op::COUNT:
         case GlobalAggregationOperator::Op::CountDistinct:
+        case GlobalAggregationOperator::Op::ApproxCountDistinct:
             batch.push_back(std::make_unique<Int64>());
             curr_types.push_back(static_cast<int64_t>(Types::TypeInt64));
             return;
     }
 }
 
+int64_t MakeRowId(int64_t batch_index, int64_t row) {
+    return (batch_index << 32) | row;
+}
+
+int64_t GetRowIdBatch(int64_t row_id) {
+    return row_id >> 32;
+}
+
+int64_t GetRowIdRow(int64_t row_id) {
+    return row_id & 0xFFFFFFFF;
+}
+
+constexpr int64_t kMinRowsPerSortThread = 1 << 16;
+constexpr int64_t kSortRunChunkRows = 8192;
+constexpr int64_t kSortOutputBatchRows = 65536;
+
+void SortPermutation(std::vector<int64_t>& permutation, const std::vector<std::string>& keys) {
+    auto comp = [&](int64_t a, int64_t b) {
+        int cmp = keys[a].compare(keys[b]);
+        return cmp != 0 ? cmp < 0 : a < b;
+    };
+    int64_t row_count = permutation.size();
+    int64_t thread_count = std::min<int64_t>(std::max(1u, std::thread::hardware_concurrency()), row_count / kMinRowsPerSortThread);
+    if (thread_count <= 1) {
+        std::sort(permutation.begin(), permutation.end(), comp);
+        return;
+    }
+    std::vector<int64_t> bounds(thread_count + 1);
+    for (int64_t i = 0; i <= thread_count; ++i) {
+        bounds[i] = row_count * i / thread_count;
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    for (int64_t i = 0; i < thread_count; ++i) {
+        threads.emplace_back([&, i]() {
+            std::sort(permutation.begin() + bounds[i], permutation.begin() + bounds[i + 1], comp);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int64_t width = 1; width < thread_count; width *= 2) {
+        for (int64_t i = 0; i + width < thread_count; i += 2 * width) {
+            int64_t end = std::min(i + 2 * width, thread_count);
+            std::inplace_merge(permutation.begin() + bounds[i], permutation.begin() + bounds[i + width], permutation.begin() + bounds[end], comp);
+        }
+    }
+}
+
+std::string CreateTempFile(const std::string& prefix) {
+    std::string path = (std::filesystem::temp_directory_path() / (prefix + "XXXXXX")).string();
+    int fd = mkstemp(path.data());
+    if (fd == -1) {
+        throw std::runtime_error("Failed to create temporary file.");
+    }
+    close(fd);
+    return path;
+}
 
 } // namespace
 
@@ -163,238 +315,956 @@ ScanOperator::ScanOperator(const std::string& filename, const std::vector<std::s
             curr_types_.push_back(all_types[id]);
         }
       }
-std::optional<Batch> ScanOperator::Next() {
-    while (true) {
-        if (batch_filter_ != nullptr) {
-            std::optional<BatchBlockStats> batch_stats = reader_.PeekNextBatchBlockStats();
-            if (!batch_stats.has_value()) {
-                return std::nullopt;
-            }
-            if (batch_filter_->CanSkipBatch(batch_stats.value())) {
-                reader_.SkipNextBatch();
-                continue;
-            }
-        }
-        std::optional<Batch> batch = reader_.ReadNextBatch(curr_ids_);
-        if (!batch.has_value()) {
-            return std::nullopt;
-        }
-        return std::move(batch);
+void ScanOperator::EnableRowIds() {
+    if (with_row_ids_) {
+        return;
     }
+    if (curr_ids_.empty()) {
+        throw std::runtime_error("Row ids need at least one scanned column.");
+    }
+    with_row_ids_ = true;
+    curr_ids_.push_back(reader_.GetScheme().GetTypesInfo().size());
+    curr_types_.push_back(static_cast<int64_t>(Types::TypeInt64));
 }
 
-std::optional<Batch> FilterOperator::Next() {
-    std::vector<int> curr_ids = child_->GetCurrColIds();
-    std::optional<Batch> batch = child_->Next();
-    if (!batch.has_value()) {
-        return std::nullopt;
+void ScanOperator::OrderBatchesByStats(int column_id, bool is_desc) {
+    int64_t batch_count = reader_.GetBatchCount();
+    std::vector<CellTypes> bounds;
+    bounds.reserve(batch_count);
+    for (int64_t i = 0; i < batch_count; ++i) {
+        ColumnBlockStats stats = reader_.GetBatchBlockStats(i)[column_id];
+        bounds.push_back(is_desc ? std::move(stats.max_value) : std::move(stats.min_value));
     }
-    int64_t row_count = batch.value()[curr_ids.front()]->GetRowCount();
-    std::vector<int64_t> filtered_ids;
-    for (int64_t i = 0; i < row_count; ++i) {
-        if (condition_->Evaluate(batch.value(), i)) {
-            filtered_ids.push_back(i);
-        }
+    std::vector<int64_t> order(batch_count);
+    for (int64_t i = 0; i < batch_count; ++i) {
+        order[i] = i;
     }
-    for (int i : curr_ids) {
-        batch.value()[i]->FilterRows(filtered_ids);
+    std::stable_sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+        return is_desc ? bounds[a] > bounds[b] : bounds[a] < bounds[b];
+    });
+    reader_.SetBatchOrder(order);
+}
+
+PruneResult PruneCompare(const ColumnBlockStats& stats, Column::Op op, const CellTypes& value) {
+    if (stats.min_value.index() != value.index() || stats.max_value.index() != value.index()) {
+        return PruneResult::Some;
+    }
+    const CellTypes& min_value = stats.min_value;
+    const CellTypes& max_value = stats.max_value;
+    bool none = false;
+    bool all = false;
+    switch (op) {
+        case Column::Op::EQ:
+            none = min_value > value || max_value < value || !MightContainValue(stats, value);
+            all = min_value == value && max_value == value;
+            break;
+        case Column::Op::NE:
+            none = min_value == value && max_value == value;
+            all = min_value > value || max_value < value || !MightContainValue(stats, value);
+            break;
+        case Column::Op::LT:
+            none = min_value >= value;
+            all = max_value < value;
+            break;
+        case Column::Op::LE:
+            none = min_value > value;
+            all = max_value <= value;
+            break;
+        case Column::Op::GT:
+            none = max_value <= value;
+            all = min_value > value;
+            break;
+        case Column::Op::GE:
+            none = max_value < value;
+            all = min_value >= value;
+            break;
     }
-    return std::move(batch);
+    return none ? PruneResult::None : (all ? PruneResult::All : PruneResult::Some);
 }
 
-std::vector<int> FilterOperator::GetCurrColIds() const {
-    return child_->GetCurrColIds();
+bool ScanOperator::NeedsBatchStats() const {
+    return batch_filter_ != nullptr || !extra_batch_filters_.empty() || stats_consumer_ != nullptr;
 }
 
-void SumIntAccumulator::Update(const Column* column) {
-    if (const auto* int_column = dynamic_cast<const Int64*>(column)) {
-        if (!transform_.HasValue()) {
-            sum_ += static_cast<__int128_t>(int_column->GetSum());
-            return;
-        }
-        auto transform = [this](int64_t value) -> int64_t {
-            return std::get<int64_t>(transform_.Apply(value));
-        };
-        sum_ += static_cast<__int128_t>(int_column->GetSum(transform));
-        return;
+bool ScanOperator::CanSkipBatch(const BatchBlockStats& batch_stats, int64_t batch_index) const {
+    bool is_fully_matched = true;
+    auto check = [&](const FilterCondition* filter) {
+        PruneResult result = filter->Prune(batch_stats);
+        is_fully_matched = is_fully_matched && result == PruneResult::All;
+        return result == PruneResult::None;
+    };
+    if (batch_filter_ != nullptr && check(batch_filter_)) {
+        return true;
     }
-    int64_t row_count = column->GetRowCount();
-    for (int64_t i = 0; i < row_count; ++i) {
-        CellTypes value = transform_.HasValue() ? transform_.Apply(column->Get(i)) : column->Get(i);
-        sum_ += static_cast<__int128_t>(std::get<int64_t>(value));
+    for (const auto* filter : extra_batch_filters_) {
+        if (check(filter)) {
+            return true;
+        }
     }
+    return is_fully_matched && stats_consumer_ != nullptr && stats_consumer_(batch_stats, reader_.GetBatchRowCount(batch_index));
 }
 
-void SumIntAccumulator::Update(const Column* column, const std::vector<uint64_t>& mask) {
-    if (const auto* int_column = dynamic_cast<const Int64*>(column)) {
-        if (!transform_.HasValue()) {
-            sum_ += static_cast<__int128_t>(int_column->GetSum(mask));
-            return;
+std::optional<uint64_t> ScanOperator::EstimateDistinctCount(int column_id) const {
+    std::optional<HyperLogLog> sketch;
+    for (int64_t i = 0; i < reader_.GetBatchCount(); ++i) {
+        ColumnBlockStats stats = reader_.GetBatchBlockStats(i)[column_id];
+        if (stats.extended == nullptr || !stats.extended->distinct.has_value()) {
+            return std::nullopt;
+        }
+        if (sketch.has_value()) {
+            sketch->Merge(stats.extended->distinct.value());
+        } else {
+            sketch = stats.extended->distinct;
         }
-        auto transform = [this](int64_t value) -> int64_t {
-            return std::get<int64_t>(transform_.Apply(value));
-        };
-        sum_ += static_cast<__int128_t>(int_column->GetSum(mask, transform));
-        return;
     }
-    for (uint64_t row_id : mask) {
-        CellTypes value = transform_.HasValue() ? transform_.Apply(column->Get(row_id)) : column->Get(row_id);
-        sum_ += static_cast<__int128_t>(std::get<int64_t>(value));
+    if (!sketch.has_value()) {
+        return std::nullopt;
     }
+    return sketch->Estimate();
 }
 
+void ScanOperator::AppendRowIds(Batch& batch, int64_t batch_index, int64_t first_row) const {
+    int64_t row_count = batch[curr_ids_.front()]->GetRowCount();
+    std::vector<int64_t> row_ids(row_count);
+    for (int64_t r = 0; r < row_count; ++r) {
+        row_ids[r] = MakeRowId(batch_index, first_row + r);
+    }
+    batch.push_back(std::make_unique<Int64>(std::move(row_ids)));
+}
 
+std::vector<int> ScanOperator::GetReadIds() const {
+    return with_row_ids_ ? std::vector<int>(curr_ids_.begin(), curr_ids_.end() - 1) : curr_ids_;
+}
 
-void SumFloatAccumulator::Update(const Column* column) {
-    if (const auto* double_column = dynamic_cast<const Double*>(column)) {
-        if (!transform_.HasValue()) {
-            sum_ += double_column->GetSum();
-            return;
+std::optional<Batch> ScanOperator::NextMorsel(int64_t& batch_index) {
+    while (true) {
+        batch_index = morsels_->Pop();
+        if (batch_index >= reader_.GetBatchCount()) {
+            current_stats_.reset();
+            return std::nullopt;
         }
-        auto transform = [this](double value) -> double {
-            return std::get<double>(transform_.Apply(value));
-        };
-        sum_ += double_column->GetSum(transform);
-        return;
-    }
-    int64_t row_count = column->GetRowCount();
-    for (int64_t i = 0; i < row_count; ++i) {
-        CellTypes value = transform_.HasValue() ? transform_.Apply(column->Get(i)) : column->Get(i);
-        sum_ += std::visit([](auto&& arg) -> double {
-            using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, double>) {
-                return static_cast<double>(arg);
-            } else {
-                throw std::runtime_error("SumFloatAccumulator expects numeric input.");
+        if (NeedsBatchStats()) {
+            current_stats_ = reader_.GetBatchBlockStats(batch_index);
+            if (CanSkipBatch(current_stats_.value(), batch_index)) {
+                continue;
             }
-        }, value);
+        } else {
+            current_stats_.reset();
+        }
+        return reader_.ReadBatch(batch_index, GetReadIds());
     }
 }
 
-void SumFloatAccumulator::Update(const Column* column, const std::vector<uint64_t>& mask) {
-    if (const auto* double_column = dynamic_cast<const Double*>(column)) {
-        if (!transform_.HasValue()) {
-            sum_ += double_column->GetSum(mask);
-            return;
-        }
-        auto transform = [this](double value) -> double {
-            return std::get<double>(transform_.Apply(value));
-        };
-        sum_ += double_column->GetSum(mask, transform);
-        return;
+std::optional<Batch> ScanOperator::NextRowGroup(int64_t& batch_index) {
+    if (morsels_ != nullptr) {
+        return NextMorsel(batch_index);
     }
-    for (uint64_t row_id : mask) {
-        CellTypes value = transform_.HasValue() ? transform_.Apply(column->Get(row_id)) : column->Get(row_id);
-        sum_ += std::visit([](auto&& arg) -> double {
-            using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, double>) {
-                return static_cast<double>(arg);
-            } else {
-                throw std::runtime_error("SumFloatAccumulator expects numeric input.");
+    while (true) {
+        if (NeedsBatchStats()) {
+            current_stats_ = reader_.PeekNextBatchBlockStats();
+            if (!current_stats_.has_value()) {
+                return std::nullopt;
             }
-        }, value);
+            if (CanSkipBatch(current_stats_.value(), reader_.GetNextBatchIndex())) {
+                reader_.SkipNextBatch();
+                continue;
+            }
+        } else {
+            current_stats_.reset();
+        }
+        batch_index = reader_.GetNextBatchIndex();
+        return reader_.ReadNextBatch(GetReadIds());
     }
 }
 
-CellTypes AvgAccumulator::GetResult() const {
-    if (count_ == 0) {
-        return 0;
+std::optional<Batch> ScanOperator::Next() {
+    if (!pending_.has_value()) {
+        std::optional<Batch> batch = NextRowGroup(pending_batch_index_);
+        if (!batch.has_value()) {
+            return std::nullopt;
+        }
+        int64_t row_count = batch.value()[curr_ids_.front()]->GetRowCount();
+        if (vector_size_ <= 0 || row_count <= vector_size_) {
+            if (with_row_ids_) {
+                AppendRowIds(batch.value(), pending_batch_index_, 0);
+            }
+            return batch;
+        }
+        pending_ = std::move(batch);
+        pending_offset_ = 0;
     }
-    if (const auto* int_sum_accumulator = dynamic_cast<const SumIntAccumulator*>(sum_accumulator_.get())) {
-        long double average = static_cast<long double>(int_sum_accumulator->GetWideResult()) / static_cast<long double>(count_);
-        return static_cast<double>(average);
+    Batch& row_group = pending_.value();
+    int64_t row_count = row_group[curr_ids_.front()]->GetRowCount();
+    int64_t begin = pending_offset_;
+    int64_t end = std::min(row_count, begin + vector_size_);
+    Batch batch(row_group.size());
+    for (int id : GetReadIds()) {
+        batch[id] = reader_.AcquireColumn(id);
+        batch[id]->AssignRange(*row_group[id], begin, end);
     }
-    CellTypes sum_val = sum_accumulator_->GetResult();
-    double average = std::visit([this](auto&& arg) -> double {
-        using T = std::decay_t<decltype(arg)>;
-        if constexpr (std::is_arithmetic_v<T>) {
-            return static_cast<double>(arg) / static_cast<double>(this->count_);
-        } else {
-            return 0.0; 
-        }
-    }, sum_val);
-    return average;
+    if (with_row_ids_) {
+        AppendRowIds(batch, pending_batch_index_, begin);
+    }
+    pending_offset_ = end;
+    if (pending_offset_ >= row_count) {
+        reader_.RecycleBatch(std::move(pending_.value()));
+        pending_.reset();
+    }
+    return batch;
 }
 
-void AvgAccumulator::Update(const Column* column) {
-    sum_accumulator_->Update(column);
-    count_ += column->GetRowCount();
+void FilterCondition::EvaluateBatch(const Batch& batch, std::vector<int64_t>& row_ids) const {
+    std::erase_if(row_ids, [&](int64_t row_id) { return !Evaluate(batch, row_id); });
 }
 
-void AvgAccumulator::Update(const Column* column, const std::vector<uint64_t>& mask) {
-    sum_accumulator_->Update(column, mask);
-    count_ += column->GetRowCount(mask);
+void NotFilter::EvaluateBatch(const Batch& batch, std::vector<int64_t>& row_ids) const {
+    std::vector<int64_t> passed = row_ids;
+    child_->EvaluateBatch(batch, passed);
+    std::vector<int64_t> result;
+    result.reserve(row_ids.size() - passed.size());
+    std::set_difference(row_ids.begin(), row_ids.end(), passed.begin(), passed.end(), std::back_inserter(result));
+    row_ids = std::move(result);
 }
 
-void CountAccumulator::Update(const Column* column) {
-    count_ += column->GetRowCount();
+PruneResult NotFilter::Prune(const BatchBlockStats& batch_stats) const {
+    switch (child_->Prune(batch_stats)) {
+        case PruneResult::None:
+            return PruneResult::All;
+        case PruneResult::All:
+            return PruneResult::None;
+        case PruneResult::Some:
+            return PruneResult::Some;
+    }
+    return PruneResult::Some;
 }
 
-void CountAccumulator::Update(const Column* column, const std::vector<uint64_t>& mask) {
-    count_ += column->GetRowCount(mask);
+void CompositeFilter::EvaluateChild(size_t index, const Batch& batch, std::vector<int64_t>& row_ids) const {
+    size_t rows_in = row_ids.size();
+    auto start = std::chrono::steady_clock::now();
+    children_[index]->EvaluateBatch(batch, row_ids);
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    PredicateStats& stats = stats_[index];
+    stats.rows_in += rows_in;
+    stats.rows_out += row_ids.size();
+    if (rows_in > 0) {
+        stats.min_cost = std::min(stats.min_cost, static_cast<double>(elapsed.count()) / rows_in);
+    }
 }
 
-void MinAccumulator::Update(const Column* column) {
-    CellTypes batch_min = column->GetMin();
-    if (!has_data_) {
-        min_ = batch_min;
-        has_data_ = true;
-    } else if (batch_min < min_) {
-        min_ = batch_min;
+void CompositeFilter::FinishBatch() const {
+    ++batch_count_;
+    if (batch_count_ > kWarmupBatches && batch_count_ % kReorderInterval != 0) {
+        return;
+    }
+    std::vector<double> ranks(children_.size());
+    for (size_t i = 0; i < children_.size(); ++i) {
+        ranks[i] = stats_[i].rows_in == 0 ? 0.0 : GetRank(stats_[i]);
+    }
+    std::stable_sort(order_.begin(), order_.end(), [&](size_t lhs, size_t rhs) { return ranks[lhs] < ranks[rhs]; });
+    if (batch_count_ > kWarmupBatches) {
+        for (PredicateStats& stats : stats_) {
+            stats.rows_in /= 2;
+            stats.rows_out /= 2;
+            stats.previous_cost = stats.GetCost();
+            stats.min_cost = std::numeric_limits<double>::infinity();
+        }
     }
 }
 
-void MinAccumulator::Update(const Column* column, const std::vector<uint64_t>& mask) {
-    CellTypes batch_min = column->GetMin(mask);
-    if (!has_data_) {
-        min_ = batch_min;
-        has_data_ = true;
-    } else if (batch_min < min_) {
-        min_ = batch_min;
-    }
+AndFilter::AndFilter(std::unique_ptr<FilterCondition> left, std::unique_ptr<FilterCondition> right) {
+    AddChild<AndFilter>(std::move(left));
+    AddChild<AndFilter>(std::move(right));
 }
 
-void MaxAccumulator::Update(const Column* column) {
-    CellTypes batch_max = column->GetMax();
-    if (!has_data_) {
-        max_ = batch_max;
-        has_data_ = true;
-    } else if (batch_max > max_) {
-        max_ = batch_max;
+AndFilter::AndFilter(std::vector<std::unique_ptr<FilterCondition>> children) {
+    for (auto& child : children) {
+        AddChild<AndFilter>(std::move(child));
     }
 }
 
-void MaxAccumulator::Update(const Column* column, const std::vector<uint64_t>& mask) {
-    CellTypes batch_max = column->GetMax(mask);
-    if (!has_data_) {
-        max_ = batch_max;
-        has_data_ = true;
-    } else if (batch_max > max_) {
-        max_ = batch_max;
+bool AndFilter::Evaluate(const Batch& batch, size_t row_index) const {
+    for (size_t index : order_) {
+        if (!children_[index]->Evaluate(batch, row_index)) {
+            return false;
+        }
     }
+    return true;
 }
 
-void CountDistinctIntAccumulator::Update(const Column* column) {
-    if (const auto* col = dynamic_cast<const Int16*>(column)) {
-        col->FillHashSet(set_);
-        return;
-    }
-    if (const auto* col = dynamic_cast<const Int32*>(column)) {
-        col->FillHashSet(set_);
-        return;
-    }
-    if (const auto* col = dynamic_cast<const Int64*>(column)) {
-        col->FillHashSet(set_);
-        return;
+void AndFilter::EvaluateBatch(const Batch& batch, std::vector<int64_t>& row_ids) const {
+    for (size_t index : order_) {
+        if (row_ids.empty()) {
+            break;
+        }
+        EvaluateChild(index, batch, row_ids);
     }
-    if (const auto* col = dynamic_cast<const Timestamp*>(column)) {
-        col->FillHashSet(set_);
-        return;
+    FinishBatch();
+}
+
+PruneResult AndFilter::Prune(const BatchBlockStats& batch_stats) const {
+    PruneResult result = PruneResult::All;
+    for (const auto& child : children_) {
+        PruneResult child_result = child->Prune(batch_stats);
+        if (child_result == PruneResult::None) {
+            return PruneResult::None;
+        }
+        if (child_result == PruneResult::Some) {
+            result = PruneResult::Some;
+        }
     }
-    throw std::runtime_error("CountDistinctIntAccumulator expects an integral column.");
+    return result;
 }
 
-void CountDistinctIntAccumulator::Update(const Column* column, const std::vector<uint64_t>& mask) {
+double AndFilter::GetRank(const PredicateStats& stats) const {
+    double cost = stats.GetCost();
+    double drop_rate = 1.0 - stats.rows_out / stats.rows_in;
+    return cost / std::max(drop_rate, 1e-6);
+}
+
+OrFilter::OrFilter(std::unique_ptr<FilterCondition> left, std::unique_ptr<FilterCondition> right) {
+    AddChild<OrFilter>(std::move(left));
+    AddChild<OrFilter>(std::move(right));
+}
+
+OrFilter::OrFilter(std::vector<std::unique_ptr<FilterCondition>> children) {
+    for (auto& child : children) {
+        AddChild<OrFilter>(std::move(child));
+    }
+}
+
+bool OrFilter::Evaluate(const Batch& batch, size_t row_index) const {
+    for (size_t index : order_) {
+        if (children_[index]->Evaluate(batch, row_index)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void OrFilter::EvaluateBatch(const Batch& batch, std::vector<int64_t>& row_ids) const {
+    std::vector<int64_t> rest = std::move(row_ids);
+    row_ids.clear();
+    for (size_t index : order_) {
+        if (rest.empty()) {
+            break;
+        }
+        std::vector<int64_t> passed = rest;
+        EvaluateChild(index, batch, passed);
+        std::vector<int64_t> remaining;
+        remaining.reserve(rest.size() - passed.size());
+        std::set_difference(rest.begin(), rest.end(), passed.begin(), passed.end(), std::back_inserter(remaining));
+        rest = std::move(remaining);
+        std::vector<int64_t> merged;
+        merged.reserve(row_ids.size() + passed.size());
+        std::merge(row_ids.begin(), row_ids.end(), passed.begin(), passed.end(), std::back_inserter(merged));
+        row_ids = std::move(merged);
+    }
+    FinishBatch();
+}
+
+PruneResult OrFilter::Prune(const BatchBlockStats& batch_stats) const {
+    PruneResult result = PruneResult::None;
+    for (const auto& child : children_) {
+        PruneResult child_result = child->Prune(batch_stats);
+        if (child_result == PruneResult::All) {
+            return PruneResult::All;
+        }
+        if (child_result == PruneResult::Some) {
+            result = PruneResult::Some;
+        }
+    }
+    return result;
+}
+
+double OrFilter::GetRank(const PredicateStats& stats) const {
+    double cost = stats.GetCost();
+    double pass_rate = stats.rows_out / stats.rows_in;
+    return cost / std::max(pass_rate, 1e-6);
+}
+
+bool LikeFilter::Evaluate(const Batch& batch, size_t row_index) const {
+    const Column* column = batch[scheme_.GetColumnIndex(column_)].get();
+    if (const auto* string_column = dynamic_cast<const String*>(column)) {
+        return matcher_.Match(string_column->GetValues()[row_index]);
+    }
+    return matcher_.Match(column->GetCellAsString(row_index));
+}
+
+void LikeFilter::EvaluateBatch(const Batch& batch, std::vector<int64_t>& row_ids) const {
+    const auto* string_column = dynamic_cast<const String*>(batch[scheme_.GetColumnIndex(column_)].get());
+    if (string_column == nullptr) {
+        FilterCondition::EvaluateBatch(batch, row_ids);
+        return;
+    }
+    if (string_column->HasDictionary()) {
+        const std::vector<std::string>& dictionary = string_column->GetDictionary();
+        std::vector<uint8_t> matches(dictionary.size());
+        for (size_t i = 0; i < dictionary.size(); ++i) {
+            matches[i] = matcher_.Match(dictionary[i]);
+        }
+        const std::vector<uint32_t>& ids = string_column->GetDictionaryIds();
+        std::erase_if(row_ids, [&](int64_t row_id) { return matches[ids[row_id]] == 0; });
+        return;
+    }
+    const std::vector<std::string>& values = string_column->GetValues();
+    std::erase_if(row_ids, [&](int64_t row_id) { return !matcher_.Match(values[row_id]); });
+}
+
+PruneResult LikeFilter::Prune(const BatchBlockStats& batch_stats) const {
+    const std::string& prefix = matcher_.GetPrefix();
+    const int column_index = scheme_.GetColumnIndex(column_);
+    if (column_index < 0 || column_index >= static_cast<int>(batch_stats.size())) {
+        return PruneResult::Some;
+    }
+    const ColumnBlockStats& stats = batch_stats[column_index];
+    if (!MightContainLiterals(stats, matcher_.GetLiterals())) {
+        return PruneResult::None;
+    }
+    if (prefix.empty()) {
+        return PruneResult::Some;
+    }
+    if (!std::holds_alternative<std::string>(stats.min_value) || !std::holds_alternative<std::string>(stats.max_value)) {
+        return PruneResult::Some;
+    }
+    const std::string& min_value = std::get<std::string>(stats.min_value);
+    const std::string& max_value = std::get<std::string>(stats.max_value);
+    if (max_value < prefix || std::string_view(min_value).substr(0, prefix.size()) > prefix) {
+        return PruneResult::None;
+    }
+    if (matcher_.IsExactPattern() && min_value == prefix && max_value == prefix) {
+        return PruneResult::All;
+    }
+    if (matcher_.IsPrefixPattern() && min_value.starts_with(prefix) && max_value.starts_with(prefix)) {
+        return PruneResult::All;
+    }
+    return PruneResult::Some;
+}
+
+InFilter::InFilter(const std::string& column, const std::vector<CellTypes>& values, Scheme scheme)
+    : column_(column), scheme_(std::move(scheme)), type_(scheme_.GetTypeInfo(column_)) {
+    if (type_ == static_cast<int64_t>(Types::TypeString)) {
+        for (const CellTypes& value : values) {
+            if (!std::holds_alternative<std::string>(value)) {
+                throw std::runtime_error("IN list value does not match the column type.");
+            }
+            string_values_.push_back(std::get<std::string>(value));
+        }
+        std::sort(string_values_.begin(), string_values_.end());
+        string_values_.erase(std::unique(string_values_.begin(), string_values_.end()), string_values_.end());
+        if (string_values_.size() > kMaxSortedArraySize) {
+            mode_ = Mode::HashSet;
+            for (const std::string& value : string_values_) {
+                string_set_.Insert(value);
+            }
+        }
+        return;
+    }
+    if (type_ == static_cast<int64_t>(Types::TypeDouble)) {
+        throw std::runtime_error("IN filter supports integer, date, timestamp and string columns.");
+    }
+    for (const CellTypes& value : values) {
+        std::optional<int64_t> int_value = StatToInt(value);
+        if (!int_value.has_value()) {
+            throw std::runtime_error("IN list value does not match the column type.");
+        }
+        int_values_.push_back(int_value.value());
+    }
+    std::sort(int_values_.begin(), int_values_.end());
+    int_values_.erase(std::unique(int_values_.begin(), int_values_.end()), int_values_.end());
+    if (int_values_.empty()) {
+        return;
+    }
+    uint64_t span = static_cast<uint64_t>(int_values_.back()) - static_cast<uint64_t>(int_values_.front()) + 1;
+    if (span != 0 && span <= kMaxBitmapSpan) {
+        mode_ = Mode::Bitmap;
+        bitmap_base_ = int_values_.front();
+        bitmap_.assign((span + 63) / 64, 0);
+        for (int64_t value : int_values_) {
+            uint64_t offset = static_cast<uint64_t>(value) - static_cast<uint64_t>(bitmap_base_);
+            bitmap_[offset >> 6] |= uint64_t{1} << (offset & 63);
+        }
+    } else if (int_values_.size() > kMaxSortedArraySize) {
+        mode_ = Mode::HashSet;
+        int_set_.InsertBatch(int_values_.data(), int_values_.size());
+    }
+}
+
+std::optional<int64_t> InFilter::StatToInt(const CellTypes& value) const {
+    if (std::holds_alternative<int64_t>(value)) {
+        return std::get<int64_t>(value);
+    }
+    if (!std::holds_alternative<std::string>(value)) {
+        return std::nullopt;
+    }
+    if (type_ == static_cast<int64_t>(Types::TypeDate)) {
+        return ParseDate(std::get<std::string>(value));
+    }
+    if (type_ == static_cast<int64_t>(Types::TypeTimestamp)) {
+        return ParseTimestamp(std::get<std::string>(value));
+    }
+    return std::nullopt;
+}
+
+bool InFilter::ContainsInt(int64_t value) const {
+    switch (mode_) {
+        case Mode::Bitmap: {
+            uint64_t offset = static_cast<uint64_t>(value) - static_cast<uint64_t>(bitmap_base_);
+            return offset < bitmap_.size() * 64 && ((bitmap_[offset >> 6] >> (offset & 63)) & 1);
+        }
+        case Mode::SortedArray:
+            return std::binary_search(int_values_.begin(), int_values_.end(), value);
+        case Mode::HashSet:
+            return int_set_.Contains(value);
+    }
+    return false;
+}
+
+bool InFilter::ContainsString(std::string_view value) const {
+    if (mode_ == Mode::HashSet) {
+        return string_set_.Contains(value);
+    }
+    return std::binary_search(string_values_.begin(), string_values_.end(), value);
+}
+
+bool InFilter::Evaluate(const Batch& batch, size_t row_index) const {
+    const Column* column = batch[scheme_.GetColumnIndex(column_)].get();
+    if (const auto* string_column = dynamic_cast<const String*>(column)) {
+        return ContainsString(string_column->GetValues()[row_index]);
+    }
+    bool result = false;
+    VisitIntegerValues(column, [&](const auto& values) { result = ContainsInt(values[row_index]); });
+    return result;
+}
+
+void InFilter::EvaluateBatch(const Batch& batch, std::vector<int64_t>& row_ids) const {
+    const Column* column = batch[scheme_.GetColumnIndex(column_)].get();
+    if (const auto* string_column = dynamic_cast<const String*>(column)) {
+        if (string_column->HasDictionary()) {
+            const std::vector<std::string>& dictionary = string_column->GetDictionary();
+            std::vector<uint64_t> matches((dictionary.size() + 63) / 64, 0);
+            bool has_match = false;
+            for (size_t i = 0; i < dictionary.size(); ++i) {
+                if (ContainsString(dictionary[i])) {
+                    matches[i >> 6] |= uint64_t{1} << (i & 63);
+                    has_match = true;
+                }
+            }
+            if (!has_match) {
+                row_ids.clear();
+                return;
+            }
+            const std::vector<uint32_t>& ids = string_column->GetDictionaryIds();
+            std::erase_if(row_ids, [&](int64_t row_id) { return ((matches[ids[row_id] >> 6] >> (ids[row_id] & 63)) & 1) == 0; });
+            return;
+        }
+        const std::vector<std::string>& values = string_column->GetValues();
+        std::erase_if(row_ids, [&](int64_t row_id) { return !ContainsString(values[row_id]); });
+        return;
+    }
+    bool is_handled = VisitIntegerValues(column, [&](const auto& values) {
+        std::erase_if(row_ids, [&](int64_t row_id) { return !ContainsInt(values[row_id]); });
+    });
+    if (!is_handled) {
+        throw std::runtime_error("IN filter supports integer, date, timestamp and string columns.");
+    }
+}
+
+PruneResult InFilter::Prune(const BatchBlockStats& batch_stats) const {
+    const int column_index = scheme_.GetColumnIndex(column_);
+    if (column_index < 0 || column_index >= static_cast<int>(batch_stats.size())) {
+        return PruneResult::Some;
+    }
+    const ColumnBlockStats& stats = batch_stats[column_index];
+    if (type_ == static_cast<int64_t>(Types::TypeString)) {
+        if (!std::holds_alternative<std::string>(stats.min_value) || !std::holds_alternative<std::string>(stats.max_value)) {
+            return PruneResult::Some;
+        }
+        const std::string& min_value = std::get<std::string>(stats.min_value);
+        const std::string& max_value = std::get<std::string>(stats.max_value);
+        auto begin = std::lower_bound(string_values_.begin(), string_values_.end(), min_value);
+        auto end = std::upper_bound(begin, string_values_.end(), max_value);
+        if (begin == end || !MightContainAny(stats, begin, end)) {
+            return PruneResult::None;
+        }
+        return min_value == max_value ? PruneResult::All : PruneResult::Some;
+    }
+    std::optional<int64_t> min_value = StatToInt(stats.min_value);
+    std::optional<int64_t> max_value = StatToInt(stats.max_value);
+    if (!min_value.has_value() || !max_value.has_value()) {
+        return PruneResult::Some;
+    }
+    auto begin = std::lower_bound(int_values_.begin(), int_values_.end(), min_value.value());
+    auto end = std::upper_bound(begin, int_values_.end(), max_value.value());
+    if (begin == end || !MightContainAny(stats, begin, end)) {
+        return PruneResult::None;
+    }
+    uint64_t span = static_cast<uint64_t>(max_value.value()) - static_cast<uint64_t>(min_value.value());
+    return span < static_cast<uint64_t>(end - begin) ? PruneResult::All : PruneResult::Some;
+}
+
+ExpressionFilter::ExpressionFilter(ExpressionPtr expression) : expression_(std::move(expression)) {
+    if (expression_->GetOutputType() == static_cast<int64_t>(Types::TypeString)) {
+        throw std::runtime_error("Filter expression must be numeric.");
+    }
+    expression_->CollectColumns(column_ids_);
+    std::sort(column_ids_.begin(), column_ids_.end());
+    column_ids_.erase(std::unique(column_ids_.begin(), column_ids_.end()), column_ids_.end());
+}
+
+bool ExpressionFilter::Evaluate(const Batch& batch, size_t row_index) const {
+    Batch row(batch.size());
+    for (int id : column_ids_) {
+        row[id] = batch[id]->Slice(row_index, row_index + 1);
+    }
+    if (column_ids_.empty()) {
+        auto column = std::find_if(batch.begin(), batch.end(), [](const auto& column) { return column != nullptr; });
+        if (column != batch.end()) {
+            row[column - batch.begin()] = (*column)->Slice(row_index, row_index + 1);
+        }
+    }
+    std::vector<int64_t> row_ids{0};
+    EvaluateBatch(row, row_ids);
+    return !row_ids.empty();
+}
+
+void ExpressionFilter::EvaluateBatch(const Batch& batch, std::vector<int64_t>& row_ids) const {
+    std::unique_ptr<Column> holder;
+    const Column* mask = expression_->EvaluateInto(batch, holder);
+    if (const auto* int_mask = dynamic_cast<const Int64*>(mask)) {
+        const std::vector<int64_t>& values = int_mask->GetValues();
+        std::erase_if(row_ids, [&](int64_t row_id) { return values[row_id] == 0; });
+        return;
+    }
+    std::erase_if(row_ids, [&](int64_t row_id) { return !mask->Compare(row_id, Column::Op::NE, CellTypes(int64_t{0})); });
+}
+
+void FilterOperator::FilterBatch(Batch& batch, const std::vector<int>& curr_ids) const {
+    const BatchBlockStats* batch_stats = child_->GetCurrentBatchStats();
+    if (batch_stats != nullptr && condition_->Prune(*batch_stats) == PruneResult::All) {
+        return;
+    }
+    int64_t row_count = batch[curr_ids.front()]->GetRowCount();
+    std::vector<int64_t> filtered_ids(row_count);
+    std::iota(filtered_ids.begin(), filtered_ids.end(), 0);
+    condition_->EvaluateBatch(batch, filtered_ids);
+    for (int i : curr_ids) {
+        batch[i]->FilterRows(filtered_ids);
+    }
+}
+
+std::optional<Batch> FilterOperator::Next() {
+    std::optional<Batch> batch = child_->Next();
+    if (!batch.has_value()) {
+        return std::nullopt;
+    }
+    FilterBatch(batch.value(), child_->GetCurrColIds());
+    return batch;
+}
+
+void FilterOperator::Produce(const BatchConsumer& consumer) {
+    std::vector<int> curr_ids = child_->GetCurrColIds();
+    child_->Produce([&](Batch& batch) {
+        FilterBatch(batch, curr_ids);
+        consumer(batch);
+    });
+}
+
+std::vector<int> FilterOperator::GetCurrColIds() const {
+    return child_->GetCurrColIds();
+}
+
+ProjectionOperator::ProjectionOperator(std::unique_ptr<IOperator> child, std::vector<ExpressionPtr> expressions, const std::vector<std::string>& names)
+    : child_(std::move(child)), expressions_(std::move(expressions)) {
+    if (expressions_.size() != names.size()) {
+        throw std::runtime_error("Projection expression count must match name count.");
+    }
+    for (size_t i = 0; i < expressions_.size(); ++i) {
+        scheme_.AddColumnName(names[i]);
+        scheme_.AddColumnType(expressions_[i]->GetOutputType());
+    }
+}
+
+std::optional<Batch> ProjectionOperator::Next() {
+    std::optional<Batch> batch = child_->Next();
+    if (!batch.has_value()) {
+        return std::nullopt;
+    }
+    return Project(batch.value());
+}
+
+void ProjectionOperator::Produce(const BatchConsumer& consumer) {
+    child_->Produce([&](Batch& batch) {
+        Batch result = Project(batch);
+        consumer(result);
+    });
+}
+
+Batch ProjectionOperator::Project(Batch& batch) const {
+    Batch result(expressions_.size());
+    for (size_t i = 0; i < expressions_.size(); ++i) {
+        if (dynamic_cast<const ColumnRefExpression*>(expressions_[i].get()) == nullptr) {
+            result[i] = expressions_[i]->Evaluate(batch);
+        }
+    }
+    std::vector<int> moved_to(batch.size(), -1);
+    for (size_t i = 0; i < expressions_.size(); ++i) {
+        const auto* column_ref = dynamic_cast<const ColumnRefExpression*>(expressions_[i].get());
+        if (column_ref == nullptr) {
+            continue;
+        }
+        int column_index = column_ref->GetColumnIndex();
+        if (moved_to[column_index] < 0) {
+            result[i] = std::move(batch[column_index]);
+            moved_to[column_index] = i;
+            continue;
+        }
+        const Column& source = *result[moved_to[column_index]];
+        result[i] = source.CreateEmpty();
+        result[i]->AppendRange(source, 0, source.GetRowCount());
+    }
+    return result;
+}
+
+std::vector<int> ProjectionOperator::GetCurrColIds() const {
+    std::vector<int> result(expressions_.size());
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+}
+
+void SumIntAccumulator::Update(const Column* column) {
+    if (const auto* int_column = dynamic_cast<const Int64*>(column)) {
+        if (!transform_.HasValue()) {
+            sum_ += static_cast<__int128_t>(int_column->GetSum());
+            return;
+        }
+        auto transform = [this](int64_t value) -> int64_t {
+            return std::get<int64_t>(transform_.Apply(value));
+        };
+        sum_ += static_cast<__int128_t>(int_column->GetSum(transform));
+        return;
+    }
+    int64_t row_count = column->GetRowCount();
+    for (int64_t i = 0; i < row_count; ++i) {
+        CellTypes value = transform_.HasValue() ? transform_.Apply(column->Get(i)) : column->Get(i);
+        sum_ += static_cast<__int128_t>(std::get<int64_t>(value));
+    }
+}
+
+void SumIntAccumulator::Update(const Column* column, const std::vector<uint64_t>& mask) {
+    if (const auto* int_column = dynamic_cast<const Int64*>(column)) {
+        if (!transform_.HasValue()) {
+            sum_ += static_cast<__int128_t>(int_column->GetSum(mask));
+            return;
+        }
+        auto transform = [this](int64_t value) -> int64_t {
+            return std::get<int64_t>(transform_.Apply(value));
+        };
+        sum_ += static_cast<__int128_t>(int_column->GetSum(mask, transform));
+        return;
+    }
+    for (uint64_t row_id : mask) {
+        CellTypes value = transform_.HasValue() ? transform_.Apply(column->Get(row_id)) : column->Get(row_id);
+        sum_ += static_cast<__int128_t>(std::get<int64_t>(value));
+    }
+}
+
+
+
+void SumFloatAccumulator::Update(const Column* column) {
+    if (const auto* double_column = dynamic_cast<const Double*>(column)) {
+        if (!transform_.HasValue()) {
+            sum_ += double_column->GetSum();
+            return;
+        }
+        auto transform = [this](double value) -> double {
+            return std::get<double>(transform_.Apply(value));
+        };
+        sum_ += double_column->GetSum(transform);
+        return;
+    }
+    int64_t row_count = column->GetRowCount();
+    for (int64_t i = 0; i < row_count; ++i) {
+        CellTypes value = transform_.HasValue() ? transform_.Apply(column->Get(i)) : column->Get(i);
+        sum_ += std::visit([](auto&& arg) -> double {
+            using T = std::decay_t<decltype(arg)>;
+            if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, double>) {
+                return static_cast<double>(arg);
+            } else {
+                throw std::runtime_error("SumFloatAccumulator expects numeric input.");
+            }
+        }, value);
+    }
+}
+
+void SumFloatAccumulator::Update(const Column* column, const std::vector<uint64_t>& mask) {
+    if (const auto* double_column = dynamic_cast<const Double*>(column)) {
+        if (!transform_.HasValue()) {
+            sum_ += double_column->GetSum(mask);
+            return;
+        }
+        auto transform = [this](double value) -> double {
+            return std::get<double>(transform_.Apply(value));
+        };
+        sum_ += double_column->GetSum(mask, transform);
+        return;
+    }
+    for (uint64_t row_id : mask) {
+        CellTypes value = transform_.HasValue() ? transform_.Apply(column->Get(row_id)) : column->Get(row_id);
+        sum_ += std::visit([](auto&& arg) -> double {
+            using T = std::decay_t<decltype(arg)>;
+            if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, double>) {
+                return static_cast<double>(arg);
+            } else {
+                throw std::runtime_error("SumFloatAccumulator expects numeric input.");
+            }
+        }, value);
+    }
+}
+
+CellTypes AvgAccumulator::GetResult() const {
+    if (count_ == 0) {
+        return 0;
+    }
+    if (const auto* int_sum_accumulator = dynamic_cast<const SumIntAccumulator*>(sum_accumulator_.get())) {
+        long double average = static_cast<long double>(int_sum_accumulator->GetWideResult()) / static_cast<long double>(count_);
+        return static_cast<double>(average);
+    }
+    CellTypes sum_val = sum_accumulator_->GetResult();
+    double average = std::visit([this](auto&& arg) -> double {
+        using T = std::decay_t<decltype(arg)>;
+        if constexpr (std::is_arithmetic_v<T>) {
+            return static_cast<double>(arg) / static_cast<double>(this->count_);
+        } else {
+            return 0.0; 
+        }
+    }, sum_val);
+    return average;
+}
+
+void AvgAccumulator::Update(const Column* column) {
+    sum_accumulator_->Update(column);
+    count_ += column->GetRowCount();
+}
+
+void AvgAccumulator::Update(const Column* column, const std::vector<uint64_t>& mask) {
+    sum_accumulator_->Update(column, mask);
+    count_ += column->GetRowCount(mask);
+}
+
+void CountAccumulator::Update(const Column* column) {
+    count_ += column->GetRowCount();
+}
+
+void CountAccumulator::Update(const Column* column, const std::vector<uint64_t>& mask) {
+    count_ += column->GetRowCount(mask);
+}
+
+bool SumIntAccumulator::CanUseStats(const ColumnBlockStats& stats) const {
+    return SupportsStats() && stats.extended != nullptr && stats.extended->sum.has_value() &&
+           std::holds_alternative<int64_t>(stats.extended->sum.value());
+}
+
+void SumIntAccumulator::UpdateFromStats(const ColumnBlockStats& stats, int64_t) {
+    sum_ += static_cast<__int128_t>(std::get<int64_t>(stats.extended->sum.value()));
+}
+
+bool SumFloatAccumulator::CanUseStats(const ColumnBlockStats& stats) const {
+    return SupportsStats() && stats.extended != nullptr && stats.extended->sum.has_value() &&
+           std::holds_alternative<double>(stats.extended->sum.value());
+}
+
+void SumFloatAccumulator::UpdateFromStats(const ColumnBlockStats& stats, int64_t) {
+    sum_ += std::get<double>(stats.extended->sum.value());
+}
+
+bool AvgAccumulator::CanUseStats(const ColumnBlockStats& stats) const {
+    return sum_accumulator_->CanUseStats(stats);
+}
+
+void AvgAccumulator::UpdateFromStats(const ColumnBlockStats& stats, int64_t row_count) {
+    sum_accumulator_->UpdateFromStats(stats, row_count);
+    count_ += row_count;
+}
+
+void CountAccumulator::UpdateFromStats(const ColumnBlockStats&, int64_t row_count) {
+    count_ += row_count;
+}
+
+void MinAccumulator::Update(const Column* column) {
+    CellTypes batch_min = column->GetMin();
+    if (!has_data_) {
+        min_ = batch_min;
+        has_data_ = true;
+    } else if (batch_min < min_) {
+        min_ = batch_min;
+    }
+}
+
+void MinAccumulator::Update(const Column* column, const std::vector<uint64_t>& mask) {
+    CellTypes batch_min = column->GetMin(mask);
+    if (!has_data_) {
+        min_ = batch_min;
+        has_data_ = true;
+    } else if (batch_min < min_) {
+        min_ = batch_min;
+    }
+}
+
+void MinAccumulator::UpdateFromStats(const ColumnBlockStats& stats, int64_t) {
+    if (!has_data_ || stats.min_value < min_) {
+        min_ = stats.min_value;
+        has_data_ = true;
+    }
+}
+
+void MaxAccumulator::Update(const Column* column) {
+    CellTypes batch_max = column->GetMax();
+    if (!has_data_) {
+        max_ = batch_max;
+        has_data_ = true;
+    } else if (batch_max > max_) {
+        max_ = batch_max;
+    }
+}
+
+void MaxAccumulator::Update(const Column* column, const std::vector<uint64_t>& mask) {
+    CellTypes batch_max = column->GetMax(mask);
+    if (!has_data_) {
+        max_ = batch_max;
+        has_data_ = true;
+    } else if (batch_max > max_) {
+        max_ = batch_max;
+    }
+}
+
+void MaxAccumulator::UpdateFromStats(const ColumnBlockStats& stats, int64_t) {
+    if (!has_data_ || stats.max_value > max_) {
+        max_ = stats.max_value;
+        has_data_ = true;
+    }
+}
+
+void CountDistinctIntAccumulator::Update(const Column* column) {
+    if (const auto* col = dynamic_cast<const Int16*>(column)) {
+        col->FillHashSet(set_);
+        return;
+    }
+    if (const auto* col = dynamic_cast<const Int32*>(column)) {
+        col->FillHashSet(set_);
+        return;
+    }
+    if (const auto* col = dynamic_cast<const Int64*>(column)) {
+        col->FillHashSet(set_);
+        return;
+    }
+    if (const auto* col = dynamic_cast<const Timestamp*>(column)) {
+        col->FillHashSet(set_);
+        return;
+    }
+    throw std::runtime_error("CountDistinctIntAccumulator expects an integral column.");
+}
+
+void CountDistinctIntAccumulator::Update(const Column* column, const std::vector<uint64_t>& mask) {
     if (const auto* col = dynamic_cast<const Int16*>(column)) {
         col->FillHashSet(set_, mask);
         return;
@@ -414,14 +1284,197 @@ void CountDistinctIntAccumulator::Update(const Column* column, const std::vector
     throw std::runtime_error("CountDistinctIntAccumulator expects an integral column.");
 }
 
-void CountDistinctStringAccumulator::Update(const Column* column) {
-    const auto* col = static_cast<const String*>(column);
-    col->FillHashSet(set_);
+void CountDistinctStringAccumulator::Update(const Column* column) {
+    const auto* col = static_cast<const String*>(column);
+    col->FillHashSet(set_);
+}
+
+void CountDistinctStringAccumulator::Update(const Column* column, const std::vector<uint64_t>& mask) {
+    const auto* col = static_cast<const String*>(column);
+    col->FillHashSet(set_, mask);
+}
+
+void GroupedDistinctState::Update(int64_t group_id, const Column* column, const std::vector<uint64_t>& mask) {
+    if (const auto* string_column = dynamic_cast<const String*>(column)) {
+        const auto& values = string_column->GetValues();
+        for (uint64_t r : mask) {
+            Insert(group_id, strings_.GetOrInsert(values[r]));
+        }
+        return;
+    }
+    for (uint64_t r : mask) {
+        CellTypes value = column->Get(r);
+        if (std::holds_alternative<int64_t>(value)) {
+            Insert(group_id, std::get<int64_t>(value));
+        } else if (std::holds_alternative<std::string>(value)) {
+            Insert(group_id, strings_.GetOrInsert(std::get<std::string>(value)));
+        } else {
+            int64_t bits;
+            double number = std::get<double>(value);
+            std::memcpy(&bits, &number, sizeof(bits));
+            Insert(group_id, bits);
+        }
+    }
+}
+
+void GroupedDistinctState::Insert(int64_t group_id, int64_t value) {
+    if (group_id >= static_cast<int64_t>(counts_.size())) {
+        counts_.resize(group_id + 1, 0);
+    }
+    if (pairs_.Insert(group_id, value)) {
+        ++counts_[group_id];
+    }
+}
+
+void GroupedCountDistinctAccumulator::Update(const Column* column) {
+    std::vector<uint64_t> mask(column->GetRowCount());
+    for (uint64_t r = 0; r < mask.size(); ++r) {
+        mask[r] = r;
+    }
+    state_->Update(group_id_, column, mask);
+}
+
+void GroupedCountDistinctAccumulator::Update(const Column* column, const std::vector<uint64_t>& mask) {
+    state_->Update(group_id_, column, mask);
+}
+
+void ApproxCountDistinctAccumulator::Update(const Column* column) {
+    if (!transform_.HasValue()) {
+        column->ComputeHashes(hashes_);
+        sketch_.AddHashes(hashes_);
+        return;
+    }
+    int64_t row_count = column->GetRowCount();
+    for (int64_t r = 0; r < row_count; ++r) {
+        sketch_.Add(HashCell(transform_.Apply(column->Get(r))));
+    }
+}
+
+void ApproxCountDistinctAccumulator::Update(const Column* column, const std::vector<uint64_t>& mask) {
+    if (!transform_.HasValue()) {
+        column->ComputeHashes(mask, hashes_);
+        sketch_.AddHashes(hashes_);
+        return;
+    }
+    for (uint64_t r : mask) {
+        sketch_.Add(HashCell(transform_.Apply(column->Get(r))));
+    }
+}
+
+void SumIntAccumulator::Merge(const IAccumulator& other) {
+    sum_ += static_cast<const SumIntAccumulator&>(other).sum_;
+}
+
+void SumFloatAccumulator::Merge(const IAccumulator& other) {
+    sum_ += static_cast<const SumFloatAccumulator&>(other).sum_;
+}
+
+void AvgAccumulator::Merge(const IAccumulator& other) {
+    const auto& other_avg = static_cast<const AvgAccumulator&>(other);
+    sum_accumulator_->Merge(*other_avg.sum_accumulator_);
+    count_ += other_avg.count_;
+}
+
+void CountAccumulator::Merge(const IAccumulator& other) {
+    count_ += static_cast<const CountAccumulator&>(other).count_;
+}
+
+void MinAccumulator::Merge(const IAccumulator& other) {
+    const auto& other_min = static_cast<const MinAccumulator&>(other);
+    if (other_min.has_data_ && (!has_data_ || other_min.min_ < min_)) {
+        min_ = other_min.min_;
+        has_data_ = true;
+    }
+}
+
+void MaxAccumulator::Merge(const IAccumulator& other) {
+    const auto& other_max = static_cast<const MaxAccumulator&>(other);
+    if (other_max.has_data_ && (!has_data_ || other_max.max_ > max_)) {
+        max_ = other_max.max_;
+        has_data_ = true;
+    }
+}
+
+void CountDistinctIntAccumulator::Merge(const IAccumulator& other) {
+    set_.Merge(static_cast<const CountDistinctIntAccumulator&>(other).set_);
+}
+
+void CountDistinctStringAccumulator::Merge(const IAccumulator& other) {
+    static_cast<const CountDistinctStringAccumulator&>(other).set_.ForEach([this](std::string_view value, uint64_t) {
+        set_.Insert(value);
+    });
+}
+
+void GroupedCountDistinctAccumulator::Merge(const IAccumulator& other) {
+    const auto& other_distinct = static_cast<const GroupedCountDistinctAccumulator&>(other);
+    state_->MergeGroup(*other_distinct.state_, other_distinct.group_id_, group_id_);
+}
+
+int SumIntAccumulator::CompareResult(const IAccumulator& other) const {
+    return CompareResults(static_cast<int64_t>(sum_), static_cast<int64_t>(static_cast<const SumIntAccumulator&>(other).sum_));
+}
+
+int SumFloatAccumulator::CompareResult(const IAccumulator& other) const {
+    return CompareResults(sum_, static_cast<const SumFloatAccumulator&>(other).sum_);
+}
+
+int CountAccumulator::CompareResult(const IAccumulator& other) const {
+    return CompareResults(count_, static_cast<const CountAccumulator&>(other).count_);
+}
+
+int MinAccumulator::CompareResult(const IAccumulator& other) const {
+    return CompareResults(min_, static_cast<const MinAccumulator&>(other).min_);
+}
+
+int MaxAccumulator::CompareResult(const IAccumulator& other) const {
+    return CompareResults(max_, static_cast<const MaxAccumulator&>(other).max_);
+}
+
+int GroupedCountDistinctAccumulator::CompareResult(const IAccumulator& other) const {
+    return CompareResults(state_->GetCount(group_id_), state_->GetCount(static_cast<const GroupedCountDistinctAccumulator&>(other).group_id_));
+}
+
+void ApproxCountDistinctAccumulator::Merge(const IAccumulator& other) {
+    sketch_.Merge(static_cast<const ApproxCountDistinctAccumulator&>(other).sketch_);
+}
+
+std::vector<int64_t> GroupedDistinctState::MapStrings(const GroupedDistinctState& other) {
+    std::vector<int64_t> string_map;
+    if (&other != this && other.strings_.Size() > 0) {
+        string_map.resize(other.strings_.Size());
+        other.strings_.ForEach([&](std::string_view value, uint64_t id) {
+            string_map[id] = strings_.GetOrInsert(value);
+        });
+    }
+    return string_map;
+}
+
+void GroupedDistinctState::Merge(const GroupedDistinctState& other, const std::vector<int64_t>& group_map) {
+    std::vector<int64_t> string_map = MapStrings(other);
+    other.pairs_.ForEach([&](int64_t group_id, int64_t value) {
+        Insert(group_map[group_id], string_map.empty() ? value : string_map[value]);
+    });
 }
 
-void CountDistinctStringAccumulator::Update(const Column* column, const std::vector<uint64_t>& mask) {
-    const auto* col = static_cast<const String*>(column);
-    col->FillHashSet(set_, mask);
+void GroupedDistinctState::MergeGroup(const GroupedDistinctState& other, int64_t other_group_id, int64_t group_id) {
+    std::vector<int64_t> string_map = MapStrings(other);
+    std::vector<int64_t> values;
+    other.pairs_.ForEach([&](int64_t pair_group_id, int64_t value) {
+        if (pair_group_id == other_group_id) {
+            values.push_back(string_map.empty() ? value : string_map[value]);
+        }
+    });
+    for (int64_t value : values) {
+        Insert(group_id, value);
+    }
+}
+
+void GlobalAggregationOperator::SetApproxPrecision(uint8_t precision) {
+    for (size_t i = 0; i < op_.size(); ++i) {
+        if (op_[i] == Op::ApproxCountDistinct) {
+            static_cast<ApproxCountDistinctAccumulator*>(accumulators_[i].get())->SetPrecision(precision);
+        }
+    }
 }
 
 void GlobalAggregationOperator::Init() {
@@ -433,44 +1486,116 @@ void GlobalAggregationOperator::Init() {
         ++i;
         int64_t source_type = scheme_.GetTypeInfo(columns_[i]);
         int64_t effective_type = GetEffectiveType(source_type, transforms_[i]);
+        column_ids_.push_back(scheme_.GetColumnIndex(columns_[i]));
         accumulators_.push_back(CreateAccumulator(op, effective_type, transforms_[i]));
         AddResultColumn(result_batch_.value(), curr_types_, op, effective_type);
     }
 }
 
-std::optional<Batch> GlobalAggregationOperator::Next() {
-    std::vector<int> curr_ids;
-    for (auto& el : columns_) {
-        curr_ids.push_back(scheme_.GetColumnIndex(el));
+void GlobalAggregationOperator::ConsumeChild() {
+    if (is_input_consumed_) {
+        return;
+    }
+    is_input_consumed_ = true;
+    if (child_ == nullptr) {
+        return;
     }
-    while (const auto& batch = child_->Next()) {
-        int i = 0;
-        for (int id : curr_ids) {
-            accumulators_[i]->Update(batch.value()[id].get());
-            ++i;
+    if (CanUseStats()) {
+        child_->SetStatsConsumer([this](const BatchBlockStats& stats, int64_t row_count) {
+            for (size_t i = 0; i < accumulators_.size(); ++i) {
+                if (!accumulators_[i]->CanUseStats(stats[column_ids_[i]])) {
+                    return false;
+                }
+            }
+            for (size_t i = 0; i < accumulators_.size(); ++i) {
+                accumulators_[i]->UpdateFromStats(stats[column_ids_[i]], row_count);
+            }
+            return true;
+        });
+    }
+    child_->Produce([this](Batch& batch) {
+        ConsumeBatch(batch);
+        child_->RecycleBatch(std::move(batch));
+    });
+}
+
+bool GlobalAggregationOperator::CanUseStats() const {
+    for (size_t i = 0; i < accumulators_.size(); ++i) {
+        if (!accumulators_[i]->SupportsStats() || transforms_[i].HasValue() || transforms_[i].expression != nullptr) {
+            return false;
         }
     }
+    return !accumulators_.empty();
+}
+
+void GlobalAggregationOperator::ConsumeBatch(const Batch& batch) {
+    for (size_t i = 0; i < column_ids_.size(); ++i) {
+        std::unique_ptr<Column> holder;
+        accumulators_[i]->Update(GetTransformInput(batch, column_ids_[i], transforms_[i], holder));
+    }
+}
+
+void GlobalAggregationOperator::MergeFrom(IOperator& other) {
+    auto& partial = dynamic_cast<GlobalAggregationOperator&>(other);
+    partial.ConsumeChild();
+    for (size_t i = 0; i < accumulators_.size(); ++i) {
+        accumulators_[i]->Merge(*partial.accumulators_[i]);
+    }
+}
+
+std::optional<Batch> GlobalAggregationOperator::Next() {
+    ConsumeChild();
     for (int64_t i = 0; i < accumulators_.size(); ++i) {
         result_batch_.value()[i]->AddCell(accumulators_[i]->GetResult());
     }
     return std::move(result_batch_);
 }
 
-std::vector<std::unique_ptr<IAccumulator>> GroupByAggregationOperator::CreateGroupAccumulators() const {
+std::vector<std::unique_ptr<IAccumulator>> GroupByAggregationOperator::CreateGroupAccumulators(int64_t group_id) {
+    if (distinct_states_.empty()) {
+        distinct_states_.resize(op_.size());
+    }
     std::vector<std::unique_ptr<IAccumulator>> result;
     int i = -1;
     for (auto op : op_) {
         ++i;
+        if (op == Op::CountDistinct && is_approx_distinct_) {
+            op = Op::ApproxCountDistinct;
+        }
+        if (op == Op::CountDistinct) {
+            if (distinct_states_[i] == nullptr) {
+                distinct_states_[i] = std::make_unique<GroupedDistinctState>(memory_resource_);
+            }
+            result.push_back(std::make_unique<GroupedCountDistinctAccumulator>(distinct_states_[i].get(), group_id));
+            continue;
+        }
         int64_t source_type = scheme_.GetTypeInfo(aggr_col_names_[i]);
         int64_t effective_type = GetEffectiveType(source_type, transforms_[i]);
-        result.push_back(CreateAccumulator(op, effective_type, transforms_[i]));
+        result.push_back(CreateAccumulator(op, effective_type, transforms_[i], approx_precision_));
+    }
+    return result;
+}
+
+void GroupByAggregationOperator::SetMemoryResource(std::pmr::memory_resource* resource) {
+    if (!group_name_.empty()) {
+        throw std::runtime_error("Memory resource must be set before consuming input");
     }
-    return std::move(result);
+    memory_resource_ = resource;
+}
+
+void GroupByAggregationOperator::SetApproxPrecision(uint8_t precision) {
+    approx_precision_ = HyperLogLog(precision).GetPrecision();
 }
 
 void GroupByAggregationOperator::InitResultBatch() {
     EnsureTransformsSize(aggr_col_names_.size(), transforms_);
     EnsureTransformsSize(group_by_fields_.size(), group_by_transforms_);
+    for (const auto& name : aggr_col_names_) {
+        aggr_ids_.push_back(scheme_.GetColumnIndex(name));
+    }
+    for (const auto& name : group_by_fields_) {
+        group_by_ids_.push_back(scheme_.GetColumnIndex(name));
+    }
     result_batch_ = std::vector<std::unique_ptr<Column>>();
     curr_types_.clear();
     for (int64_t i = 0; i < group_by_fields_.size(); ++i) {
@@ -486,220 +1611,640 @@ void GroupByAggregationOperator::InitResultBatch() {
     }
 }
 
-std::optional<Batch> GroupByAggregationOperator::Next() {
-    if (is_consumed_) {
-        return std::nullopt;
+void GroupByAggregationOperator::ConsumeChild() {
+    if (is_input_consumed_) {
+        return;
     }
-    EnsureTransformsSize(group_by_fields_.size(), group_by_transforms_);
-    std::vector<int> aggr_ids;
-    std::vector<int> group_by_ids;
-    std::unordered_map<uint64_t, int64_t> hash_to_group_id;
-    int64_t group_id = -1;
-    std::vector<std::vector<std::string>> group_name;
-    std::vector<std::vector<std::unique_ptr<IAccumulator>>> group_to_accumulators;
-    for (auto& el : aggr_col_names_) {
-        aggr_ids.push_back(scheme_.GetColumnIndex(el));
-    }
-    for (auto& el : group_by_fields_) {
-        group_by_ids.push_back(scheme_.GetColumnIndex(el));
-    }
-
-    while (auto batch = child_->Next()) {
-        std::vector<uint64_t> hashes;
-        std::vector<std::vector<std::string>> empty_group_names;
-        int64_t row_count = batch.value()[group_by_ids.front()]->GetRowCount();
-        if (row_count == 0) {
+    is_input_consumed_ = true;
+    if (child_ != nullptr) {
+        ReserveGroups();
+        child_->Produce([this](Batch& batch) {
+            ConsumeBatch(batch);
+            child_->RecycleBatch(std::move(batch));
+        });
+    }
+}
+
+void GroupByAggregationOperator::ReserveGroups() {
+    uint64_t estimate = 0;
+    for (size_t i = 0; i < group_by_ids_.size(); ++i) {
+        if (group_by_transforms_[i].HasValue() || group_by_transforms_[i].expression != nullptr) {
             continue;
         }
-        hashes.resize(row_count);
-        for (int64_t i = 0; i < hashes.size(); ++i) {
-            hashes[i] = seed_;
-        }
-        for (size_t i = 0; i < group_by_ids.size(); ++i) {
-            const AggregationTransform& transform = group_by_transforms_[i];
-            batch.value()[group_by_ids[i]]->MergeHashes(
-                hashes,
-                empty_group_names,
-                transform.HasValue() ? transform.fn : std::function<CellTypes(const CellTypes&)>{}
-            );
-        }
-        std::vector<uint64_t> single_row(1);
-        for (uint64_t row_id = 0; row_id < hashes.size(); ++row_id) {
-            uint64_t hash = hashes[row_id];
-            auto it = hash_to_group_id.find(hash);
-            uint64_t current_group_id;
-            if (it == hash_to_group_id.end()) {
-                ++group_id;
-                hash_to_group_id.emplace(hash, group_id);
-                current_group_id = group_id;
-                group_name.push_back(BuildGroupKeyNames(batch.value(), group_by_ids, group_by_transforms_, row_id));
-                std::vector<std::unique_ptr<IAccumulator>> accumulators = CreateGroupAccumulators();
-                group_to_accumulators.push_back(std::move(accumulators));
-            } else {
-                current_group_id = it->second;
-            }
-            single_row[0] = row_id;
-            int aggr_col_id = 0;
-            for (auto& accumulator : group_to_accumulators[current_group_id]) {
-                accumulator->Update(batch.value()[aggr_ids[aggr_col_id]].get(), single_row);
-                ++aggr_col_id;
+        estimate = std::max(estimate, child_->EstimateDistinctCount(group_by_ids_[i]).value_or(0));
+    }
+    estimate = std::min(estimate, kMaxReservedGroups);
+    hash_to_group_id_.reserve(estimate);
+    group_name_.reserve(estimate);
+    group_to_accumulators_.reserve(estimate);
+}
+
+void GroupByAggregationOperator::ConsumeBatch(const Batch& batch) {
+    std::vector<std::unique_ptr<Column>> holders(group_by_ids_.size() + aggr_ids_.size());
+    std::vector<const Column*> key_columns;
+    std::vector<const Column*> aggr_columns;
+    for (size_t i = 0; i < group_by_ids_.size(); ++i) {
+        key_columns.push_back(GetTransformInput(batch, group_by_ids_[i], group_by_transforms_[i], holders[i]));
+    }
+    for (size_t i = 0; i < aggr_ids_.size(); ++i) {
+        aggr_columns.push_back(GetTransformInput(batch, aggr_ids_[i], transforms_[i], holders[group_by_ids_.size() + i]));
+    }
+    std::vector<uint64_t> hashes;
+    std::vector<std::vector<std::string>> empty_group_names;
+    int64_t row_count = key_columns.front()->GetRowCount();
+    if (row_count == 0) {
+        return;
+    }
+    hashes.resize(row_count);
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        hashes[i] = seed_;
+    }
+    for (size_t i = 0; i < group_by_ids_.size(); ++i) {
+        const AggregationTransform& transform = group_by_transforms_[i];
+        key_columns[i]->MergeHashes(
+            hashes,
+            empty_group_names,
+            transform.HasValue() ? transform.fn : std::function<CellTypes(const CellTypes&)>{}
+        );
+    }
+    std::vector<uint64_t> single_row(1);
+    for (uint64_t row_id = 0; row_id < hashes.size(); ++row_id) {
+        uint64_t hash = hashes[row_id];
+        auto it = hash_to_group_id_.find(hash);
+        uint64_t current_group_id;
+        if (it == hash_to_group_id_.end()) {
+            current_group_id = group_name_.size();
+            hash_to_group_id_.emplace(hash, current_group_id);
+            group_name_.push_back(BuildGroupKeyNames(key_columns, group_by_transforms_, row_id, memory_resource_));
+            std::vector<std::unique_ptr<IAccumulator>> accumulators = CreateGroupAccumulators(current_group_id);
+            group_to_accumulators_.push_back(std::move(accumulators));
+        } else {
+            current_group_id = it->second;
+        }
+        single_row[0] = row_id;
+        int aggr_col_id = 0;
+        for (auto& accumulator : group_to_accumulators_[current_group_id]) {
+            accumulator->Update(aggr_columns[aggr_col_id], single_row);
+            ++aggr_col_id;
+        }
+    }
+}
+
+void GroupByAggregationOperator::MergeFrom(IOperator& other) {
+    auto& partial = dynamic_cast<GroupByAggregationOperator&>(other);
+    partial.ConsumeChild();
+    ConsumeChild();
+    std::vector<uint64_t> partial_hashes(partial.group_name_.size());
+    for (const auto& [hash, group_id] : partial.hash_to_group_id_) {
+        partial_hashes[group_id] = hash;
+    }
+    std::vector<int64_t> group_map(partial_hashes.size());
+    for (size_t partial_id = 0; partial_id < partial_hashes.size(); ++partial_id) {
+        auto [it, is_new] = hash_to_group_id_.emplace(partial_hashes[partial_id], group_name_.size());
+        if (is_new) {
+            group_name_.emplace_back(partial.group_name_[partial_id], memory_resource_);
+            group_to_accumulators_.push_back(CreateGroupAccumulators(it->second));
+        }
+        group_map[partial_id] = it->second;
+        auto& accumulators = group_to_accumulators_[it->second];
+        for (size_t k = 0; k < accumulators.size(); ++k) {
+            if (op_[k] == Op::CountDistinct && !is_approx_distinct_) {
+                continue;
             }
+            accumulators[k]->Merge(*partial.group_to_accumulators_[partial_id][k]);
         }
     }
-    if (group_id < 0) {
-        is_consumed_ = true;
-        return std::move(result_batch_);
+    for (size_t i = 0; i < partial.distinct_states_.size(); ++i) {
+        if (partial.distinct_states_[i] == nullptr) {
+            continue;
+        }
+        if (distinct_states_[i] == nullptr) {
+            distinct_states_[i] = std::make_unique<GroupedDistinctState>(memory_resource_);
+        }
+        distinct_states_[i]->Merge(*partial.distinct_states_[i], group_map);
+    }
+}
+
+void GroupByAggregationOperator::AppendGroupToResult(int64_t group_id) {
+    const GroupKey& keys = group_name_[group_id];
+    for (size_t j = 0; j < keys.size(); ++j) {
+        result_batch_.value()[j]->AddCell(std::string(keys[j]));
+    }
+    size_t offset = keys.size();
+    for (size_t k = 0; k < aggr_col_names_.size(); ++k) {
+        result_batch_.value()[offset + k]->AddCell(group_to_accumulators_[group_id][k]->GetResult());
     }
-    for (uint64_t i = 0; i <= group_id; ++i) {
-        std::vector<std::string> keys = group_name[i];
-        for (int64_t j = 0; j < keys.size(); ++j) {
-            result_batch_.value()[j]->AddCell(keys[j]);
+}
+
+int GroupByAggregationOperator::CompareGroups(int64_t lhs, int64_t rhs, const std::vector<int>& col_ids) const {
+    const int key_count = static_cast<int>(group_by_fields_.size());
+    for (int col_id : col_ids) {
+        int result = col_id < key_count
+            ? CompareResults(group_name_[lhs][col_id], group_name_[rhs][col_id])
+            : group_to_accumulators_[lhs][col_id - key_count]->CompareResult(*group_to_accumulators_[rhs][col_id - key_count]);
+        if (result != 0) {
+            return result;
         }
-        int64_t offset = keys.size();
-        for (int64_t k = 0; k < aggr_col_names_.size(); ++k) {
-            result_batch_.value()[offset + k]->AddCell(group_to_accumulators[i][k]->GetResult());
+    }
+    return 0;
+}
+
+std::optional<Batch> GroupByAggregationOperator::Next() {
+    if (is_consumed_) {
+        return std::nullopt;
+    }
+    ConsumeChild();
+    for (size_t i = 0; i < group_name_.size(); ++i) {
+        AppendGroupToResult(i);
+    }
+    is_consumed_ = true;
+    return std::move(result_batch_);
+}
+
+std::optional<Batch> GroupByOrderByLimitKOperator::Next() {
+    if (is_consumed_) {
+        return std::nullopt;
+    }
+    ConsumeChild();
+    const int64_t group_count = static_cast<int64_t>(group_name_.size());
+    const size_t limit = static_cast<size_t>(std::min<int64_t>(std::max(k_, 0), group_count));
+    auto comp = [&](int64_t a, int64_t b) {
+        int result = CompareGroups(a, b, order_by_ids_);
+        return is_desc_ ? result > 0 : result < 0;
+    };
+    std::vector<int64_t> heap;
+    heap.reserve(limit);
+    for (int64_t group_id = 0; group_id < group_count && limit > 0; ++group_id) {
+        if (heap.size() < limit) {
+            heap.push_back(group_id);
+            std::push_heap(heap.begin(), heap.end(), comp);
+        } else if (comp(group_id, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), comp);
+            heap.back() = group_id;
+            std::push_heap(heap.begin(), heap.end(), comp);
         }
     }
+    std::sort_heap(heap.begin(), heap.end(), comp);
+    for (int64_t group_id : heap) {
+        AppendGroupToResult(group_id);
+    }
     is_consumed_ = true;
     return std::move(result_batch_);
 }
 
 OrderByLimitKOperator::OrderByLimitKOperator(std::unique_ptr<IOperator> child, int k, bool is_desc, const std::vector<int>& order_by_ids, const Scheme& scheme) : child_(std::move(child)), k_(k), order_by_ids_(order_by_ids), is_desc_(is_desc) {
+    curr_ids_ = child_->GetCurrColIds();
+    if (!order_by_ids_.empty()) {
+        int column_id = child_->GetCurrColIds()[order_by_ids_.front()];
+        threshold_filter_ = std::make_unique<TopKThresholdFilter>(column_id, is_desc_, order_by_ids_.size() == 1);
+        child_->AddBatchFilter(threshold_filter_.get());
+    }
 }
 
-std::optional<Batch> OrderByLimitKOperator::Next() {
-    auto curr_ids = child_->GetCurrColIds();
-    auto comp = [&](const std::vector<CellTypes>& a, const std::vector<CellTypes>& b) {
-        for (size_t i = 0; i < order_by_ids_.size(); ++i) {
-            size_t col_idx = order_by_ids_[i];
-            
-            if (a[col_idx] == b[col_idx]) {
-                continue;
-            }
-            
-            bool is_less = a[col_idx] < b[col_idx];
-            return is_desc_ ? !is_less : is_less;
+void OrderByLimitKOperator::EnableStatsOrderedScan() {
+    if (!order_by_ids_.empty()) {
+        child_->OrderBatchesByStats(child_->GetCurrColIds()[order_by_ids_.front()], is_desc_);
+    }
+}
+
+bool OrderByLimitKOperator::IsBefore(const std::vector<CellTypes>& lhs, const std::vector<CellTypes>& rhs) const {
+    for (int col_idx : order_by_ids_) {
+        if (lhs[col_idx] == rhs[col_idx]) {
+            continue;
         }
-        return false;
-    };
-    std::priority_queue<std::vector<CellTypes>, std::vector<std::vector<CellTypes>>, decltype(comp)> top_k(comp);
-    while (auto batch = child_->Next()) {
-        if (!result_batch_.has_value()) {
-            result_batch_ = std::vector<std::unique_ptr<Column>>();
-            for (int64_t c : curr_ids) {
-                if (dynamic_cast<const Int16*>(batch.value()[c].get()) != nullptr) {
-                    result_batch_.value().push_back(std::make_unique<Int16>());
-                } else if (dynamic_cast<const Int32*>(batch.value()[c].get()) != nullptr) {
-                    result_batch_.value().push_back(std::make_unique<Int32>());
-                } else if (dynamic_cast<const Int64*>(batch.value()[c].get()) != nullptr) {
-                    result_batch_.value().push_back(std::make_unique<Int64>());
-                } else if (dynamic_cast<const Date*>(batch.value()[c].get()) != nullptr) {
-                    result_batch_.value().push_back(std::make_unique<Date>());
-                } else if (dynamic_cast<const Timestamp*>(batch.value()[c].get()) != nullptr) {
-                    result_batch_.value().push_back(std::make_unique<Timestamp>());
-                } else if (dynamic_cast<const String*>(batch.value()[c].get()) != nullptr) {
-                    result_batch_.value().push_back(std::make_unique<String>());
-                } else if (dynamic_cast<const Double*>(batch.value()[c].get()) != nullptr) {
-                    result_batch_.value().push_back(std::make_unique<Double>());
-                }
-            }
+        bool is_less = lhs[col_idx] < rhs[col_idx];
+        return is_desc_ ? !is_less : is_less;
+    }
+    return false;
+}
+
+void OrderByLimitKOperator::PushRow(std::vector<CellTypes> row) {
+    auto comp = [this](const std::vector<CellTypes>& a, const std::vector<CellTypes>& b) { return IsBefore(a, b); };
+    if (top_k_.size() < static_cast<size_t>(k_)) {
+        top_k_.push_back(std::move(row));
+        std::push_heap(top_k_.begin(), top_k_.end(), comp);
+    } else if (k_ > 0 && IsBefore(row, top_k_.front())) {
+        std::pop_heap(top_k_.begin(), top_k_.end(), comp);
+        top_k_.back() = std::move(row);
+        std::push_heap(top_k_.begin(), top_k_.end(), comp);
+    }
+}
+
+void OrderByLimitKOperator::ConsumeChild() {
+    if (is_input_consumed_) {
+        return;
+    }
+    is_input_consumed_ = true;
+    child_->Produce([this](Batch& batch) {
+        ConsumeBatch(batch);
+        child_->RecycleBatch(std::move(batch));
+    });
+}
+
+void OrderByLimitKOperator::ConsumeBatch(const Batch& batch) {
+    if (!result_batch_.has_value()) {
+        result_batch_ = std::vector<std::unique_ptr<Column>>();
+        for (int64_t c : curr_ids_) {
+            result_batch_.value().push_back(batch[c]->CreateEmpty());
         }
-        int64_t num_rows = batch.value()[curr_ids.front()]->GetRowCount();
-        int64_t num_cols = batch.value().size();
-        for (int64_t r = 0; r < num_rows; ++r) {
-            std::vector<CellTypes> current_row;
-            current_row.reserve(num_cols);
-            for (int64_t c : curr_ids) {
-                current_row.push_back(batch.value()[c]->Get(r));
-            }
-            if (top_k.size() < k_) {
-                top_k.push(std::move(current_row));
-            } else if (comp(current_row, top_k.top())) {
-                top_k.pop();
-                top_k.push(std::move(current_row));
-            }
+    }
+    int64_t num_rows = batch[curr_ids_.front()]->GetRowCount();
+    for (int64_t r = 0; r < num_rows; ++r) {
+        std::vector<CellTypes> current_row;
+        current_row.reserve(curr_ids_.size());
+        for (int64_t c : curr_ids_) {
+            current_row.push_back(batch[c]->Get(r));
         }
+        PushRow(std::move(current_row));
+    }
+    if (threshold_filter_ != nullptr && k_ > 0 && top_k_.size() == static_cast<size_t>(k_)) {
+        threshold_filter_->SetThreshold(top_k_.front()[order_by_ids_.front()]);
+    }
+}
+
+void OrderByLimitKOperator::MergeFrom(IOperator& other) {
+    auto& partial = dynamic_cast<OrderByLimitKOperator&>(other);
+    partial.ConsumeChild();
+    ConsumeChild();
+    if (!partial.result_batch_.has_value()) {
+        return;
     }
     if (!result_batch_.has_value()) {
-        return std::nullopt;
+        result_batch_ = std::move(partial.result_batch_);
     }
-    if (top_k.empty()) {
-        return std::move(result_batch_);
+    for (auto& row : partial.top_k_) {
+        PushRow(std::move(row));
     }
-    std::vector<std::vector<CellTypes>> final_rows;
-    final_rows.reserve(top_k.size());
-    while (!top_k.empty()) {
-        final_rows.push_back(top_k.top());
-        top_k.pop();
+    partial.top_k_.clear();
+}
+
+std::optional<Batch> OrderByLimitKOperator::Next() {
+    ConsumeChild();
+    if (!result_batch_.has_value()) {
+        return std::nullopt;
     }
-    std::reverse(final_rows.begin(), final_rows.end());
-    for (auto& row : final_rows) {
-        for (size_t c = 0; c < curr_ids.size(); ++c) {
+    auto comp = [this](const std::vector<CellTypes>& a, const std::vector<CellTypes>& b) { return IsBefore(a, b); };
+    std::sort_heap(top_k_.begin(), top_k_.end(), comp);
+    for (auto& row : top_k_) {
+        for (size_t c = 0; c < row.size(); ++c) {
             result_batch_.value()[c]->AddCell(std::move(row[c]));
         }
     }
+    top_k_.clear();
     return std::move(result_batch_);
 }
 
-OrderByOperator::OrderByOperator(std::unique_ptr<IOperator> child, const std::vector<int>& order_by_ids, bool is_desc, const Scheme& scheme) : child_(std::move(child)), order_by_ids_(order_by_ids), is_desc_(is_desc) {
+LateMaterializedTopKOperator::LateMaterializedTopKOperator(
+    std::unique_ptr<IOperator> child,
+    int k,
+    bool is_desc,
+    const std::vector<int>& order_by_ids,
+    const std::string& filename,
+    const std::vector<std::string>& columns,
+    const Scheme& scheme
+) : top_k_(std::make_unique<OrderByLimitKOperator>(std::move(child), k, is_desc, order_by_ids, scheme)),
+    file_(filename, std::ios::binary | std::ios::ate),
+    reader_(file_) {
+    Scheme file_scheme = reader_.GetScheme();
+    auto all_types = file_scheme.GetTypesInfo();
+    for (const auto& name : columns) {
+        int id = file_scheme.GetColumnIndex(name);
+        column_ids_.push_back(id);
+        curr_types_.push_back(all_types[id]);
+    }
+    auto child_ids = top_k_->GetCurrColIds();
+    for (size_t i = 0; i < child_ids.size(); ++i) {
+        if (child_ids[i] == static_cast<int>(all_types.size())) {
+            row_id_position_ = i;
+        }
+    }
+    if (row_id_position_ < 0) {
+        throw std::runtime_error("Late materialization needs a scan with row ids.");
+    }
+}
+
+std::vector<int> LateMaterializedTopKOperator::GetCurrColIds() const {
+    std::vector<int> ids(column_ids_.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        ids[i] = i;
+    }
+    return ids;
+}
+
+std::optional<Batch> LateMaterializedTopKOperator::Next() {
+    if (is_consumed_) {
+        return std::nullopt;
+    }
+    is_consumed_ = true;
+    std::optional<Batch> winners = top_k_->Next();
+    if (!winners.has_value()) {
+        return std::nullopt;
+    }
+    const Column& row_ids = *winners.value()[row_id_position_];
+    int64_t row_count = row_ids.GetRowCount();
+    std::map<int64_t, std::vector<int64_t>> winners_by_batch;
+    for (int64_t r = 0; r < row_count; ++r) {
+        winners_by_batch[GetRowIdBatch(std::get<int64_t>(row_ids.Get(r)))].push_back(r);
+    }
+    std::vector<Batch> slices;
+    std::vector<std::pair<int64_t, int64_t>> locations(row_count);
+    for (const auto& [batch_index, batch_winners] : winners_by_batch) {
+        Batch batch = reader_.ReadBatch(batch_index, column_ids_);
+        Batch slice;
+        for (int id : column_ids_) {
+            slice.push_back(batch[id]->CreateEmpty());
+        }
+        for (size_t i = 0; i < batch_winners.size(); ++i) {
+            int64_t row = GetRowIdRow(std::get<int64_t>(row_ids.Get(batch_winners[i])));
+            for (size_t c = 0; c < column_ids_.size(); ++c) {
+                slice[c]->AppendRange(*batch[column_ids_[c]], row, row + 1);
+            }
+            locations[batch_winners[i]] = {static_cast<int64_t>(slices.size()), static_cast<int64_t>(i)};
+        }
+        slices.push_back(std::move(slice));
+    }
+    Batch result;
+    if (slices.empty()) {
+        for (int64_t type : curr_types_) {
+            result.push_back(CreateColumn(type));
+        }
+        return result;
+    }
+    for (const auto& column : slices.front()) {
+        result.push_back(column->CreateEmpty());
+    }
+    for (const auto& [slice_index, row] : locations) {
+        for (size_t c = 0; c < result.size(); ++c) {
+            result[c]->AppendRange(*slices[slice_index][c], row, row + 1);
+        }
+    }
+    return result;
+}
+
+OrderByOperator::OrderByOperator(std::unique_ptr<IOperator> child, const std::vector<int>& order_by_ids, bool is_desc, const Scheme& scheme) : OrderByOperator(std::move(child), order_by_ids, std::vector<bool>(order_by_ids.size(), is_desc), scheme) {
+}
+
+OrderByOperator::OrderByOperator(std::unique_ptr<IOperator> child, const std::vector<int>& order_by_ids, const std::vector<bool>& is_desc, const Scheme&) : child_(std::move(child)), order_by_ids_(order_by_ids), is_desc_(is_desc) {
+    if (is_desc_.size() != order_by_ids_.size()) {
+        throw std::runtime_error("Sort direction count must match order by column count.");
+    }
+}
+
+std::vector<std::string> OrderByOperator::BuildSortKeys(const Batch& batch, int64_t row_count) const {
+    std::vector<std::string> keys(row_count);
+    for (size_t i = 0; i < order_by_ids_.size(); ++i) {
+        batch[order_by_ids_[i]]->AppendSortKeys(keys, is_desc_[i]);
+    }
+    return keys;
+}
+
+std::vector<std::string> OrderByOperator::SortBatch(Batch& batch) const {
+    int64_t row_count = batch.front()->GetRowCount();
+    auto keys = BuildSortKeys(batch, row_count);
+    std::vector<int64_t> permutation(row_count);
+    for (int64_t i = 0; i < row_count; ++i) {
+        permutation[i] = i;
+    }
+    SortPermutation(permutation, keys);
+    for (auto& column : batch) {
+        column->FilterRows(permutation);
+    }
+    std::vector<std::string> sorted_keys;
+    sorted_keys.reserve(row_count);
+    for (int64_t id : permutation) {
+        sorted_keys.push_back(std::move(keys[id]));
+    }
+    return sorted_keys;
+}
+
+void OrderByOperator::SpillResultBatch() {
+    Batch& batch = result_batch_.value();
+    if (batch.front()->GetRowCount() == 0) {
+        return;
+    }
+    auto keys = SortBatch(batch);
+    std::string path = CreateTempFile("order_by_run_");
+    run_paths_.push_back(path);
+    SortRunWriter writer(path, kSortRunChunkRows);
+    writer.Write(batch, keys);
+    for (auto& column : batch) {
+        column = column->CreateEmpty();
+    }
+}
+
+void OrderByOperator::StartMerge() {
+    for (const auto& path : run_paths_) {
+        runs_.push_back(std::make_unique<SortRunReader>(path, result_batch_.value()));
+    }
+    merge_tree_ = std::make_unique<LoserTree>(runs_.size(), [this](int64_t a, int64_t b) {
+        if (runs_[a]->IsExhausted()) {
+            return false;
+        }
+        if (runs_[b]->IsExhausted()) {
+            return true;
+        }
+        int cmp = runs_[a]->GetKey().compare(runs_[b]->GetKey());
+        return cmp != 0 ? cmp < 0 : a < b;
+    });
+}
+
+std::optional<Batch> OrderByOperator::NextMerged() {
+    Batch batch;
+    for (const auto& column : result_batch_.value()) {
+        batch.push_back(column->CreateEmpty());
+    }
+    int64_t row_count = 0;
+    while (row_count < kSortOutputBatchRows) {
+        int64_t winner = merge_tree_->GetWinner();
+        auto& run = *runs_[winner];
+        if (run.IsExhausted()) {
+            break;
+        }
+        int64_t begin = run.GetRow();
+        int64_t end = begin;
+        bool is_chunk_end = false;
+        do {
+            ++end;
+            ++row_count;
+            is_chunk_end = end == run.GetChunkRowCount();
+            if (is_chunk_end) {
+                break;
+            }
+            run.Advance();
+            merge_tree_->Replay();
+        } while (row_count < kSortOutputBatchRows && merge_tree_->GetWinner() == winner);
+        const Batch& chunk = run.GetChunk();
+        for (size_t c = 0; c < batch.size(); ++c) {
+            batch[c]->AppendRange(*chunk[c], begin, end);
+        }
+        if (is_chunk_end) {
+            run.Advance();
+            merge_tree_->Replay();
+        }
+    }
+    if (row_count == 0) {
+        return std::nullopt;
+    }
+    return batch;
 }
 
 std::optional<Batch> OrderByOperator::Next() {
-    std::vector<std::vector<CellTypes>> final_rows;
+    if (is_consumed_) {
+        if (merge_tree_ == nullptr) {
+            return std::nullopt;
+        }
+        return NextMerged();
+    }
+    is_consumed_ = true;
     auto curr_ids = child_->GetCurrColIds();
-    while (auto batch = child_->Next()) {
+    size_t buffered_bytes = 0;
+    child_->Produce([&](Batch& batch) {
         if (!result_batch_.has_value()) {
             result_batch_ = std::vector<std::unique_ptr<Column>>();
             for (int64_t c : curr_ids) {
-                if (dynamic_cast<const Int16*>(batch.value()[c].get()) != nullptr) {
-                    result_batch_.value().push_back(std::make_unique<Int16>());
-                } else if (dynamic_cast<const Int32*>(batch.value()[c].get()) != nullptr) {
-                    result_batch_.value().push_back(std::make_unique<Int32>());
-                } else if (dynamic_cast<const Int64*>(batch.value()[c].get()) != nullptr) {
-                    result_batch_.value().push_back(std::make_unique<Int64>());
-                } else if (dynamic_cast<const Date*>(batch.value()[c].get()) != nullptr) {
-                    result_batch_.value().push_back(std::make_unique<Date>());
-                } else if (dynamic_cast<const Timestamp*>(batch.value()[c].get()) != nullptr) {
-                    result_batch_.value().push_back(std::make_unique<Timestamp>());
-                } else if (dynamic_cast<const String*>(batch.value()[c].get()) != nullptr) {
-                    result_batch_.value().push_back(std::make_unique<String>());
-                } else if (dynamic_cast<const Double*>(batch.value()[c].get()) != nullptr) {
-                    result_batch_.value().push_back(std::make_unique<Double>());
-                }
+                result_batch_.value().push_back(batch[c]->CreateEmpty());
             }
         }
-        int64_t num_rows = batch.value()[curr_ids.front()]->GetRowCount();
-        int64_t num_cols = batch.value().size();
-        for (int64_t r = 0; r < num_rows; ++r) {
-            std::vector<CellTypes> current_row;
-            current_row.reserve(num_cols);
-            for (int64_t c : curr_ids) {
-                current_row.push_back(batch.value()[c]->Get(r));
-            }
-            final_rows.push_back(std::move(current_row));
+        int64_t num_rows = batch[curr_ids.front()]->GetRowCount();
+        for (size_t c = 0; c < curr_ids.size(); ++c) {
+            result_batch_.value()[c]->AppendRange(*batch[curr_ids[c]], 0, num_rows);
+            buffered_bytes += batch[curr_ids[c]]->GetColumnByteSize();
         }
-    }
+        buffered_bytes += num_rows * sizeof(std::string);
+        for (int id : order_by_ids_) {
+            buffered_bytes += batch[curr_ids[id]]->GetColumnByteSize();
+        }
+        child_->RecycleBatch(std::move(batch));
+        if (memory_limit_ > 0 && buffered_bytes > memory_limit_) {
+            SpillResultBatch();
+            buffered_bytes = 0;
+        }
+    });
     if (!result_batch_.has_value()) {
         return std::nullopt;
     }
-    auto comp = [&](const std::vector<CellTypes>& a, const std::vector<CellTypes>& b) {
-        for (size_t i = 0; i < order_by_ids_.size(); ++i) {
-            size_t col_idx = order_by_ids_[i];
-            
-            if (a[col_idx] == b[col_idx]) {
-                continue;
+    if (run_paths_.empty()) {
+        SortBatch(result_batch_.value());
+        return std::move(result_batch_);
+    }
+    SpillResultBatch();
+    StartMerge();
+    return NextMerged();
+}
+
+OrderByOperator::~OrderByOperator() {
+    runs_.clear();
+    for (const auto& path : run_paths_) {
+        std::remove(path.c_str());
+    }
+}
+
+ParallelOperator::ParallelOperator(PipelineFactory factory, ThreadPool& pool, size_t pipeline_count) : pool_(pool) {
+    if (pipeline_count == 0) {
+        pipeline_count = pool_.GetThreadCount();
+    }
+    auto morsels = std::make_shared<MorselQueue>();
+    for (size_t i = 0; i < pipeline_count; ++i) {
+        pipelines_.push_back(factory(morsels));
+    }
+    is_merge_mode_ = pipelines_.front()->SupportsMerge();
+}
+
+ParallelOperator::~ParallelOperator() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        is_cancelled_ = true;
+    }
+    has_space_.notify_all();
+    tasks_.reset();
+}
+
+void ParallelOperator::MergePipelines() {
+    TaskGroup group(pool_);
+    for (auto& pipeline : pipelines_) {
+        group.Submit([pipeline = pipeline.get()]() { pipeline->ConsumeInput(); });
+    }
+    group.Wait();
+    for (size_t i = 1; i < pipelines_.size(); ++i) {
+        pipelines_.front()->MergeFrom(*pipelines_[i]);
+        pipelines_[i].reset();
+    }
+    pipelines_.resize(1);
+}
+
+void ParallelOperator::RunPipeline(IOperator* pipeline) {
+    bool is_consumer = std::this_thread::get_id() == consumer_thread_;
+    try {
+        while (!is_cancelled_) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (is_consumer && batches_.size() >= max_batches_) {
+                    lock.unlock();
+                    tasks_->Submit([this, pipeline]() { RunPipeline(pipeline); });
+                    return;
+                }
+                has_space_.wait(lock, [this]() { return is_cancelled_ || batches_.size() < max_batches_; });
+            }
+            std::optional<Batch> batch = pipeline->Next();
+            if (!batch.has_value()) {
+                break;
             }
-            
-            bool is_less = a[col_idx] < b[col_idx];
-            return is_desc_ ? !is_less : is_less;
+            std::lock_guard<std::mutex> lock(mutex_);
+            batches_.push_back(std::move(batch.value()));
+            has_batch_.notify_one();
         }
-        return false;
-    };
-    std::sort(final_rows.begin(), final_rows.end(), comp);
-    for (auto& row : final_rows) {
-        for (size_t c = 0; c < curr_ids.size(); ++c) {
-            result_batch_.value()[c]->AddCell(std::move(row[c]));
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --running_;
+        has_batch_.notify_all();
+        throw;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    --running_;
+    has_batch_.notify_all();
+}
+
+void ParallelOperator::StartGather() {
+    tasks_ = std::make_unique<TaskGroup>(pool_);
+    running_ = pipelines_.size();
+    max_batches_ = kGatherBatchesPerPipeline * pipelines_.size();
+    consumer_thread_ = std::this_thread::get_id();
+    for (auto& pipeline : pipelines_) {
+        tasks_->Submit([this, pipeline = pipeline.get()]() { RunPipeline(pipeline); });
+    }
+}
+
+std::optional<Batch> ParallelOperator::Next() {
+    if (!is_started_) {
+        is_started_ = true;
+        if (is_merge_mode_) {
+            MergePipelines();
+        } else {
+            StartGather();
         }
     }
-    return std::move(result_batch_);
+    if (is_merge_mode_) {
+        return pipelines_.front()->Next();
+    }
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (!batches_.empty()) {
+                Batch batch = std::move(batches_.front());
+                batches_.pop_front();
+                has_space_.notify_one();
+                return batch;
+            }
+            if (running_ == 0) {
+                break;
+            }
+        }
+        if (pool_.TryRunTask()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        has_batch_.wait_for(lock, std::chrono::milliseconds(1), [this]() { return !batches_.empty() || running_ == 0; });
+    }
+    tasks_->Wait();
+    return std::nullopt;
 }
@@ -2,22 +2,58 @@
 
 #include "../column_types/column_types.h"
 #include "../file_reader/file_reader.h"
-
+#include "../external_sort/external_sort.h"
+#include "../hyperloglog/hyperloglog.h"
+#include "../expressions/expressions.h"
+#include "../string_functions/string_functions.h"
+#include "../thread_pool/thread_pool.h"
+
+#include <atomic>
+#include <cmath>
 #include <functional>
+#include <limits>
+#include <memory_resource>
 #include <optional>
+#include <stdexcept>
+#include <unordered_map>
 #include <unordered_set>
 
 using Batch = std::vector<std::unique_ptr<Column>>;
+using BatchConsumer = std::function<void(Batch&)>;
+using StatsConsumer = std::function<bool(const BatchBlockStats& stats, int64_t row_count)>;
 
 class IOperator {
 public:
     virtual std::optional<Batch> Next() = 0;
+    virtual void Produce(const BatchConsumer& consumer) {
+        while (std::optional<Batch> batch = Next()) {
+            consumer(batch.value());
+        }
+    }
+    virtual void RecycleBatch(Batch&&) {}
     virtual std::vector<int> GetCurrColIds() const = 0;
     virtual std::vector<int64_t> GetCurrColTypes() const = 0;
     virtual void SetBatchFilter(const class FilterCondition* condition) {}
+    virtual void AddBatchFilter(const class FilterCondition*) {}
+    virtual void OrderBatchesByStats(int, bool) {}
+    virtual const BatchBlockStats* GetCurrentBatchStats() const { return nullptr; }
+    virtual void SetStatsConsumer(StatsConsumer) {}
+    virtual std::optional<uint64_t> EstimateDistinctCount(int) const { return std::nullopt; }
+    virtual bool SupportsMerge() const { return false; }
+    virtual void ConsumeInput() {}
+    virtual void MergeFrom(IOperator&) {
+        throw std::runtime_error("Operator does not support merging partial results.");
+    }
     virtual ~IOperator() = default;
 };
 
+class MorselQueue {
+public:
+    int64_t Pop() { return next_++; }
+protected:
+    std::atomic<int64_t> next_ = 0;
+};
+
 class ScanOperator : public IOperator {
 public:
     ScanOperator(const std::string& filename, const std::vector<std::string>& columns);
@@ -28,22 +64,58 @@ public:
         return curr_types_;
     }
     void SetBatchFilter(const class FilterCondition* condition) override { batch_filter_ = condition; }
+    void AddBatchFilter(const class FilterCondition* condition) override { extra_batch_filters_.push_back(condition); }
+    void OrderBatchesByStats(int column_id, bool is_desc) override;
+    const BatchBlockStats* GetCurrentBatchStats() const override {
+        return current_stats_.has_value() ? &current_stats_.value() : nullptr;
+    }
+    void EnableRowIds();
+    void SetMorselQueue(std::shared_ptr<MorselQueue> morsels) { morsels_ = std::move(morsels); }
+    void SetVectorSize(int64_t rows) { vector_size_ = rows; }
+    void SetDecodePool(ThreadPool* pool) { reader_.SetDecodePool(pool); }
+    void RecycleBatch(Batch&& batch) override { reader_.RecycleBatch(std::move(batch)); }
+    void SetStatsConsumer(StatsConsumer consumer) override { stats_consumer_ = std::move(consumer); }
+    std::optional<uint64_t> EstimateDistinctCount(int column_id) const override;
+
+    static constexpr int64_t kDefaultVectorSize = 65536;
 
     std::optional<Batch> Next() override;
 protected:
+    bool NeedsBatchStats() const;
+    bool CanSkipBatch(const BatchBlockStats& batch_stats, int64_t batch_index) const;
+    std::vector<int> GetReadIds() const;
+    std::optional<Batch> NextRowGroup(int64_t& batch_index);
+    std::optional<Batch> NextMorsel(int64_t& batch_index);
+    void AppendRowIds(Batch& batch, int64_t batch_index, int64_t first_row) const;
+
     std::vector<std::string> columns_;
     std::ifstream file_;
     RowGroupReader reader_;
     std::vector<int> curr_ids_;
     std::vector<int64_t> curr_types_;
     const class FilterCondition* batch_filter_ = nullptr;
+    std::vector<const class FilterCondition*> extra_batch_filters_;
+    std::optional<BatchBlockStats> current_stats_;
+    StatsConsumer stats_consumer_;
+    bool with_row_ids_ = false;
+    std::shared_ptr<MorselQueue> morsels_;
+    int64_t vector_size_ = kDefaultVectorSize;
+    std::optional<Batch> pending_;
+    int64_t pending_batch_index_ = 0;
+    int64_t pending_offset_ = 0;
 };
 
+enum class PruneResult { None, Some, All };
+
+PruneResult PruneCompare(const ColumnBlockStats& stats, Column::Op op, const CellTypes& value);
+
 class FilterCondition {
 public:
     virtual ~FilterCondition() = default;
     virtual bool Evaluate(const Batch& batch, size_t row_index) const = 0;
-    virtual bool CanSkipBatch(const BatchBlockStats& batch_stats) const { return false; }
+    virtual void EvaluateBatch(const Batch& batch, std::vector<int64_t>& row_ids) const;
+    virtual PruneResult Prune(const BatchBlockStats&) const { return PruneResult::Some; }
+    bool CanSkipBatch(const BatchBlockStats& batch_stats) const { return Prune(batch_stats) == PruneResult::None; }
 };
 
 template<typename T>
@@ -54,29 +126,12 @@ public:
     bool Evaluate(const Batch& batch, size_t row_index) const override {
         return batch[scheme_.GetColumnIndex(column_)]->Compare(row_index, op_, value_);
     }
-    bool CanSkipBatch(const BatchBlockStats& batch_stats) const override {
+    PruneResult Prune(const BatchBlockStats& batch_stats) const override {
         const int column_index = scheme_.GetColumnIndex(column_);
         if (column_index < 0 || column_index >= static_cast<int>(batch_stats.size())) {
-            return false;
+            return PruneResult::Some;
         }
-        const ColumnBlockStats& stats = batch_stats[column_index];
-        const CellTypes value = CellTypes(value_);
-
-        switch (op_) {
-            case Op::EQ:
-                return stats.min_value > value || stats.max_value < value;
-            case Op::NE:
-                return stats.min_value == value && stats.max_value == value;
-            case Op::LT:
-                return stats.min_value >= value;
-            case Op::LE:
-                return stats.min_value > value;
-            case Op::GT:
-                return stats.max_value <= value;
-            case Op::GE:
-                return stats.max_value < value;
-        }
-        return false;
+        return PruneCompare(batch_stats[column_index], op_, CellTypes(value_));
     }
 protected:
     std::string column_;
@@ -95,8 +150,11 @@ public:
     bool Evaluate(const Batch& batch, size_t row_index) const override {
         return batch[column_index_]->Compare(row_index, op_, value_);
     }
-    bool CanSkipBatch(const BatchBlockStats& batch_stats) const override {
-        return false;
+    PruneResult Prune(const BatchBlockStats& batch_stats) const override {
+        if (column_index_ < 0 || column_index_ >= static_cast<int>(batch_stats.size())) {
+            return PruneResult::Some;
+        }
+        return PruneCompare(batch_stats[column_index_], op_, value_);
     }
 
 protected:
@@ -105,23 +163,81 @@ protected:
     CellTypes value_;
 };
 
-class LikeFilter : public FilterCondition {
+class TopKThresholdFilter : public FilterCondition {
 public:
-    LikeFilter(const std::string& column, std::string pattern, Scheme scheme)
-        : column_(column), pattern_(std::move(pattern)), scheme_(scheme) {}
+    TopKThresholdFilter(int column_index, bool is_desc, bool skip_ties)
+        : column_index_(column_index), is_desc_(is_desc), skip_ties_(skip_ties) {}
 
     bool Evaluate(const Batch& batch, size_t row_index) const override {
-        const std::string value = batch[scheme_.GetColumnIndex(column_)]->GetCellAsString(row_index);
-        return value.find(pattern_) != std::string::npos;
+        if (!threshold_.has_value()) {
+            return true;
+        }
+        CellTypes value = batch[column_index_]->Get(row_index);
+        return is_desc_ ? value >= threshold_.value() : value <= threshold_.value();
     }
-    bool CanSkipBatch(const BatchBlockStats& batch_stats) const override {
-        return false;
+    PruneResult Prune(const BatchBlockStats& batch_stats) const override {
+        if (!threshold_.has_value() || column_index_ < 0 || column_index_ >= static_cast<int>(batch_stats.size())) {
+            return PruneResult::Some;
+        }
+        const ColumnBlockStats& stats = batch_stats[column_index_];
+        const CellTypes& threshold = threshold_.value();
+        bool can_skip = is_desc_
+            ? (skip_ties_ ? stats.max_value <= threshold : stats.max_value < threshold)
+            : (skip_ties_ ? stats.min_value >= threshold : stats.min_value > threshold);
+        return can_skip ? PruneResult::None : PruneResult::Some;
     }
+    void SetThreshold(CellTypes threshold) { threshold_ = std::move(threshold); }
+
+protected:
+    int column_index_;
+    bool is_desc_;
+    bool skip_ties_;
+    std::optional<CellTypes> threshold_;
+};
+
+class LikeFilter : public FilterCondition {
+public:
+    LikeFilter(const std::string& column, std::string pattern, Scheme scheme)
+        : column_(column), matcher_(pattern), scheme_(scheme) {}
+
+    bool Evaluate(const Batch& batch, size_t row_index) const override;
+    void EvaluateBatch(const Batch& batch, std::vector<int64_t>& row_ids) const override;
+    PruneResult Prune(const BatchBlockStats& batch_stats) const override;
+
+protected:
+    std::string column_;
+    LikeMatcher matcher_;
+    Scheme scheme_;
+};
+
+class InFilter : public FilterCondition {
+public:
+    InFilter(const std::string& column, const std::vector<CellTypes>& values, Scheme scheme);
+
+    bool Evaluate(const Batch& batch, size_t row_index) const override;
+    void EvaluateBatch(const Batch& batch, std::vector<int64_t>& row_ids) const override;
+    PruneResult Prune(const BatchBlockStats& batch_stats) const override;
 
 protected:
+    static constexpr uint64_t kMaxBitmapSpan = uint64_t{1} << 16;
+    static constexpr size_t kMaxSortedArraySize = 16;
+
+    enum class Mode { SortedArray, Bitmap, HashSet };
+
+    bool ContainsInt(int64_t value) const;
+    bool ContainsString(std::string_view value) const;
+    std::optional<int64_t> StatToInt(const CellTypes& value) const;
+
     std::string column_;
-    std::string pattern_;
     Scheme scheme_;
+    int64_t type_;
+    Mode mode_ = Mode::SortedArray;
+    std::vector<int64_t> int_values_;
+    int64_t bitmap_base_ = 0;
+    std::vector<uint64_t> bitmap_;
+    FlatInt64Set int_set_;
+    std::vector<std::string> string_values_;
+    StringHashSet string_set_;
 };
 
 class NotFilter : public FilterCondition {
@@ -131,66 +247,132 @@ public:
     bool Evaluate(const Batch& batch, size_t row_index) const override {
         return !child_->Evaluate(batch, row_index);
     }
-    bool CanSkipBatch(const BatchBlockStats& batch_stats) const override {
-        return false;
-    }
+    void EvaluateBatch(const Batch& batch, std::vector<int64_t>& row_ids) const override;
+    PruneResult Prune(const BatchBlockStats& batch_stats) const override;
 
 protected:
     std::unique_ptr<FilterCondition> child_;
 };
 
-class AndFilter : public FilterCondition {
+class CompositeFilter : public FilterCondition {
 public:
-    AndFilter(std::unique_ptr<FilterCondition> left, std::unique_ptr<FilterCondition> right) : left_(std::move(left)), right_(std::move(right)) {}
-    bool Evaluate(const Batch& batch, size_t row_index) const override {
-        return left_->Evaluate(batch, row_index) && right_->Evaluate(batch, row_index);
-    }
-    bool CanSkipBatch(const BatchBlockStats& batch_stats) const override {
-        return left_->CanSkipBatch(batch_stats) || right_->CanSkipBatch(batch_stats);
-    }
+    size_t GetChildCount() const { return children_.size(); }
+    std::vector<size_t> GetEvaluationOrder() const { return order_; }
 
 protected:
-    std::unique_ptr<FilterCondition> left_;
-    std::unique_ptr<FilterCondition> right_;
-
+    static constexpr int64_t kWarmupBatches = 4;
+    static constexpr int64_t kReorderInterval = 64;
+
+    struct PredicateStats {
+        double rows_in = 0;
+        double rows_out = 0;
+        double min_cost = std::numeric_limits<double>::infinity();
+        double previous_cost = 0;
+
+        double GetCost() const { return std::isinf(min_cost) ? previous_cost : min_cost; }
+    };
+
+    template <typename Same>
+    void AddChild(std::unique_ptr<FilterCondition> child) {
+        if (auto* same = dynamic_cast<Same*>(child.get())) {
+            for (auto& grandchild : same->children_) {
+                AddChild<Same>(std::move(grandchild));
+            }
+            return;
+        }
+        order_.push_back(children_.size());
+        children_.push_back(std::move(child));
+        stats_.emplace_back();
+    }
+    void EvaluateChild(size_t index, const Batch& batch, std::vector<int64_t>& row_ids) const;
+    void FinishBatch() const;
+    virtual double GetRank(const PredicateStats& stats) const = 0;
+
+    std::vector<std::unique_ptr<FilterCondition>> children_;
+    mutable std::vector<size_t> order_;
+    mutable std::vector<PredicateStats> stats_;
+    mutable int64_t batch_count_ = 0;
 };
 
-class OrFilter : public FilterCondition {
+class AndFilter : public CompositeFilter {
 public:
-    OrFilter(std::unique_ptr<FilterCondition> left, std::unique_ptr<FilterCondition> right) : left_(std::move(left)), right_(std::move(right)) {}
-    bool Evaluate(const Batch& batch, size_t row_index) const override {
-        return left_->Evaluate(batch, row_index) || right_->Evaluate(batch, row_index);
-    }
-    bool CanSkipBatch(const BatchBlockStats& batch_stats) const override {
-        return left_->CanSkipBatch(batch_stats) && right_->CanSkipBatch(batch_stats);
-    }
+    AndFilter(std::unique_ptr<FilterCondition> left, std::unique_ptr<FilterCondition> right);
+    explicit AndFilter(std::vector<std::unique_ptr<FilterCondition>> children);
+    bool Evaluate(const Batch& batch, size_t row_index) const override;
+    void EvaluateBatch(const Batch& batch, std::vector<int64_t>& row_ids) const override;
+    PruneResult Prune(const BatchBlockStats& batch_stats) const override;
 
 protected:
-    std::unique_ptr<FilterCondition> left_;
-    std::unique_ptr<FilterCondition> right_;
+    double GetRank(const PredicateStats& stats) const override;
+};
+
+class OrFilter : public CompositeFilter {
+public:
+    OrFilter(std::unique_ptr<FilterCondition> left, std::unique_ptr<FilterCondition> right);
+    explicit OrFilter(std::vector<std::unique_ptr<FilterCondition>> children);
+    bool Evaluate(const Batch& batch, size_t row_index) const override;
+    void EvaluateBatch(const Batch& batch, std::vector<int64_t>& row_ids) const override;
+    PruneResult Prune(const BatchBlockStats& batch_stats) const override;
 
+protected:
+    double GetRank(const PredicateStats& stats) const override;
 };
 
+class ExpressionFilter : public FilterCondition {
+public:
+    explicit ExpressionFilter(ExpressionPtr expression);
+    bool Evaluate(const Batch& batch, size_t row_index) const override;
+    void EvaluateBatch(const Batch& batch, std::vector<int64_t>& row_ids) const override;
+
+protected:
+    ExpressionPtr expression_;
+    std::vector<int> column_ids_;
+};
 
 class FilterOperator : public IOperator {
 public:
     FilterOperator(std::unique_ptr<IOperator> child, std::unique_ptr<FilterCondition> cond) : child_(std::move(child)), condition_(std::move(cond)) {
-        child_->SetBatchFilter(condition_.get());
+        child_->AddBatchFilter(condition_.get());
     }
     std::optional<Batch> Next() override;
+    void Produce(const BatchConsumer& consumer) override;
+    void RecycleBatch(Batch&& batch) override { child_->RecycleBatch(std::move(batch)); }
     std::vector<int> GetCurrColIds() const override;
     std::vector<int64_t> GetCurrColTypes() const override { return child_->GetCurrColTypes(); }
     void SetBatchFilter(const FilterCondition* condition) override { child_->SetBatchFilter(condition); }
+    void AddBatchFilter(const FilterCondition* condition) override { child_->AddBatchFilter(condition); }
+    void OrderBatchesByStats(int column_id, bool is_desc) override { child_->OrderBatchesByStats(column_id, is_desc); }
+    const BatchBlockStats* GetCurrentBatchStats() const override { return child_->GetCurrentBatchStats(); }
+    void SetStatsConsumer(StatsConsumer consumer) override { child_->SetStatsConsumer(std::move(consumer)); }
+    std::optional<uint64_t> EstimateDistinctCount(int column_id) const override { return child_->EstimateDistinctCount(column_id); }
 protected:
+    void FilterBatch(Batch& batch, const std::vector<int>& curr_ids) const;
+
     std::unique_ptr<IOperator> child_;
     std::unique_ptr<FilterCondition> condition_;
 };
 
+class ProjectionOperator : public IOperator {
+public:
+    ProjectionOperator(std::unique_ptr<IOperator> child, std::vector<ExpressionPtr> expressions, const std::vector<std::string>& names);
+    std::optional<Batch> Next() override;
+    void Produce(const BatchConsumer& consumer) override;
+    std::vector<int> GetCurrColIds() const override;
+    std::vector<int64_t> GetCurrColTypes() const override { return scheme_.GetTypesInfo(); }
+    const Scheme& GetScheme() const { return scheme_; }
+    Batch Project(Batch& batch) const;
+protected:
+    std::unique_ptr<IOperator> child_;
+    std::vector<ExpressionPtr> expressions_;
+    Scheme scheme_;
+};
+
 struct AggregationTransform {
     using Fn = std::function<CellTypes(const CellTypes&)>;
 
     Fn fn;
     std::optional<int64_t> output_type;
+    ExpressionPtr expression;
 
     bool HasValue() const {
         return static_cast<bool>(fn);
@@ -204,12 +386,22 @@ struct AggregationTransform {
     }
 };
 
+template <typename T>
+int CompareResults(const T& lhs, const T& rhs) {
+    return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+}
+
 class IAccumulator {
 public:
     virtual ~IAccumulator() = default;
     virtual void Update(const Column* column) = 0;
     virtual void Update(const Column* column, const std::vector<uint64_t>& mask) = 0;
+    virtual void Merge(const IAccumulator& other) = 0;
     virtual CellTypes GetResult() const = 0;
+    virtual int CompareResult(const IAccumulator& other) const { return CompareResults(GetResult(), other.GetResult()); }
+    virtual bool SupportsStats() const { return false; }
+    virtual bool CanUseStats(const ColumnBlockStats&) const { return SupportsStats(); }
+    virtual void UpdateFromStats(const ColumnBlockStats&, int64_t) {}
 };
 
 class SumIntAccumulator : public IAccumulator {
@@ -217,7 +409,12 @@ public:
     explicit SumIntAccumulator(AggregationTransform transform = {}) : transform_(std::move(transform)) {}
     void Update(const Column* column) override;
     void Update(const Column* column, const std::vector<uint64_t>& mask) override;
+    void Merge(const IAccumulator& other) override;
+    bool SupportsStats() const override { return !transform_.HasValue(); }
+    bool CanUseStats(const ColumnBlockStats& stats) const override;
+    void UpdateFromStats(const ColumnBlockStats& stats, int64_t row_count) override;
     CellTypes GetResult() const override { return static_cast<int64_t>(sum_); }
+    int CompareResult(const IAccumulator& other) const override;
     __int128_t GetWideResult() const { return sum_; }
 protected:
     AggregationTransform transform_;
@@ -229,7 +426,12 @@ public:
     explicit SumFloatAccumulator(AggregationTransform transform = {}) : transform_(std::move(transform)) {}
     void Update(const Column* column) override;
     void Update(const Column* column, const std::vector<uint64_t>& mask) override;
-    CellTypes GetResult() const { return sum_; }
+    void Merge(const IAccumulator& other) override;
+    bool SupportsStats() const override { return !transform_.HasValue(); }
+    bool CanUseStats(const ColumnBlockStats& stats) const override;
+    void UpdateFromStats(const ColumnBlockStats& stats, int64_t row_count) override;
+    CellTypes GetResult() const override { return sum_; }
+    int CompareResult(const IAccumulator& other) const override;
 protected:
     AggregationTransform transform_;
     double sum_ = 0;
@@ -240,6 +442,10 @@ public:
     AvgAccumulator(std::unique_ptr<IAccumulator> sum_accumulator) : sum_accumulator_(std::move(sum_accumulator)) {}
     void Update(const Column* column) override;
     void Update(const Column* column, const std::vector<uint64_t>& mask) override;
+    void Merge(const IAccumulator& other) override;
+    bool SupportsStats() const override { return sum_accumulator_->SupportsStats(); }
+    bool CanUseStats(const ColumnBlockStats& stats) const override;
+    void UpdateFromStats(const ColumnBlockStats& stats, int64_t row_count) override;
     CellTypes GetResult() const override;
 protected:
     std::unique_ptr<IAccumulator> sum_accumulator_;
@@ -250,9 +456,13 @@ class CountAccumulator : public IAccumulator {
 public:
     void Update(const Column* column) override;
     void Update(const Column* column, const std::vector<uint64_t>& mask) override;
+    void Merge(const IAccumulator& other) override;
+    bool SupportsStats() const override { return true; }
+    void UpdateFromStats(const ColumnBlockStats& stats, int64_t row_count) override;
     CellTypes GetResult() const override {
         return count_;
     }
+    int CompareResult(const IAccumulator& other) const override;
 protected:
     int64_t count_ = 0;
 };
@@ -262,9 +472,13 @@ public:
     MinAccumulator() = default;
     void Update(const Column* column) override;
     void Update(const Column* column, const std::vector<uint64_t>& mask) override;
+    void Merge(const IAccumulator& other) override;
+    bool SupportsStats() const override { return true; }
+    void UpdateFromStats(const ColumnBlockStats& stats, int64_t row_count) override;
     CellTypes GetResult() const override {
         return min_;
     }
+    int CompareResult(const IAccumulator& other) const override;
 
 protected:
     CellTypes min_;
@@ -276,9 +490,13 @@ public:
     MaxAccumulator() = default;
     void Update(const Column* column) override;
     void Update(const Column* column, const std::vector<uint64_t>& mask) override;
+    void Merge(const IAccumulator& other) override;
+    bool SupportsStats() const override { return true; }
+    void UpdateFromStats(const ColumnBlockStats& stats, int64_t row_count) override;
     CellTypes GetResult() const override {
         return max_;
     }
+    int CompareResult(const IAccumulator& other) const override;
 
 protected:
     CellTypes max_;
@@ -292,11 +510,12 @@ public:
     CountDistinctIntAccumulator() = default;
     void Update(const Column* column) override;
     void Update(const Column* column, const std::vector<uint64_t>& mask) override;
+    void Merge(const IAccumulator& other) override;
     CellTypes GetResult() const override {
-        return static_cast<int64_t>(set_.size());
+        return static_cast<int64_t>(set_.Size());
     }
 protected:
-    std::unordered_set<int64_t> set_;
+    Int64DistinctSet set_;
 };
 
 class CountDistinctStringAccumulator : public IAccumulator {
@@ -304,17 +523,70 @@ public:
     CountDistinctStringAccumulator() = default;
     void Update(const Column* column) override;
     void Update(const Column* column, const std::vector<uint64_t>& mask) override;
+    void Merge(const IAccumulator& other) override;
     CellTypes GetResult() const override {
-        return static_cast<int64_t>(set_.size());
+        return static_cast<int64_t>(set_.Size());
     }
 protected:
-    std::unordered_set<std::string> set_;
+    StringHashSet set_;
+};
+
+class GroupedDistinctState {
+public:
+    explicit GroupedDistinctState(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : pairs_(resource), strings_(resource), counts_(resource) {}
+    void Update(int64_t group_id, const Column* column, const std::vector<uint64_t>& mask);
+    void Merge(const GroupedDistinctState& other, const std::vector<int64_t>& group_map);
+    void MergeGroup(const GroupedDistinctState& other, int64_t other_group_id, int64_t group_id);
+    int64_t GetCount(int64_t group_id) const {
+        return group_id < static_cast<int64_t>(counts_.size()) ? counts_[group_id] : 0;
+    }
+protected:
+    void Insert(int64_t group_id, int64_t value);
+    std::vector<int64_t> MapStrings(const GroupedDistinctState& other);
+
+    FlatPairSet pairs_;
+    StringHashSet strings_;
+    std::pmr::vector<int64_t> counts_;
+};
+
+class GroupedCountDistinctAccumulator : public IAccumulator {
+public:
+    GroupedCountDistinctAccumulator(GroupedDistinctState* state, int64_t group_id) : state_(state), group_id_(group_id) {}
+    void Update(const Column* column) override;
+    void Update(const Column* column, const std::vector<uint64_t>& mask) override;
+    void Merge(const IAccumulator& other) override;
+    CellTypes GetResult() const override {
+        return state_->GetCount(group_id_);
+    }
+    int CompareResult(const IAccumulator& other) const override;
+protected:
+    GroupedDistinctState* state_;
+    int64_t group_id_;
+};
+
+class ApproxCountDistinctAccumulator : public IAccumulator {
+public:
+    explicit ApproxCountDistinctAccumulator(uint8_t precision = HyperLogLog::kDefaultPrecision, AggregationTransform transform = {})
+        : sketch_(precision), transform_(std::move(transform)) {}
+    void Update(const Column* column) override;
+    void Update(const Column* column, const std::vector<uint64_t>& mask) override;
+    void Merge(const IAccumulator& other) override;
+    CellTypes GetResult() const override {
+        return static_cast<int64_t>(sketch_.Estimate());
+    }
+    void SetPrecision(uint8_t precision) { sketch_ = HyperLogLog(precision); }
+    const HyperLogLog& GetSketch() const { return sketch_; }
+protected:
+    HyperLogLog sketch_;
+    AggregationTransform transform_;
+    std::vector<uint64_t> hashes_;
 };
 
 
 class GlobalAggregationOperator : public IOperator {
 public:
-    enum class Op {SUM, AVG, COUNT, MIN, MAX, CountDistinct};
+    enum class Op {SUM, AVG, COUNT, MIN, MAX, CountDistinct, ApproxCountDistinct};
     GlobalAggregationOperator(const std::vector<std::string>& columns, std::unique_ptr<IOperator> child, std::vector<Op> op, const Scheme& scheme, std::vector<AggregationTransform> transforms = {})
         : columns_(columns), child_(std::move(child)), op_(op), scheme_(scheme), transforms_(std::move(transforms)) {
         Init();
@@ -328,9 +600,16 @@ public:
         return result;
     }
     std::vector<int64_t> GetCurrColTypes() const override { return curr_types_; }
+    void SetApproxPrecision(uint8_t precision);
+    bool SupportsMerge() const override { return true; }
+    void ConsumeInput() override { ConsumeChild(); }
+    void MergeFrom(IOperator& other) override;
+    void ConsumeBatch(const Batch& batch);
 
 protected:
     void Init();
+    void ConsumeChild();
+    bool CanUseStats() const;
 protected:
     std::vector<std::unique_ptr<IAccumulator>> accumulators_;
     std::vector<std::string> columns_;
@@ -340,8 +619,12 @@ protected:
     std::optional<Batch> result_batch_;
     std::vector<int64_t> curr_types_;
     std::vector<AggregationTransform> transforms_;
+    std::vector<int> column_ids_;
+    bool is_input_consumed_ = false;
 };
 
+using GroupKey = std::pmr::vector<std::pmr::string>;
+
 class GroupByAggregationOperator : public IOperator {
 public:
     using Op = GlobalAggregationOperator::Op;
@@ -372,9 +655,22 @@ public:
         return result;
     }
     std::vector<int64_t> GetCurrColTypes() const override { return curr_types_; }
+    void SetApproxPrecision(uint8_t precision);
+    void SetApproxDistinct(bool is_approx) { is_approx_distinct_ = is_approx; }
+    void SetMemoryResource(std::pmr::memory_resource* resource);
+    bool SupportsMerge() const override { return true; }
+    void ConsumeInput() override { ConsumeChild(); }
+    void MergeFrom(IOperator& other) override;
+    void ConsumeBatch(const Batch& batch);
 protected:
-    std::vector<std::unique_ptr<IAccumulator>> CreateGroupAccumulators() const;
+    static constexpr uint64_t kMaxReservedGroups = 1 << 20;
+
+    std::vector<std::unique_ptr<IAccumulator>> CreateGroupAccumulators(int64_t group_id);
     void InitResultBatch();
+    void ReserveGroups();
+    void ConsumeChild();
+    void AppendGroupToResult(int64_t group_id);
+    int CompareGroups(int64_t lhs, int64_t rhs, const std::vector<int>& col_ids) const;
 protected:
     std::vector<Op> op_;
     std::vector<std::string> group_by_fields_;
@@ -385,8 +681,51 @@ protected:
     std::optional<Batch> result_batch_;
     std::vector<int64_t> curr_types_;
     bool is_consumed_ = false;
+    bool is_input_consumed_ = false;
     std::vector<AggregationTransform> transforms_;
     std::vector<AggregationTransform> group_by_transforms_;
+    std::vector<int> aggr_ids_;
+    std::vector<int> group_by_ids_;
+    std::unordered_map<uint64_t, int64_t> hash_to_group_id_;
+    std::vector<GroupKey> group_name_;
+    std::vector<std::vector<std::unique_ptr<IAccumulator>>> group_to_accumulators_;
+    std::pmr::memory_resource* memory_resource_ = std::pmr::get_default_resource();
+    uint8_t approx_precision_ = HyperLogLog::kDefaultPrecision;
+    bool is_approx_distinct_ = false;
+    std::vector<std::unique_ptr<GroupedDistinctState>> distinct_states_;
+};
+
+class GroupByOrderByLimitKOperator : public GroupByAggregationOperator {
+public:
+    GroupByOrderByLimitKOperator(
+        std::unique_ptr<IOperator> child,
+        const std::vector<std::string>& group_by_fields,
+        const std::vector<std::string>& aggr_col_names,
+        const std::vector<Op>& op,
+        const Scheme& scheme,
+        int k,
+        bool is_desc,
+        const std::vector<int>& order_by_ids,
+        std::vector<AggregationTransform> transforms = {},
+        std::vector<AggregationTransform> group_by_transforms = {}
+    )
+        : GroupByAggregationOperator(
+              std::move(child),
+              group_by_fields,
+              aggr_col_names,
+              op,
+              scheme,
+              std::move(transforms),
+              std::move(group_by_transforms)
+          ),
+          k_(k),
+          is_desc_(is_desc),
+          order_by_ids_(order_by_ids) {}
+    std::optional<Batch> Next() override;
+protected:
+    int k_;
+    bool is_desc_;
+    std::vector<int> order_by_ids_;
 };
 
 class OrderByLimitKOperator : public IOperator {
@@ -395,23 +734,105 @@ public:
     std::optional<Batch> Next() override;
     std::vector<int> GetCurrColIds() const override { return child_->GetCurrColIds(); }
     std::vector<int64_t> GetCurrColTypes() const override { return child_->GetCurrColTypes(); }
+    void EnableStatsOrderedScan();
+    bool SupportsMerge() const override { return true; }
+    void ConsumeInput() override { ConsumeChild(); }
+    void MergeFrom(IOperator& other) override;
+    void ConsumeBatch(const Batch& batch);
 protected:
+    void ConsumeChild();
+    bool IsBefore(const std::vector<CellTypes>& lhs, const std::vector<CellTypes>& rhs) const;
+    void PushRow(std::vector<CellTypes> row);
+
     std::unique_ptr<IOperator> child_;
     int k_;
     std::vector<int> order_by_ids_;
     bool is_desc_;
     std::optional<Batch> result_batch_;
+    std::unique_ptr<TopKThresholdFilter> threshold_filter_;
+    std::vector<int> curr_ids_;
+    std::vector<std::vector<CellTypes>> top_k_;
+    bool is_input_consumed_ = false;
+};
+
+class LateMaterializedTopKOperator : public IOperator {
+public:
+    LateMaterializedTopKOperator(
+        std::unique_ptr<IOperator> child,
+        int k,
+        bool is_desc,
+        const std::vector<int>& order_by_ids,
+        const std::string& filename,
+        const std::vector<std::string>& columns,
+        const Scheme& scheme
+    );
+    std::optional<Batch> Next() override;
+    std::vector<int> GetCurrColIds() const override;
+    std::vector<int64_t> GetCurrColTypes() const override { return curr_types_; }
+    void EnableStatsOrderedScan() { top_k_->EnableStatsOrderedScan(); }
+protected:
+    std::unique_ptr<OrderByLimitKOperator> top_k_;
+    std::ifstream file_;
+    RowGroupReader reader_;
+    std::vector<int> column_ids_;
+    std::vector<int64_t> curr_types_;
+    int row_id_position_ = -1;
+    bool is_consumed_ = false;
 };
 
 class OrderByOperator : public IOperator {
 public:
     OrderByOperator(std::unique_ptr<IOperator> child, const std::vector<int>& order_by_ids, bool is_desc, const Scheme& scheme);
+    OrderByOperator(std::unique_ptr<IOperator> child, const std::vector<int>& order_by_ids, const std::vector<bool>& is_desc, const Scheme& scheme);
     std::optional<Batch> Next() override;
     std::vector<int> GetCurrColIds() const override { return child_->GetCurrColIds(); }
     std::vector<int64_t> GetCurrColTypes() const override { return child_->GetCurrColTypes(); }
+    void SetMemoryLimit(size_t memory_limit_bytes) { memory_limit_ = memory_limit_bytes; }
+    ~OrderByOperator() override;
 protected:
+    std::vector<std::string> BuildSortKeys(const Batch& batch, int64_t row_count) const;
+    std::vector<std::string> SortBatch(Batch& batch) const;
+    void SpillResultBatch();
+    void StartMerge();
+    std::optional<Batch> NextMerged();
+
     std::unique_ptr<IOperator> child_;
     std::vector<int> order_by_ids_;
-    bool is_desc_;
+    std::vector<bool> is_desc_;
     std::optional<Batch> result_batch_;
+    size_t memory_limit_ = 0;
+    bool is_consumed_ = false;
+    std::vector<std::string> run_paths_;
+    std::vector<std::unique_ptr<SortRunReader>> runs_;
+    std::unique_ptr<LoserTree> merge_tree_;
+};
+
+class ParallelOperator : public IOperator {
+public:
+    using PipelineFactory = std::function<std::unique_ptr<IOperator>(std::shared_ptr<MorselQueue>)>;
+    ParallelOperator(PipelineFactory factory, ThreadPool& pool = ThreadPool::GetDefault(), size_t pipeline_count = 0);
+    std::optional<Batch> Next() override;
+    std::vector<int> GetCurrColIds() const override { return pipelines_.front()->GetCurrColIds(); }
+    std::vector<int64_t> GetCurrColTypes() const override { return pipelines_.front()->GetCurrColTypes(); }
+    ~ParallelOperator() override;
+protected:
+    static constexpr size_t kGatherBatchesPerPipeline = 2;
+
+    void MergePipelines();
+    void StartGather();
+    void RunPipeline(IOperator* pipeline);
+
+    ThreadPool& pool_;
+    std::vector<std::unique_ptr<IOperator>> pipelines_;
+    std::unique_ptr<TaskGroup> tasks_;
+    bool is_started_ = false;
+    bool is_merge_mode_ = false;
+    std::mutex mutex_;
+    std::condition_variable has_batch_;
+    std::condition_variable has_space_;
+    std::deque<Batch> batches_;
+    size_t max_batches_ = 0;
+    std::thread::id consumer_thread_;
+    size_t running_ = 0;
+    std::atomic<bool> is_cancelled_ = false;
 };
@@ -0,0 +1,81 @@
+#include "query_arena.h"
+
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+
+QueryArena::QueryArena(bool use_huge_pages, size_t block_size)
+    : block_size_(block_size), use_huge_pages_(use_huge_pages) {
+    if (block_size_ == 0) {
+        throw std::runtime_error("Arena block size must be positive");
+    }
+}
+
+QueryArena::~QueryArena() {
+    Release();
+}
+
+void QueryArena::Release() {
+    std::lock_guard lock(mutex_);
+    for (const Block& block : blocks_) {
+        munmap(block.data, block.size);
+    }
+    blocks_.clear();
+    current_ = nullptr;
+    remaining_ = 0;
+    bytes_allocated_ = 0;
+    bytes_reserved_ = 0;
+}
+
+size_t QueryArena::GetBytesAllocated() const {
+    std::lock_guard lock(mutex_);
+    return bytes_allocated_;
+}
+
+size_t QueryArena::GetBytesReserved() const {
+    std::lock_guard lock(mutex_);
+    return bytes_reserved_;
+}
+
+size_t QueryArena::GetBlockCount() const {
+    std::lock_guard lock(mutex_);
+    return blocks_.size();
+}
+
+void* QueryArena::do_allocate(size_t bytes, size_t alignment) {
+    std::lock_guard lock(mutex_);
+    size_t padding = (alignment - reinterpret_cast<uintptr_t>(current_) % alignment) % alignment;
+    if (current_ == nullptr || padding + bytes > remaining_) {
+        MapBlock(bytes + alignment);
+        padding = (alignment - reinterpret_cast<uintptr_t>(current_) % alignment) % alignment;
+    }
+    char* result = current_ + padding;
+    current_ = result + bytes;
+    remaining_ -= padding + bytes;
+    bytes_allocated_ += bytes;
+    return result;
+}
+
+void QueryArena::do_deallocate(void*, size_t, size_t) {}
+
+bool QueryArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+void QueryArena::MapBlock(size_t min_size) {
+    size_t size = (min_size + block_size_ - 1) / block_size_ * block_size_;
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+#ifdef MADV_HUGEPAGE
+    if (use_huge_pages_) {
+        madvise(data, size, MADV_HUGEPAGE);
+    }
+#endif
+    blocks_.push_back(Block{data, size});
+    current_ = static_cast<char*>(data);
+    remaining_ = size;
+    bytes_reserved_ += size;
+}
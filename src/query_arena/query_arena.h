@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+class QueryArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kDefaultBlockSize = 2 << 20;
+
+    explicit QueryArena(bool use_huge_pages = false, size_t block_size = kDefaultBlockSize);
+    QueryArena(const QueryArena&) = delete;
+    QueryArena& operator=(const QueryArena&) = delete;
+    ~QueryArena() override;
+    void Release();
+    size_t GetBytesAllocated() const;
+    size_t GetBytesReserved() const;
+    size_t GetBlockCount() const;
+
+protected:
+    struct Block {
+        void* data;
+        size_t size;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    void MapBlock(size_t min_size);
+
+    mutable std::mutex mutex_;
+    std::vector<Block> blocks_;
+    char* current_ = nullptr;
+    size_t remaining_ = 0;
+    size_t bytes_allocated_ = 0;
+    size_t bytes_reserved_ = 0;
+    size_t block_size_;
+    bool use_huge_pages_;
+};
@@ -0,0 +1,635 @@
+#include "regex.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+using Bytes = std::array<uint64_t, 4>;
+
+char EscapedLiteral(char c) {
+    switch (c) {
+        case 'n':
+            return '\n';
+        case 't':
+            return '\t';
+        case 'r':
+            return '\r';
+        default:
+            return c;
+    }
+}
+
+void SetByte(Bytes& bytes, uint8_t c) {
+    bytes[c >> 6] |= uint64_t{1} << (c & 63);
+}
+
+void SetRange(Bytes& bytes, uint8_t from, uint8_t to) {
+    for (int c = from; c <= to; ++c) {
+        SetByte(bytes, static_cast<uint8_t>(c));
+    }
+}
+
+void Merge(Bytes& bytes, const Bytes& other) {
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] |= other[i];
+    }
+}
+
+Bytes Invert(const Bytes& bytes) {
+    Bytes result;
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        result[i] = ~bytes[i];
+    }
+    return result;
+}
+
+struct Node {
+    enum class Kind { Bytes, Concat, Alternate, Repeat, Group, Begin, End };
+
+    Kind kind;
+    Bytes bytes{};
+    std::vector<std::unique_ptr<Node>> children;
+    int64_t min = 0;
+    int64_t max = -1;
+    bool is_greedy = true;
+    int64_t group = -1;
+};
+
+std::unique_ptr<Node> MakeNode(Node::Kind kind) {
+    auto node = std::make_unique<Node>();
+    node->kind = kind;
+    return node;
+}
+
+class Parser {
+public:
+    explicit Parser(std::string_view pattern) : pattern_(pattern) {}
+
+    std::unique_ptr<Node> Parse() {
+        std::unique_ptr<Node> node = ParseAlternate();
+        if (position_ != pattern_.size()) {
+            throw std::runtime_error("Unbalanced parenthesis in regular expression.");
+        }
+        return node;
+    }
+    int64_t GetGroupCount() const { return group_count_; }
+
+protected:
+    bool AtEnd() const { return position_ >= pattern_.size(); }
+    char Peek() const { return pattern_[position_]; }
+
+    std::unique_ptr<Node> ParseAlternate() {
+        auto node = MakeNode(Node::Kind::Alternate);
+        node->children.push_back(ParseConcat());
+        while (!AtEnd() && Peek() == '|') {
+            ++position_;
+            node->children.push_back(ParseConcat());
+        }
+        if (node->children.size() == 1) {
+            return std::move(node->children.front());
+        }
+        return node;
+    }
+
+    std::unique_ptr<Node> ParseConcat() {
+        auto node = MakeNode(Node::Kind::Concat);
+        while (!AtEnd() && Peek() != '|' && Peek() != ')') {
+            node->children.push_back(ParseRepeat());
+        }
+        return node;
+    }
+
+    std::unique_ptr<Node> ParseRepeat() {
+        std::unique_ptr<Node> node = ParseAtom();
+        while (!AtEnd()) {
+            int64_t min = 0;
+            int64_t max = -1;
+            char c = Peek();
+            if (c == '*') {
+                ++position_;
+            } else if (c == '+') {
+                min = 1;
+                ++position_;
+            } else if (c == '?') {
+                max = 1;
+                ++position_;
+            } else if (c == '{') {
+                ++position_;
+                min = ParseNumber();
+                max = min;
+                if (!AtEnd() && Peek() == ',') {
+                    ++position_;
+                    max = !AtEnd() && Peek() == '}' ? -1 : ParseNumber();
+                }
+                if (AtEnd() || Peek() != '}' || (max >= 0 && max < min)) {
+                    throw std::runtime_error("Invalid repetition in regular expression.");
+                }
+                ++position_;
+            } else {
+                break;
+            }
+            auto repeat = MakeNode(Node::Kind::Repeat);
+            repeat->min = min;
+            repeat->max = max;
+            if (!AtEnd() && Peek() == '?') {
+                repeat->is_greedy = false;
+                ++position_;
+            }
+            repeat->children.push_back(std::move(node));
+            node = std::move(repeat);
+        }
+        return node;
+    }
+
+    int64_t ParseNumber() {
+        size_t begin = position_;
+        int64_t value = 0;
+        while (!AtEnd() && Peek() >= '0' && Peek() <= '9') {
+            value = value * 10 + (Peek() - '0');
+            ++position_;
+        }
+        if (begin == position_ || value > 1000) {
+            throw std::runtime_error("Invalid repetition count in regular expression.");
+        }
+        return value;
+    }
+
+    std::unique_ptr<Node> ParseAtom() {
+        char c = pattern_[position_++];
+        if (c == '(') {
+            auto group = MakeNode(Node::Kind::Group);
+            if (pattern_.substr(position_).starts_with("?:")) {
+                position_ += 2;
+            } else {
+                group->group = ++group_count_;
+            }
+            group->children.push_back(ParseAlternate());
+            if (AtEnd() || Peek() != ')') {
+                throw std::runtime_error("Missing ')' in regular expression.");
+            }
+            ++position_;
+            return group;
+        }
+        if (c == '^') {
+            return MakeNode(Node::Kind::Begin);
+        }
+        if (c == '$') {
+            return MakeNode(Node::Kind::End);
+        }
+        if (c == '*' || c == '+' || c == '?' || c == '{') {
+            throw std::runtime_error("Nothing to repeat in regular expression.");
+        }
+        auto node = MakeNode(Node::Kind::Bytes);
+        if (c == '.') {
+            node->bytes = Invert(Bytes{});
+            node->bytes[0] &= ~(uint64_t{1} << '\n');
+        } else if (c == '[') {
+            node->bytes = ParseClass();
+        } else if (c == '\\') {
+            node->bytes = ParseEscape();
+        } else {
+            SetByte(node->bytes, static_cast<uint8_t>(c));
+        }
+        return node;
+    }
+
+    Bytes ParseEscape() {
+        if (AtEnd()) {
+            throw std::runtime_error("Trailing backslash in regular expression.");
+        }
+        char c = pattern_[position_++];
+        Bytes bytes{};
+        switch (c) {
+            case 'd':
+            case 'D':
+                SetRange(bytes, '0', '9');
+                break;
+            case 'w':
+            case 'W':
+                SetRange(bytes, '0', '9');
+                SetRange(bytes, 'a', 'z');
+                SetRange(bytes, 'A', 'Z');
+                SetByte(bytes, '_');
+                break;
+            case 's':
+            case 'S':
+                for (char space : std::string_view(" \t\n\r\f\v")) {
+                    SetByte(bytes, static_cast<uint8_t>(space));
+                }
+                break;
+            default:
+                SetByte(bytes, static_cast<uint8_t>(EscapedLiteral(c)));
+                break;
+        }
+        if (c == 'D' || c == 'W' || c == 'S') {
+            return Invert(bytes);
+        }
+        return bytes;
+    }
+
+    Bytes ParseClass() {
+        Bytes bytes{};
+        bool is_negated = !AtEnd() && Peek() == '^';
+        if (is_negated) {
+            ++position_;
+        }
+        bool is_first = true;
+        while (!AtEnd() && (Peek() != ']' || is_first)) {
+            is_first = false;
+            char c = pattern_[position_++];
+            if (c == '\\') {
+                if (!AtEnd() && std::string_view("dDwWsS").find(Peek()) != std::string_view::npos) {
+                    Merge(bytes, ParseEscape());
+                    continue;
+                }
+                if (AtEnd()) {
+                    throw std::runtime_error("Trailing backslash in regular expression.");
+                }
+                c = EscapedLiteral(pattern_[position_++]);
+            }
+            if (position_ + 1 < pattern_.size() && Peek() == '-' && pattern_[position_ + 1] != ']') {
+                char to = pattern_[position_ + 1];
+                position_ += 2;
+                if (static_cast<uint8_t>(to) < static_cast<uint8_t>(c)) {
+                    throw std::runtime_error("Invalid range in regular expression.");
+                }
+                SetRange(bytes, static_cast<uint8_t>(c), static_cast<uint8_t>(to));
+            } else {
+                SetByte(bytes, static_cast<uint8_t>(c));
+            }
+        }
+        if (AtEnd()) {
+            throw std::runtime_error("Missing ']' in regular expression.");
+        }
+        ++position_;
+        return is_negated ? Invert(bytes) : bytes;
+    }
+
+    std::string_view pattern_;
+    size_t position_ = 0;
+    int64_t group_count_ = 0;
+};
+
+using Instruction = Regex::Instruction;
+using OpCode = Regex::OpCode;
+
+int64_t Emit(std::vector<Instruction>& program, OpCode op, int64_t x = 0, int64_t y = 0) {
+    program.push_back({op, x, y});
+    return program.size() - 1;
+}
+
+void Compile(const Node& node, std::vector<Instruction>& program);
+
+void CompileOptional(const Node& node, bool is_greedy, std::vector<Instruction>& program) {
+    int64_t split = Emit(program, OpCode::Split);
+    Compile(node, program);
+    int64_t body = split + 1;
+    int64_t end = program.size();
+    program[split].x = is_greedy ? body : end;
+    program[split].y = is_greedy ? end : body;
+}
+
+void CompileRepeat(const Node& node, std::vector<Instruction>& program) {
+    const Node& child = *node.children.front();
+    for (int64_t i = 0; i < node.min; ++i) {
+        Compile(child, program);
+    }
+    if (node.max >= 0) {
+        for (int64_t i = node.min; i < node.max; ++i) {
+            CompileOptional(child, node.is_greedy, program);
+        }
+        return;
+    }
+    int64_t split = Emit(program, OpCode::Split);
+    Compile(child, program);
+    Emit(program, OpCode::Jump, split);
+    int64_t body = split + 1;
+    int64_t end = program.size();
+    program[split].x = node.is_greedy ? body : end;
+    program[split].y = node.is_greedy ? end : body;
+}
+
+void Compile(const Node& node, std::vector<Instruction>& program) {
+    switch (node.kind) {
+        case Node::Kind::Bytes: {
+            int64_t pc = Emit(program, OpCode::ByteSet);
+            program[pc].bytes = node.bytes;
+            return;
+        }
+        case Node::Kind::Concat:
+            for (const auto& child : node.children) {
+                Compile(*child, program);
+            }
+            return;
+        case Node::Kind::Alternate: {
+            std::vector<int64_t> jumps;
+            for (size_t i = 0; i + 1 < node.children.size(); ++i) {
+                int64_t split = Emit(program, OpCode::Split);
+                program[split].x = split + 1;
+                Compile(*node.children[i], program);
+                jumps.push_back(Emit(program, OpCode::Jump));
+                program[split].y = program.size();
+            }
+            Compile(*node.children.back(), program);
+            for (int64_t jump : jumps) {
+                program[jump].x = program.size();
+            }
+            return;
+        }
+        case Node::Kind::Repeat:
+            CompileRepeat(node, program);
+            return;
+        case Node::Kind::Group:
+            if (node.group >= 0) {
+                Emit(program, OpCode::Save, 2 * node.group);
+            }
+            Compile(*node.children.front(), program);
+            if (node.group >= 0) {
+                Emit(program, OpCode::Save, 2 * node.group + 1);
+            }
+            return;
+        case Node::Kind::Begin:
+            Emit(program, OpCode::AssertBegin);
+            return;
+        case Node::Kind::End:
+            Emit(program, OpCode::AssertEnd);
+            return;
+    }
+}
+
+bool ReachesMatchAtEnd(const std::vector<Instruction>& program, int64_t pc, bool at_begin, std::vector<uint8_t>& visited) {
+    if (visited[pc]) {
+        return false;
+    }
+    visited[pc] = 1;
+    const Instruction& instruction = program[pc];
+    switch (instruction.op) {
+        case OpCode::Jump:
+            return ReachesMatchAtEnd(program, instruction.x, at_begin, visited);
+        case OpCode::Split:
+            return ReachesMatchAtEnd(program, instruction.x, at_begin, visited) ||
+                   ReachesMatchAtEnd(program, instruction.y, at_begin, visited);
+        case OpCode::Save:
+        case OpCode::AssertEnd:
+            return ReachesMatchAtEnd(program, pc + 1, at_begin, visited);
+        case OpCode::AssertBegin:
+            return at_begin && ReachesMatchAtEnd(program, pc + 1, at_begin, visited);
+        case OpCode::Match:
+            return true;
+        case OpCode::ByteSet:
+            return false;
+    }
+    return false;
+}
+
+void AppendReplacement(std::string& result, std::string_view text, std::string_view replacement, const std::vector<int64_t>& captures) {
+    for (size_t i = 0; i < replacement.size(); ++i) {
+        char c = replacement[i];
+        if (c != '\\' || i + 1 == replacement.size()) {
+            result.push_back(c);
+            continue;
+        }
+        char next = replacement[++i];
+        if (next >= '0' && next <= '9') {
+            size_t group = next - '0';
+            if (2 * group + 1 < captures.size() && captures[2 * group] >= 0 && captures[2 * group + 1] >= 0) {
+                result.append(text.substr(captures[2 * group], captures[2 * group + 1] - captures[2 * group]));
+            }
+        } else {
+            result.push_back(next);
+        }
+    }
+}
+
+} // namespace
+
+Regex::Regex(std::string_view pattern) {
+    Parser parser(pattern);
+    std::unique_ptr<Node> root = parser.Parse();
+    group_count_ = parser.GetGroupCount();
+    Emit(program_, OpCode::Save, 0);
+    Compile(*root, program_);
+    Emit(program_, OpCode::Save, 1);
+    Emit(program_, OpCode::Match);
+}
+
+void Regex::AddClosure(int64_t pc, bool at_begin, std::vector<int64_t>& pcs, std::vector<uint8_t>& visited) const {
+    if (visited[pc]) {
+        return;
+    }
+    visited[pc] = 1;
+    const Instruction& instruction = program_[pc];
+    switch (instruction.op) {
+        case OpCode::Jump:
+            AddClosure(instruction.x, at_begin, pcs, visited);
+            return;
+        case OpCode::Split:
+            AddClosure(instruction.x, at_begin, pcs, visited);
+            AddClosure(instruction.y, at_begin, pcs, visited);
+            return;
+        case OpCode::Save:
+            AddClosure(pc + 1, at_begin, pcs, visited);
+            return;
+        case OpCode::AssertBegin:
+            if (at_begin) {
+                AddClosure(pc + 1, at_begin, pcs, visited);
+            }
+            return;
+        case OpCode::ByteSet:
+        case OpCode::AssertEnd:
+        case OpCode::Match:
+            pcs.push_back(pc);
+            return;
+    }
+}
+
+int32_t Regex::InternState(std::vector<int64_t> pcs) const {
+    std::sort(pcs.begin(), pcs.end());
+    auto it = dfa_index_.find(pcs);
+    if (it != dfa_index_.end()) {
+        return it->second;
+    }
+    if (dfa_states_.size() >= kMaxDfaStates) {
+        dfa_states_.clear();
+        dfa_index_.clear();
+        begin_state_ = -1;
+        ++dfa_generation_;
+    }
+    DfaState state;
+    state.next.fill(-1);
+    state.is_match = std::any_of(pcs.begin(), pcs.end(), [&](int64_t pc) { return program_[pc].op == OpCode::Match; });
+    state.pcs = pcs;
+    int32_t id = dfa_states_.size();
+    dfa_states_.push_back(std::move(state));
+    dfa_index_.emplace(std::move(pcs), id);
+    return id;
+}
+
+int32_t Regex::Step(int32_t state, uint8_t c) const {
+    int32_t cached = dfa_states_[state].next[c];
+    if (cached >= 0) {
+        return cached;
+    }
+    std::vector<int64_t> pcs;
+    std::vector<uint8_t> visited(program_.size(), 0);
+    for (int64_t pc : dfa_states_[state].pcs) {
+        const Instruction& instruction = program_[pc];
+        if (instruction.op == OpCode::ByteSet && instruction.Accepts(c)) {
+            AddClosure(pc + 1, false, pcs, visited);
+        }
+    }
+    AddClosure(0, false, pcs, visited);
+    uint64_t generation = dfa_generation_;
+    int32_t next = InternState(std::move(pcs));
+    if (generation == dfa_generation_) {
+        dfa_states_[state].next[c] = next;
+    }
+    return next;
+}
+
+bool Regex::MatchesAtEnd(int32_t state, bool at_begin) const {
+    DfaState& dfa_state = dfa_states_[state];
+    if (!at_begin && dfa_state.end_match >= 0) {
+        return dfa_state.end_match == 1;
+    }
+    bool result = false;
+    for (int64_t pc : dfa_state.pcs) {
+        if (program_[pc].op != OpCode::AssertEnd) {
+            continue;
+        }
+        std::vector<uint8_t> visited(program_.size(), 0);
+        if (ReachesMatchAtEnd(program_, pc, at_begin, visited)) {
+            result = true;
+            break;
+        }
+    }
+    if (!at_begin) {
+        dfa_state.end_match = result ? 1 : 0;
+    }
+    return result;
+}
+
+bool Regex::Search(std::string_view text) const {
+    if (begin_state_ < 0) {
+        std::vector<int64_t> pcs;
+        std::vector<uint8_t> visited(program_.size(), 0);
+        AddClosure(0, true, pcs, visited);
+        begin_state_ = InternState(std::move(pcs));
+    }
+    int32_t state = begin_state_;
+    for (char c : text) {
+        if (dfa_states_[state].is_match) {
+            return true;
+        }
+        state = Step(state, static_cast<uint8_t>(c));
+    }
+    return dfa_states_[state].is_match || MatchesAtEnd(state, text.empty());
+}
+
+void Regex::AddThread(
+    std::vector<Thread>& threads,
+    int64_t pc,
+    size_t position,
+    std::string_view text,
+    std::vector<int64_t>& captures,
+    std::vector<int64_t>& visited
+) const {
+    if (visited[pc] == static_cast<int64_t>(position)) {
+        return;
+    }
+    visited[pc] = position;
+    const Instruction& instruction = program_[pc];
+    switch (instruction.op) {
+        case OpCode::Jump:
+            AddThread(threads, instruction.x, position, text, captures, visited);
+            return;
+        case OpCode::Split:
+            AddThread(threads, instruction.x, position, text, captures, visited);
+            AddThread(threads, instruction.y, position, text, captures, visited);
+            return;
+        case OpCode::Save: {
+            int64_t saved = captures[instruction.x];
+            captures[instruction.x] = position;
+            AddThread(threads, pc + 1, position, text, captures, visited);
+            captures[instruction.x] = saved;
+            return;
+        }
+        case OpCode::AssertBegin:
+            if (position == 0) {
+                AddThread(threads, pc + 1, position, text, captures, visited);
+            }
+            return;
+        case OpCode::AssertEnd:
+            if (position == text.size()) {
+                AddThread(threads, pc + 1, position, text, captures, visited);
+            }
+            return;
+        case OpCode::ByteSet:
+        case OpCode::Match:
+            threads.push_back({pc, captures});
+            return;
+    }
+}
+
+bool Regex::Find(std::string_view text, size_t start, std::vector<int64_t>& captures) const {
+    std::vector<Thread> current;
+    std::vector<Thread> next;
+    std::vector<int64_t> visited(program_.size(), -1);
+    const std::vector<int64_t> initial(2 * (group_count_ + 1), -1);
+    bool is_matched = false;
+    for (size_t position = start; ; ++position) {
+        if (!is_matched) {
+            std::vector<int64_t> fresh = initial;
+            AddThread(current, 0, position, text, fresh, visited);
+        }
+        if (current.empty()) {
+            break;
+        }
+        for (Thread& thread : current) {
+            const Instruction& instruction = program_[thread.pc];
+            if (instruction.op == OpCode::Match) {
+                is_matched = true;
+                captures = thread.captures;
+                break;
+            }
+            if (position < text.size() && instruction.Accepts(static_cast<uint8_t>(text[position]))) {
+                AddThread(next, thread.pc + 1, position + 1, text, thread.captures, visited);
+            }
+        }
+        if (position >= text.size()) {
+            break;
+        }
+        std::swap(current, next);
+        next.clear();
+    }
+    return is_matched;
+}
+
+std::string Regex::Replace(std::string_view text, std::string_view replacement) const {
+    if (!Search(text)) {
+        return std::string(text);
+    }
+    std::string result;
+    std::vector<int64_t> captures;
+    size_t position = 0;
+    while (position <= text.size() && Find(text, position, captures)) {
+        size_t begin = captures[0];
+        size_t end = captures[1];
+        result.append(text.substr(position, begin - position));
+        AppendReplacement(result, text, replacement, captures);
+        if (end == begin) {
+            if (end < text.size()) {
+                result.push_back(text[end]);
+            }
+            position = end + 1;
+        } else {
+            position = end;
+        }
+    }
+    if (position < text.size()) {
+        result.append(text.substr(position));
+    }
+    return result;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Regex {
+public:
+    explicit Regex(std::string_view pattern);
+    bool Search(std::string_view text) const;
+    bool Find(std::string_view text, size_t start, std::vector<int64_t>& captures) const;
+    std::string Replace(std::string_view text, std::string_view replacement) const;
+    size_t GetGroupCount() const { return group_count_; }
+
+    enum class OpCode : uint8_t { ByteSet, Split, Jump, Save, AssertBegin, AssertEnd, Match };
+
+    struct Instruction {
+        OpCode op;
+        int64_t x = 0;
+        int64_t y = 0;
+        std::array<uint64_t, 4> bytes{};
+
+        bool Accepts(uint8_t c) const { return (bytes[c >> 6] >> (c & 63)) & 1; }
+    };
+
+protected:
+    static constexpr size_t kMaxDfaStates = 4096;
+
+    struct DfaState {
+        std::vector<int64_t> pcs;
+        std::array<int32_t, 256> next;
+        bool is_match = false;
+        int8_t end_match = -1;
+    };
+
+    struct Thread {
+        int64_t pc;
+        std::vector<int64_t> captures;
+    };
+
+    void AddClosure(int64_t pc, bool at_begin, std::vector<int64_t>& pcs, std::vector<uint8_t>& visited) const;
+    int32_t InternState(std::vector<int64_t> pcs) const;
+    int32_t Step(int32_t state, uint8_t c) const;
+    bool MatchesAtEnd(int32_t state, bool at_begin) const;
+    void AddThread(
+        std::vector<Thread>& threads,
+        int64_t pc,
+        size_t position,
+        std::string_view text,
+        std::vector<int64_t>& captures,
+        std::vector<int64_t>& visited
+    ) const;
+
+    std::vector<Instruction> program_;
+    size_t group_count_ = 0;
+    mutable std::vector<DfaState> dfa_states_;
+    mutable std::map<std::vector<int64_t>, int32_t> dfa_index_;
+    mutable int32_t begin_state_ = -1;
+    mutable uint64_t dfa_generation_ = 0;
+};
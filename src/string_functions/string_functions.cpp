@@ -0,0 +1,268 @@
+#include "string_functions.h"
+
+#include <cctype>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+size_t FindSubstring(std::string_view haystack, std::string_view needle) {
+    const size_t needle_size = needle.size();
+    if (needle_size == 0) {
+        return 0;
+    }
+    if (needle_size > haystack.size()) {
+        return std::string_view::npos;
+    }
+    if (needle_size == 1) {
+        const void* found = std::memchr(haystack.data(), needle[0], haystack.size());
+        return found == nullptr ? std::string_view::npos : static_cast<const char*>(found) - haystack.data();
+    }
+    size_t position = 0;
+#if defined(__SSE2__)
+    const __m128i first = _mm_set1_epi8(needle.front());
+    const __m128i last = _mm_set1_epi8(needle.back());
+    for (; position + needle_size - 1 + 16 <= haystack.size(); position += 16) {
+        const char* block = haystack.data() + position;
+        __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+        __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + needle_size - 1));
+        uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last)));
+        while (mask != 0) {
+            uint32_t offset = __builtin_ctz(mask);
+            if (std::memcmp(block + offset + 1, needle.data() + 1, needle_size - 2) == 0) {
+                return position + offset;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+    size_t found = haystack.substr(position).find(needle);
+    return found == std::string_view::npos ? found : position + found;
+}
+
+namespace {
+
+size_t SkipScheme(std::string_view url) {
+    size_t position = url.find("://");
+    if (position == std::string_view::npos) {
+        return url.starts_with("//") ? 2 : 0;
+    }
+    for (size_t i = 0; i < position; ++i) {
+        char c = url[i];
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '+' && c != '-' && c != '.') {
+            return 0;
+        }
+    }
+    return position + 3;
+}
+
+std::string_view GetAuthority(std::string_view url) {
+    size_t begin = SkipScheme(url);
+    size_t end = url.find_first_of("/?#", begin);
+    return url.substr(begin, end == std::string_view::npos ? std::string_view::npos : end - begin);
+}
+
+std::string_view GetPathAndQuery(std::string_view url) {
+    std::string_view authority = GetAuthority(url);
+    size_t begin = authority.data() - url.data() + authority.size();
+    std::string_view rest = url.substr(begin);
+    return rest.substr(0, rest.find('#'));
+}
+
+} // namespace
+
+std::string_view ExtractUrlDomain(std::string_view url) {
+    std::string_view host = GetAuthority(url);
+    size_t at = host.rfind('@');
+    if (at != std::string_view::npos) {
+        host.remove_prefix(at + 1);
+    }
+    size_t colon = host.rfind(':');
+    if (colon != std::string_view::npos && host.find(']', colon) == std::string_view::npos) {
+        host.remove_suffix(host.size() - colon);
+    }
+    return host;
+}
+
+std::string_view ExtractUrlDomainWithoutWww(std::string_view url) {
+    std::string_view host = ExtractUrlDomain(url);
+    if (host.starts_with("www.")) {
+        host.remove_prefix(4);
+    }
+    return host;
+}
+
+std::string_view ExtractUrlPath(std::string_view url) {
+    std::string_view rest = GetPathAndQuery(url);
+    return rest.substr(0, rest.find('?'));
+}
+
+std::string_view ExtractUrlQueryString(std::string_view url) {
+    std::string_view rest = GetPathAndQuery(url);
+    size_t question = rest.find('?');
+    return question == std::string_view::npos ? std::string_view() : rest.substr(question + 1);
+}
+
+std::string ToLower(std::string_view value) {
+    std::string result(value);
+    for (char& c : result) {
+        if (c >= 'A' && c <= 'Z') {
+            c += 'a' - 'A';
+        }
+    }
+    return result;
+}
+
+std::string ToUpper(std::string_view value) {
+    std::string result(value);
+    for (char& c : result) {
+        if (c >= 'a' && c <= 'z') {
+            c -= 'a' - 'A';
+        }
+    }
+    return result;
+}
+
+LikeMatcher::LikeMatcher(std::string_view pattern, char escape) {
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        if (c == escape && i + 1 < pattern.size()) {
+            tokens_.push_back({pattern[++i], false, false});
+        } else if (c == '%') {
+            if (tokens_.empty() || !tokens_.back().is_any_sequence) {
+                tokens_.push_back({c, false, true});
+            }
+        } else if (c == '_') {
+            tokens_.push_back({c, true, false});
+        } else {
+            tokens_.push_back({c, false, false});
+        }
+    }
+    bool has_any_char = false;
+    bool has_any_sequence = false;
+    std::string segment;
+    for (const Token& token : tokens_) {
+        if (token.is_any_sequence) {
+            has_any_sequence = true;
+            if (!segment.empty()) {
+                segments_.push_back(std::move(segment));
+                segment.clear();
+            }
+        } else if (token.is_any_char) {
+            has_any_char = true;
+        } else {
+            segment.push_back(token.value);
+        }
+    }
+    if (!segment.empty() || segments_.empty()) {
+        segments_.push_back(std::move(segment));
+    }
+    std::string literal;
+    for (const Token& token : tokens_) {
+        if (!token.is_any_char && !token.is_any_sequence) {
+            literal.push_back(token.value);
+        } else if (!literal.empty()) {
+            literals_.push_back(std::move(literal));
+            literal.clear();
+        }
+    }
+    if (!literal.empty()) {
+        literals_.push_back(std::move(literal));
+    }
+    for (const Token& token : tokens_) {
+        if (token.is_any_char || token.is_any_sequence) {
+            break;
+        }
+        prefix_.push_back(token.value);
+    }
+    is_start_anchored_ = tokens_.empty() || !tokens_.front().is_any_sequence;
+    is_end_anchored_ = tokens_.empty() || !tokens_.back().is_any_sequence;
+    if (has_any_char) {
+        kind_ = Kind::Generic;
+    } else if (!has_any_sequence) {
+        kind_ = Kind::Exact;
+    } else if (segments_.size() > 1) {
+        kind_ = Kind::Segments;
+    } else if (is_start_anchored_) {
+        kind_ = Kind::Prefix;
+    } else if (is_end_anchored_) {
+        kind_ = Kind::Suffix;
+    } else {
+        kind_ = Kind::Contains;
+    }
+}
+
+bool LikeMatcher::Match(std::string_view value) const {
+    switch (kind_) {
+        case Kind::Exact:
+            return value == segments_.front();
+        case Kind::Prefix:
+            return value.starts_with(segments_.front());
+        case Kind::Suffix:
+            return value.ends_with(segments_.front());
+        case Kind::Contains:
+            return FindSubstring(value, segments_.front()) != std::string_view::npos;
+        case Kind::Segments:
+            return MatchSegments(value);
+        case Kind::Generic:
+            return MatchGeneric(value);
+    }
+    return false;
+}
+
+bool LikeMatcher::MatchSegments(std::string_view value) const {
+    size_t first = 0;
+    size_t last = segments_.size();
+    size_t begin = 0;
+    size_t end = value.size();
+    if (is_start_anchored_) {
+        if (!value.starts_with(segments_.front())) {
+            return false;
+        }
+        begin = segments_.front().size();
+        ++first;
+    }
+    if (is_end_anchored_) {
+        const std::string& suffix = segments_.back();
+        if (end - begin < suffix.size() || !value.ends_with(suffix)) {
+            return false;
+        }
+        end -= suffix.size();
+        --last;
+    }
+    for (size_t i = first; i < last; ++i) {
+        size_t found = FindSubstring(value.substr(begin, end - begin), segments_[i]);
+        if (found == std::string_view::npos) {
+            return false;
+        }
+        begin += found + segments_[i].size();
+    }
+    return true;
+}
+
+bool LikeMatcher::MatchGeneric(std::string_view value) const {
+    size_t token = 0;
+    size_t position = 0;
+    size_t star = std::string_view::npos;
+    size_t star_position = 0;
+    while (position < value.size()) {
+        if (token < tokens_.size() && !tokens_[token].is_any_sequence &&
+            (tokens_[token].is_any_char || tokens_[token].value == value[position])) {
+            ++token;
+            ++position;
+        } else if (token < tokens_.size() && tokens_[token].is_any_sequence) {
+            star = token++;
+            star_position = position;
+        } else if (star != std::string_view::npos) {
+            token = star + 1;
+            position = ++star_position;
+        } else {
+            return false;
+        }
+    }
+    while (token < tokens_.size() && tokens_[token].is_any_sequence) {
+        ++token;
+    }
+    return token == tokens_.size();
+}
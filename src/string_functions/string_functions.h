@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+size_t FindSubstring(std::string_view haystack, std::string_view needle);
+std::string_view ExtractUrlDomain(std::string_view url);
+std::string_view ExtractUrlDomainWithoutWww(std::string_view url);
+std::string_view ExtractUrlPath(std::string_view url);
+std::string_view ExtractUrlQueryString(std::string_view url);
+std::string ToLower(std::string_view value);
+std::string ToUpper(std::string_view value);
+
+class LikeMatcher {
+public:
+    explicit LikeMatcher(std::string_view pattern, char escape = '\\');
+    bool Match(std::string_view value) const;
+    const std::string& GetPrefix() const { return prefix_; }
+    bool IsExactPattern() const { return kind_ == Kind::Exact; }
+    bool IsPrefixPattern() const { return kind_ == Kind::Prefix; }
+    const std::vector<std::string>& GetLiterals() const { return literals_; }
+
+protected:
+    enum class Kind { Exact, Prefix, Suffix, Contains, Segments, Generic };
+
+    struct Token {
+        char value;
+        bool is_any_char;
+        bool is_any_sequence;
+    };
+
+    bool MatchSegments(std::string_view value) const;
+    bool MatchGeneric(std::string_view value) const;
+
+    Kind kind_;
+    std::vector<Token> tokens_;
+    std::vector<std::string> segments_;
+    std::vector<std::string> literals_;
+    std::string prefix_;
+    bool is_start_anchored_ = true;
+    bool is_end_anchored_ = true;
+};
@@ -0,0 +1,156 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t thread_count) {
+    thread_count = std::max<size_t>(thread_count, 1);
+    for (size_t i = 0; i < thread_count; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < thread_count; ++i) {
+        threads_.emplace_back([this, i]() { Run(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        is_stopping_ = true;
+    }
+    has_work_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+ThreadPool& ThreadPool::GetDefault() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+    size_t index = current_pool == this ? current_worker : next_worker_++ % workers_.size();
+    {
+        std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+        ++queued_;
+        workers_[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+    }
+    has_work_.notify_one();
+}
+
+bool ThreadPool::TryPop(size_t index, std::function<void()>& task) {
+    Worker& worker = *workers_[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) {
+        return false;
+    }
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    --queued_;
+    return true;
+}
+
+bool ThreadPool::TrySteal(size_t index, std::function<void()>& task) {
+    for (size_t offset = 1; offset <= workers_.size(); ++offset) {
+        Worker& victim = *workers_[(index + offset) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) {
+            continue;
+        }
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        --queued_;
+        return true;
+    }
+    return false;
+}
+
+bool ThreadPool::TryRunTask() {
+    std::function<void()> task;
+    size_t index = current_pool == this ? current_worker : next_worker_++ % workers_.size();
+    if ((current_pool == this && TryPop(index, task)) || TrySteal(index, task)) {
+        task();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::Run(size_t index) {
+    current_pool = this;
+    current_worker = index;
+    while (true) {
+        std::function<void()> task;
+        if (TryPop(index, task) || TrySteal(index, task)) {
+            task();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        has_work_.wait(lock, [this]() { return is_stopping_ || queued_ > 0; });
+        if (is_stopping_ && queued_ == 0) {
+            return;
+        }
+    }
+}
+
+TaskGroup::~TaskGroup() {
+    try {
+        Wait();
+    } catch (...) {
+    }
+}
+
+void TaskGroup::Submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        ++state_->pending;
+    }
+    pool_.Submit([state = state_, task = std::move(task)]() {
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (state->error == nullptr) {
+                state->error = std::current_exception();
+            }
+        }
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (--state->pending == 0) {
+            state->done.notify_all();
+        }
+    });
+}
+
+void TaskGroup::Wait() {
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            if (state_->pending == 0) {
+                break;
+            }
+        }
+        if (pool_.TryRunTask()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        state_->done.wait_for(lock, std::chrono::milliseconds(1), [this]() { return state_->pending == 0; });
+    }
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        std::swap(error, state_->error);
+    }
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
+}
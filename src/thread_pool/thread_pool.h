@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t thread_count = std::thread::hardware_concurrency());
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Submit(std::function<void()> task);
+    bool TryRunTask();
+    size_t GetThreadCount() const { return threads_.size(); }
+
+    static ThreadPool& GetDefault();
+
+protected:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void Run(size_t index);
+    bool TryPop(size_t index, std::function<void()>& task);
+    bool TrySteal(size_t index, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable has_work_;
+    std::atomic<size_t> queued_ = 0;
+    std::atomic<size_t> next_worker_ = 0;
+    bool is_stopping_ = false;
+};
+
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool) : pool_(pool), state_(std::make_shared<State>()) {}
+    ~TaskGroup();
+    void Submit(std::function<void()> task);
+    void Wait();
+
+protected:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t pending = 0;
+        std::exception_ptr error;
+    };
+
+    ThreadPool& pool_;
+    std::shared_ptr<State> state_;
+};
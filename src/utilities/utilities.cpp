@@ -134,7 +134,7 @@ uint64_t HashDouble(double x) {
     return z;
 }
 
-uint64_t HashString(const std::string& s) {
+uint64_t HashString(std::string_view s) {
     uint64_t h = 0x100;
     const uint64_t P = 131;
 
@@ -148,3 +148,9 @@ uint64_t HashCombine(uint64_t seed, uint64_t value) {
     seed ^= value + 0x9e3779b97f617dbULL + (seed << 6) + (seed >> 2);
     return seed;
 }
+
+void AppendNgramHashes(std::string_view value, std::vector<uint64_t>& hashes) {
+    for (size_t i = 0; i + kNgramLength <= value.size(); ++i) {
+        hashes.push_back(HashString(value.substr(i, kNgramLength)));
+    }
+}
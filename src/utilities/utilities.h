@@ -1,7 +1,10 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 
 enum class Types : int64_t {
@@ -14,6 +17,21 @@ enum class Types : int64_t {
     TypeTimestamp = 7
 };
 
+constexpr uint32_t kExtendedStatsMagic = 0x53545845;
+constexpr uint32_t kExtendedStatsVersion = 1;
+constexpr uint32_t kBloomFilterMagic = 0x464d4c42;
+constexpr uint32_t kBloomFilterVersion = 1;
+constexpr uint32_t kNgramIndexMagic = 0x4d52474e;
+constexpr uint32_t kNgramIndexVersion = 1;
+constexpr size_t kNgramLength = 3;
+
+enum class ExtendedStatsField : uint8_t {
+    Sum = 1,
+    Distinct = 2,
+    Histogram = 4,
+    TopValues = 8
+};
+
 bool isInteger(const std::string& str);
 bool isDate(const std::string& str);
 uint32_t ParseDate(const std::string& str);
@@ -24,5 +42,6 @@ std::string FormatTimestamp(uint32_t value);
 void WriteNum(int64_t num, std::ostream& output);
 uint64_t HashInt64(int64_t x);
 uint64_t HashDouble(double x);
-uint64_t HashString(const std::string& x);
+uint64_t HashString(std::string_view x);
 uint64_t HashCombine(uint64_t seed, uint64_t value);
+void AppendNgramHashes(std::string_view value, std::vector<uint64_t>& hashes);
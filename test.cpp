@@ -6,11 +6,23 @@
 #include "src/file_reader/file_reader.h"
 #include "src/scheme/scheme.h"
 #include "src/operators/operators.h"
+#include "src/external_sort/external_sort.h"
+#include "src/hyperloglog/hyperloglog.h"
+#include "src/hash_set/hash_set.h"
+#include "src/expressions/expressions.h"
+#include "src/string_functions/string_functions.h"
+#include "src/regex/regex.h"
+#include "src/thread_pool/thread_pool.h"
+#include "src/query_arena/query_arena.h"
+#include "src/bloom_filter/bloom_filter.h"
+#include "src/utilities/utilities.h"
 
+#include <cstring>
 #include <filesystem>
 #include <sstream>
 #include <fstream>
 #include <iostream>
+#include <numeric>
 #include <random>
 
 bool CompareVec(const std::vector<std::string>& actual, 
@@ -169,6 +181,65 @@ TEST(RowGroupWriterTest, JustWorks) {
 //     std::remove(output_file);
 // }
 
+TEST(RowGroupWriterTest, ExtendedStatsTest) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City";
+        for (int64_t i = 0; i < 1000; ++i) {
+            out << "\nn" << i % 10 << "," << i % 100 << "," << (i < 600 ? "NYC" : "LA");
+        }
+    }
+    const char* output_file = "db_file.egg";
+    for (bool is_extended : {false, true}) {
+        Scheme scheme;
+        CSVWrapper parser(input_csv_file);
+        parser.SetScheme(scheme, GetSimpleCsvTypes());
+        std::ofstream output(output_file, std::ios::binary);
+        RowGroupWriter writer(std::move(parser), output, scheme);
+        writer.SetExtendedStats(is_extended);
+        writer.WriteAll();
+        output.close();
+
+        std::ifstream input(output_file, std::ios::binary | std::ios::ate);
+        RowGroupReader reader(input);
+        BatchBlockStats stats = reader.GetBatchBlockStats(0);
+        EXPECT_EQ(std::get<int64_t>(stats[1].max_value), 99);
+        ScanOperator scan_operator(output_file, {"Age"});
+        if (!is_extended) {
+            EXPECT_EQ(stats[1].extended, nullptr);
+            EXPECT_FALSE(scan_operator.EstimateDistinctCount(1).has_value());
+            continue;
+        }
+        const ExtendedColumnStats& age_stats = *stats[1].extended;
+        EXPECT_EQ(std::get<int64_t>(age_stats.sum.value()), 49500);
+        EXPECT_EQ(age_stats.distinct->Estimate(), 100);
+        int64_t histogram_rows = 0;
+        for (const auto& bucket : age_stats.histogram) {
+            histogram_rows += bucket.row_count;
+        }
+        EXPECT_EQ(histogram_rows, 1000);
+        EXPECT_EQ(std::get<int64_t>(age_stats.histogram.back().value), 99);
+        EXPECT_FALSE(stats[0].extended->sum.has_value());
+        EXPECT_EQ(stats[0].extended->distinct->Estimate(), 10);
+        const std::vector<StatsBucket>& top_cities = stats[2].extended->top_values;
+        ASSERT_EQ(top_cities.size(), 2);
+        EXPECT_EQ(std::get<std::string>(top_cities[0].value), "NYC");
+        EXPECT_EQ(top_cities[0].row_count, 600);
+        EXPECT_EQ(scan_operator.EstimateDistinctCount(1), 100);
+
+        std::unique_ptr<IOperator> scan = std::make_unique<ScanOperator>(output_file, std::vector<std::string>{"Age"});
+        std::vector<std::string> aggr_cols = {"Age", "Age"};
+        std::vector<GlobalAggregationOperator::Op> aggr_op = {GlobalAggregationOperator::Op::SUM, GlobalAggregationOperator::Op::AVG};
+        GlobalAggregationOperator aggr_operator(aggr_cols, std::move(scan), aggr_op, scheme);
+        std::optional<Batch> batch = aggr_operator.Next();
+        EXPECT_EQ(batch.value()[0]->GetCellAsString(0), "49500");
+        EXPECT_EQ(std::get<double>(batch.value()[1]->Get(0)), 49.5);
+    }
+    std::remove(input_csv_file);
+    std::remove(output_file);
+}
+
 TEST(RowGroupReaderTest, SimpleTest) {
     const char* input_csv_file = "test.csv";
     {
@@ -199,6 +270,97 @@ TEST(RowGroupReaderTest, SimpleTest) {
     std::remove(output_csv_file);
 }
 
+TEST(RowGroupReaderTest, ParallelDecodeTest) {
+    std::vector<std::string> ints;
+    std::vector<std::string> doubles;
+    for (int64_t i = 0; i < 700000; ++i) {
+        ints.push_back(std::to_string((i * 7919) % 100003 - 50000));
+        doubles.push_back(std::to_string(i * 0.5));
+    }
+    Int32 int_column;
+    int_column.AddColumn(ints);
+    Double double_column;
+    double_column.AddColumn(doubles);
+    ThreadPool pool(4);
+    std::atomic<int64_t> ranges = 0;
+    RangeExecutor executor = [&](size_t count, const std::function<void(size_t, size_t)>& fn) {
+        TaskGroup group(pool);
+        for (size_t begin = 0; begin < count; begin += 100001) {
+            size_t end = std::min(count, begin + 100001);
+            group.Submit([&fn, &ranges, begin, end]() {
+                fn(begin, end);
+                ++ranges;
+            });
+        }
+        group.Wait();
+    };
+    Int32 decoded_ints;
+    decoded_ints.SetData(int_column.Encode(), executor);
+    Double decoded_doubles;
+    decoded_doubles.SetData(double_column.Encode(), executor);
+    EXPECT_EQ(decoded_ints.GetValues(), int_column.GetValues());
+    EXPECT_EQ(decoded_doubles.GetColumnAsString(), double_column.GetColumnAsString());
+    EXPECT_EQ(ranges.load(), 14);
+
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "John,25,NYC\n"
+            << "Jane,30,LA";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    ScanOperator scan_operator(output_file, columns);
+    scan_operator.SetDecodePool(&pool);
+    std::optional<Batch> batch = scan_operator.Next();
+    EXPECT_EQ(batch.value()[0]->GetColumnAsString(), std::vector<std::string>({"John", "Jane"}));
+    EXPECT_EQ(batch.value()[1]->GetColumnAsString(), std::vector<std::string>({"25", "30"}));
+    EXPECT_EQ(batch.value()[2]->GetColumnAsString(), std::vector<std::string>({"NYC", "LA"}));
+    std::remove(input_csv_file);
+    std::remove(output_file);
+}
+
+TEST(RowGroupReaderTest, RecycleBatchTest) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "John,25,NYC\n"
+            << "Jane,30,LA";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    std::ifstream input(output_file, std::ios::binary | std::ios::ate);
+    RowGroupReader reader(input);
+    Batch batch = reader.ReadBatch(0, {1});
+    EXPECT_EQ(batch[0], nullptr);
+    EXPECT_EQ(batch[2], nullptr);
+    const Column* age_column = batch[1].get();
+    reader.RecycleBatch(std::move(batch));
+    batch = reader.ReadBatch(0, {0, 1});
+    EXPECT_EQ(batch[1].get(), age_column);
+    EXPECT_EQ(batch[0]->GetColumnAsString(), std::vector<std::string>({"John", "Jane"}));
+    EXPECT_EQ(batch[1]->GetColumnAsString(), std::vector<std::string>({"25", "30"}));
+    std::remove(input_csv_file);
+    std::remove(output_file);
+}
+
 TEST(RowGroupReaderTest, GenerateBigFileCsv) {
     GenerateCsv();
     ASSERT_TRUE(std::filesystem::exists("big_test.csv"));
@@ -260,6 +422,65 @@ TEST(BasicOperatorsTest, ScanOperatorTest) {
     std::remove(input_db_file);
 }
 
+TEST(BasicOperatorsTest, ScanVectorSizeTest) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "Jane,20,NYC\n"
+            << "John,23,London\n"
+            << "Clon,21,NYC\n"
+            << "Bon,22,LA\n"
+            << "Al,24,NYC";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "City"};
+    ScanOperator scan_operator(input_db_file, columns);
+    scan_operator.SetVectorSize(2);
+    scan_operator.EnableRowIds();
+    std::vector<std::vector<std::string>> names;
+    std::vector<std::string> cities;
+    std::vector<std::string> row_ids;
+    while (auto batch = scan_operator.Next()) {
+        names.push_back(batch.value()[0]->GetColumnAsString());
+        for (const auto& city : batch.value()[2]->GetColumnAsString()) {
+            cities.push_back(city);
+        }
+        for (const auto& row_id : batch.value()[3]->GetColumnAsString()) {
+            row_ids.push_back(row_id);
+        }
+    }
+    EXPECT_EQ(names, std::vector<std::vector<std::string>>({{"Jane", "John"}, {"Clon", "Bon"}, {"Al"}}));
+    EXPECT_EQ(cities, std::vector<std::string>({"NYC", "London", "NYC", "LA", "NYC"}));
+    EXPECT_EQ(row_ids, std::vector<std::string>({"0", "1", "2", "3", "4"}));
+    String dictionary_column(std::vector<std::string>{"a", "b"}, std::vector<uint32_t>{0, 1, 1, 0});
+    std::unique_ptr<Column> slice = dictionary_column.Slice(1, 3);
+    EXPECT_TRUE(static_cast<const String&>(*slice).HasDictionary());
+    EXPECT_EQ(&static_cast<const String&>(*slice).GetDictionary(), &dictionary_column.GetDictionary());
+    EXPECT_EQ(slice->GetColumnAsString(), std::vector<std::string>({"b", "b"}));
+
+    std::vector<std::string> narrow_columns{"Age"};
+    auto narrow_scan = std::make_unique<ScanOperator>(input_db_file, narrow_columns);
+    narrow_scan->SetVectorSize(1);
+    narrow_scan->EnableRowIds();
+    std::vector<std::string> all_columns{"Name", "Age", "City"};
+    LateMaterializedTopKOperator top_k_operator(std::move(narrow_scan), 2, true, {0}, input_db_file, all_columns, scheme);
+    std::optional<Batch> batch = top_k_operator.Next();
+    EXPECT_EQ(batch.value()[0]->GetColumnAsString(), std::vector<std::string>({"Al", "John"}));
+    EXPECT_EQ(batch.value()[2]->GetColumnAsString(), std::vector<std::string>({"NYC", "London"}));
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
 TEST(BasicOperatorsTest, CompareOperatorTest) {
     const char* input_csv_file = "test.csv";
     {
@@ -341,14 +562,15 @@ TEST(BasicOperatorsTest, AndFilterOperatorTest) {
     std::remove(input_db_file);
 }
 
-TEST(GlobalAggregationOperatorTest, Sum) {
+TEST(BasicOperatorsTest, LikeFilterOperatorTest) {
     const char* input_csv_file = "test.csv";
     {
         std::ofstream out(input_csv_file);
         out << "Name,Age,City\n"
-            << "John,25,NYC\n"
-            << "Jane,30,LA\n"
-            << "Jane,60,NYC";
+            << "http://google.com,25,NYC\n"
+            << "http://yandex.ru,30,LA\n"
+            << "https://www.google.com/a_b,60,NYC\n"
+            << "http://yandex.ru,10,LA";
     }
     const char* output_file = "db_file.egg";
     Scheme scheme;
@@ -360,27 +582,75 @@ TEST(GlobalAggregationOperatorTest, Sum) {
     output.close();
 
     const char* input_db_file = "db_file.egg";
-    std::vector<std::string> columns{"Name", "Age", "City"};
-    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
-    std::vector<std::string> aggr_cols = {"Age"};
-    std::vector<GlobalAggregationOperator::Op> aggr_op = {GlobalAggregationOperator::Op::SUM};
-    std::unique_ptr<IOperator> aggr_operator = std::make_unique<GlobalAggregationOperator>(aggr_cols, std::move(scan_operator), aggr_op, scheme);
-    std::optional<Batch> batch = aggr_operator->Next();
-    std::vector<std::string> expected = {"115"};
-    std::vector<std::string> result = batch.value()[0]->GetColumnAsString();
-    EXPECT_EQ(expected, result);
+    std::vector<std::string> columns{"Name", "Age"};
+    auto run_filter = [&](const std::string& pattern) {
+        std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+        std::unique_ptr<FilterCondition> condition = std::make_unique<LikeFilter>("Name", pattern, scheme);
+        std::unique_ptr<IOperator> filter_operator = std::make_unique<FilterOperator>(std::move(scan_operator), std::move(condition));
+        std::optional<Batch> batch = filter_operator->Next();
+        return batch.has_value() ? batch.value()[1]->GetColumnAsString() : std::vector<std::string>{};
+    };
+    EXPECT_EQ(run_filter("%google%"), std::vector<std::string>({"25", "60"}));
+    EXPECT_EQ(run_filter("http://%.ru"), std::vector<std::string>({"30", "10"}));
+    EXPECT_EQ(run_filter("%a\\_b"), std::vector<std::string>({"60"}));
+    EXPECT_EQ(run_filter("http_://%"), std::vector<std::string>({"60"}));
+    EXPECT_EQ(run_filter("ftp://%"), std::vector<std::string>{});
     std::remove(input_csv_file);
     std::remove(input_db_file);
 }
 
-TEST(GlobalAggregationOperatorTest, Max) {
+TEST(BasicOperatorsTest, AdaptiveFilterOrderTest) {
+    Scheme scheme;
+    scheme.AddColumnName("Value");
+    scheme.AddColumnType(static_cast<int64_t>(Types::TypeInt64));
+    std::vector<int64_t> values(10000);
+    std::iota(values.begin(), values.end(), 0);
+    Batch batch;
+    batch.push_back(std::make_unique<Int64>(values));
+
+    AndFilter and_filter(
+        std::make_unique<AndFilter>(
+            std::make_unique<CompareFilter<int64_t>>("Value", CompareFilter<int64_t>::Op::LT, static_cast<int64_t>(9000), scheme),
+            std::make_unique<CompareFilter<int64_t>>("Value", CompareFilter<int64_t>::Op::GE, static_cast<int64_t>(0), scheme)
+        ),
+        std::make_unique<CompareFilter<int64_t>>("Value", CompareFilter<int64_t>::Op::LT, static_cast<int64_t>(1000), scheme)
+    );
+    EXPECT_EQ(and_filter.GetChildCount(), 3);
+    for (int i = 0; i < 8; ++i) {
+        std::vector<int64_t> row_ids = values;
+        and_filter.EvaluateBatch(batch, row_ids);
+        EXPECT_EQ(row_ids.size(), 1000);
+    }
+    EXPECT_EQ(and_filter.GetEvaluationOrder().front(), 2);
+    EXPECT_TRUE(and_filter.Evaluate(batch, 10));
+    EXPECT_FALSE(and_filter.Evaluate(batch, 5000));
+
+    OrFilter or_filter(
+        std::make_unique<OrFilter>(
+            std::make_unique<CompareFilter<int64_t>>("Value", CompareFilter<int64_t>::Op::EQ, static_cast<int64_t>(5), scheme),
+            std::make_unique<CompareFilter<int64_t>>("Value", CompareFilter<int64_t>::Op::EQ, static_cast<int64_t>(9), scheme)
+        ),
+        std::make_unique<CompareFilter<int64_t>>("Value", CompareFilter<int64_t>::Op::LT, static_cast<int64_t>(3), scheme)
+    );
+    EXPECT_EQ(or_filter.GetChildCount(), 3);
+    for (int i = 0; i < 8; ++i) {
+        std::vector<int64_t> row_ids = values;
+        or_filter.EvaluateBatch(batch, row_ids);
+        EXPECT_EQ(row_ids, std::vector<int64_t>({0, 1, 2, 5, 9}));
+    }
+    EXPECT_TRUE(or_filter.Evaluate(batch, 9));
+    EXPECT_FALSE(or_filter.Evaluate(batch, 4));
+}
+
+TEST(BasicOperatorsTest, InFilterOperatorTest) {
     const char* input_csv_file = "test.csv";
     {
         std::ofstream out(input_csv_file);
         out << "Name,Age,City\n"
             << "John,25,NYC\n"
             << "Jane,30,LA\n"
-            << "Jane,60,NYC";
+            << "Bob,60,NYC\n"
+            << "Al,10,SF";
     }
     const char* output_file = "db_file.egg";
     Scheme scheme;
@@ -393,26 +663,61 @@ TEST(GlobalAggregationOperatorTest, Max) {
 
     const char* input_db_file = "db_file.egg";
     std::vector<std::string> columns{"Name", "Age", "City"};
-    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
-    std::vector<std::string> aggr_cols = {"Age"};
-    std::vector<GlobalAggregationOperator::Op> aggr_op = {GlobalAggregationOperator::Op::MAX};
-    std::unique_ptr<IOperator> aggr_operator = std::make_unique<GlobalAggregationOperator>(aggr_cols, std::move(scan_operator), aggr_op, scheme);
-    std::optional<Batch> batch = aggr_operator->Next();
-    std::vector<std::string> expected = {"60"};
-    std::vector<std::string> result = batch.value()[0]->GetColumnAsString();
-    EXPECT_EQ(expected, result);
+    auto run_filter = [&](const std::string& column, const std::vector<CellTypes>& values) {
+        std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+        std::unique_ptr<FilterCondition> condition = std::make_unique<InFilter>(column, values, scheme);
+        std::unique_ptr<IOperator> filter_operator = std::make_unique<FilterOperator>(std::move(scan_operator), std::move(condition));
+        std::optional<Batch> batch = filter_operator->Next();
+        return batch.has_value() ? batch.value()[0]->GetColumnAsString() : std::vector<std::string>{};
+    };
+    EXPECT_EQ(run_filter("Age", {int64_t{60}, int64_t{25}, int64_t{25}}), std::vector<std::string>({"John", "Bob"}));
+    EXPECT_EQ(run_filter("Age", {int64_t{10}, int64_t{1} << 40}), std::vector<std::string>({"Al"}));
+    std::vector<CellTypes> many_ages;
+    for (int64_t i = 0; i < 100; ++i) {
+        many_ages.push_back(i * 1000000 + 30);
+    }
+    EXPECT_EQ(run_filter("Age", many_ages), std::vector<std::string>({"Jane"}));
+    EXPECT_EQ(run_filter("City", {std::string("LA"), std::string("SF")}), std::vector<std::string>({"Jane", "Al"}));
+    EXPECT_EQ(run_filter("City", {std::string("Paris")}), std::vector<std::string>{});
+    EXPECT_EQ(run_filter("Age", {}), std::vector<std::string>{});
+
+    InFilter age_filter("Age", {int64_t{40}, int64_t{70}}, scheme);
+    EXPECT_TRUE(age_filter.CanSkipBatch({{}, {int64_t{10}, int64_t{30}}, {}}));
+    EXPECT_FALSE(age_filter.CanSkipBatch({{}, {int64_t{10}, int64_t{40}}, {}}));
+    InFilter city_filter("City", {std::string("Boston"), std::string("Paris")}, scheme);
+    EXPECT_TRUE(city_filter.CanSkipBatch({{}, {}, {std::string("LA"), std::string("NYC")}}));
+    EXPECT_FALSE(city_filter.CanSkipBatch({{}, {}, {std::string("LA"), std::string("SF")}}));
+    EXPECT_THROW(InFilter("Age", {std::string("LA")}, scheme), std::runtime_error);
     std::remove(input_csv_file);
     std::remove(input_db_file);
 }
 
-TEST(GlobalAggregationOperatorTest, CountDistinct) {
+class CountingFilter : public FilterCondition {
+public:
+    CountingFilter(std::unique_ptr<FilterCondition> child, int64_t& evaluate_calls) : child_(std::move(child)), evaluate_calls_(evaluate_calls) {}
+    bool Evaluate(const Batch& batch, size_t row_index) const override {
+        return child_->Evaluate(batch, row_index);
+    }
+    void EvaluateBatch(const Batch& batch, std::vector<int64_t>& row_ids) const override {
+        ++evaluate_calls_;
+        child_->EvaluateBatch(batch, row_ids);
+    }
+    PruneResult Prune(const BatchBlockStats& batch_stats) const override { return child_->Prune(batch_stats); }
+
+protected:
+    std::unique_ptr<FilterCondition> child_;
+    int64_t& evaluate_calls_;
+};
+
+TEST(BasicOperatorsTest, PruneFilterTest) {
     const char* input_csv_file = "test.csv";
     {
         std::ofstream out(input_csv_file);
         out << "Name,Age,City\n"
-            << "John,25,NYC\n"
-            << "Jane,30,LA\n"
-            << "Jane,60,NYC";
+            << "http://google.com,25,NYC\n"
+            << "http://yandex.ru,30,LA\n"
+            << "http://google.com/maps,60,NYC\n"
+            << "http://yandex.ru,10,LA";
     }
     const char* output_file = "db_file.egg";
     Scheme scheme;
@@ -423,27 +728,84 @@ TEST(GlobalAggregationOperatorTest, CountDistinct) {
     writer.WriteAll();
     output.close();
 
+    BatchBlockStats stats{
+        {std::string("http://google.com"), std::string("http://yandex.ru")},
+        {int64_t{10}, int64_t{60}},
+        {std::string("LA"), std::string("NYC")}
+    };
+    auto age = [&](Column::Op op, int64_t value) {
+        return std::make_unique<CompareFilter<int64_t>>("Age", op, value, scheme);
+    };
+    EXPECT_EQ(age(Column::Op::GE, 10)->Prune(stats), PruneResult::All);
+    EXPECT_EQ(age(Column::Op::GT, 10)->Prune(stats), PruneResult::Some);
+    EXPECT_EQ(age(Column::Op::GT, 60)->Prune(stats), PruneResult::None);
+    EXPECT_EQ(age(Column::Op::NE, 70)->Prune(stats), PruneResult::All);
+    EXPECT_EQ(NotFilter(age(Column::Op::LT, 70)).Prune(stats), PruneResult::None);
+    EXPECT_EQ(NotFilter(age(Column::Op::GT, 70)).Prune(stats), PruneResult::All);
+    EXPECT_EQ(AndFilter(age(Column::Op::GE, 0), age(Column::Op::LE, 60)).Prune(stats), PruneResult::All);
+    EXPECT_EQ(AndFilter(age(Column::Op::GE, 0), age(Column::Op::LE, 30)).Prune(stats), PruneResult::Some);
+    EXPECT_EQ(OrFilter(age(Column::Op::GT, 70), age(Column::Op::LE, 60)).Prune(stats), PruneResult::All);
+    EXPECT_EQ(OrFilter(age(Column::Op::GT, 70), age(Column::Op::LT, 0)).Prune(stats), PruneResult::None);
+    EXPECT_EQ(LikeFilter("Name", "http://%", scheme).Prune(stats), PruneResult::All);
+    EXPECT_EQ(LikeFilter("Name", "http://g%", scheme).Prune(stats), PruneResult::Some);
+    EXPECT_EQ(LikeFilter("Name", "https://%", scheme).Prune(stats), PruneResult::None);
+    EXPECT_EQ(InFilter("City", {std::string("LA")}, scheme).Prune({{}, {}, {std::string("LA"), std::string("LA")}}), PruneResult::All);
+    std::vector<CellTypes> ages;
+    for (int64_t i = 5; i <= 65; ++i) {
+        ages.push_back(i);
+    }
+    EXPECT_EQ(InFilter("Age", ages, scheme).Prune(stats), PruneResult::All);
+    EXPECT_EQ(InFilter("Age", {int64_t{10}, int64_t{60}}, scheme).Prune(stats), PruneResult::Some);
+    EXPECT_EQ(CompareFilterByIndex(1, Column::Op::LT, int64_t{100}).Prune(stats), PruneResult::All);
+    EXPECT_EQ(age(Column::Op::GT, 0)->Prune({{}, {1.5, 2.5}, {}}), PruneResult::Some);
+
     const char* input_db_file = "db_file.egg";
-    std::vector<std::string> columns{"Name", "Age", "City"};
-    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
-    std::vector<std::string> aggr_cols = {"Age"};
-    std::vector<GlobalAggregationOperator::Op> aggr_op = {GlobalAggregationOperator::Op::CountDistinct};
-    std::unique_ptr<IOperator> aggr_operator = std::make_unique<GlobalAggregationOperator>(aggr_cols, std::move(scan_operator), aggr_op, scheme);
-    std::optional<Batch> batch = aggr_operator->Next();
-    std::vector<std::string> expected = {"3"};
-    std::vector<std::string> result = batch.value()[0]->GetColumnAsString();
-    EXPECT_EQ(expected, result);
+    std::vector<std::string> columns{"Name", "Age"};
+    auto run_filter = [&](std::unique_ptr<FilterCondition> condition, int64_t& evaluate_calls) {
+        std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+        std::unique_ptr<FilterCondition> counting = std::make_unique<CountingFilter>(std::move(condition), evaluate_calls);
+        std::unique_ptr<IOperator> filter_operator = std::make_unique<FilterOperator>(std::move(scan_operator), std::move(counting));
+        std::optional<Batch> batch = filter_operator->Next();
+        return batch.has_value() ? batch.value()[1]->GetColumnAsString() : std::vector<std::string>{};
+    };
+    int64_t evaluate_calls = 0;
+    EXPECT_EQ(run_filter(age(Column::Op::GE, 10), evaluate_calls), std::vector<std::string>({"25", "30", "60", "10"}));
+    EXPECT_EQ(evaluate_calls, 0);
+    EXPECT_EQ(run_filter(age(Column::Op::GT, 10), evaluate_calls), std::vector<std::string>({"25", "30", "60"}));
+    EXPECT_EQ(evaluate_calls, 1);
     std::remove(input_csv_file);
     std::remove(input_db_file);
 }
 
-TEST(GlobalAggregationOperatorTest, Avg) {
+TEST(BloomFilterTest, InsertAndSerialize) {
+    BloomFilter filter(10000);
+    for (int64_t i = 0; i < 10000; ++i) {
+        filter.Insert(HashInt64(i));
+    }
+    int64_t false_positives = 0;
+    for (int64_t i = 0; i < 10000; ++i) {
+        EXPECT_TRUE(filter.MightContain(HashInt64(i)));
+        false_positives += filter.MightContain(HashInt64(i + 10000)) ? 1 : 0;
+    }
+    EXPECT_LT(false_positives, 300);
+    std::vector<uint8_t> bytes = filter.Serialize();
+    EXPECT_EQ(bytes.size(), filter.GetByteSize());
+    BloomFilter restored = BloomFilter::Deserialize(bytes.data(), bytes.size());
+    for (int64_t i = 0; i < 10000; ++i) {
+        EXPECT_EQ(restored.MightContain(HashInt64(i + 5000)), filter.MightContain(HashInt64(i + 5000)));
+    }
+    EXPECT_THROW(BloomFilter::Deserialize(bytes.data(), 7), std::runtime_error);
+    EXPECT_THROW(BloomFilter(10, 1.5), std::runtime_error);
+}
+
+TEST(BasicOperatorsTest, BloomFilterPruneTest) {
     const char* input_csv_file = "test.csv";
     {
         std::ofstream out(input_csv_file);
-        out << "Name,Age,City\n"
-            << "John,20,NYC\n"
-            << "Jane,21,LA";
+        out << "Name,Age,City";
+        for (int64_t i = 0; i < 100; ++i) {
+            out << "\nn" << i << "," << i * 1000 << ",city" << i * 2;
+        }
     }
     const char* output_file = "db_file.egg";
     Scheme scheme;
@@ -451,30 +813,71 @@ TEST(GlobalAggregationOperatorTest, Avg) {
     parser.SetScheme(scheme, GetSimpleCsvTypes());
     std::ofstream output(output_file, std::ios::binary);
     RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.SetBloomFilter("Age");
+    writer.SetBloomFilter("City", 0.001);
+    EXPECT_THROW(writer.SetBloomFilter("Age", 0.0), std::runtime_error);
     writer.WriteAll();
     output.close();
 
     const char* input_db_file = "db_file.egg";
     std::vector<std::string> columns{"Name", "Age", "City"};
-    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
-    std::vector<std::string> aggr_cols = {"Age"};
-    std::vector<GlobalAggregationOperator::Op> aggr_op = {GlobalAggregationOperator::Op::AVG};
-    std::unique_ptr<IOperator> aggr_operator = std::make_unique<GlobalAggregationOperator>(aggr_cols, std::move(scan_operator), aggr_op, scheme);
-    std::optional<Batch> batch = aggr_operator->Next();
-    std::vector<std::string> expected = {"20.500000"};
-    std::vector<std::string> result = batch.value()[0]->GetColumnAsString();
-    EXPECT_EQ(expected, result);
+    auto run_filter = [&](std::unique_ptr<FilterCondition> condition, int64_t& evaluate_calls) {
+        std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+        std::unique_ptr<FilterCondition> counting = std::make_unique<CountingFilter>(std::move(condition), evaluate_calls);
+        std::unique_ptr<IOperator> filter_operator = std::make_unique<FilterOperator>(std::move(scan_operator), std::move(counting));
+        std::optional<Batch> batch = filter_operator->Next();
+        return batch.has_value() ? batch.value()[0]->GetColumnAsString() : std::vector<std::string>{};
+    };
+    auto age = [&](Column::Op op, int64_t value) {
+        return std::make_unique<CompareFilter<int64_t>>("Age", op, value, scheme);
+    };
+    int64_t evaluate_calls = 0;
+    EXPECT_EQ(run_filter(age(Column::Op::EQ, 62000), evaluate_calls), std::vector<std::string>({"n62"}));
+    EXPECT_EQ(evaluate_calls, 1);
+    EXPECT_EQ(run_filter(age(Column::Op::EQ, 62500), evaluate_calls), std::vector<std::string>{});
+    EXPECT_EQ(evaluate_calls, 1);
+    auto city = std::make_unique<CompareFilter<std::string>>("City", Column::Op::EQ, std::string("city3"), scheme);
+    EXPECT_EQ(run_filter(std::move(city), evaluate_calls), std::vector<std::string>{});
+    EXPECT_EQ(evaluate_calls, 1);
+    std::vector<CellTypes> cities{std::string("city1"), std::string("city5"), std::string("city7")};
+    EXPECT_EQ(run_filter(std::make_unique<InFilter>("City", cities, scheme), evaluate_calls), std::vector<std::string>{});
+    EXPECT_EQ(evaluate_calls, 1);
+    std::vector<CellTypes> ages{int64_t{1500}, int64_t{7000}};
+    EXPECT_EQ(run_filter(std::make_unique<InFilter>("Age", ages, scheme), evaluate_calls), std::vector<std::string>({"n7"}));
+    EXPECT_EQ(evaluate_calls, 2);
+    std::unique_ptr<FilterCondition> not_equal = std::make_unique<NotFilter>(age(Column::Op::EQ, 62500));
+    EXPECT_EQ(run_filter(std::move(not_equal), evaluate_calls).size(), 100);
+    EXPECT_EQ(evaluate_calls, 2);
+
+    std::string bytes;
+    {
+        std::ifstream input(input_db_file, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+    uint32_t magic = kBloomFilterMagic;
+    size_t section = bytes.find(std::string(reinterpret_cast<const char*>(&magic), sizeof(magic)));
+    ASSERT_NE(section, std::string::npos);
+    for (int64_t section_size : {int64_t{-1}, static_cast<int64_t>(bytes.size())}) {
+        std::memcpy(bytes.data() + section + 2 * sizeof(uint32_t), &section_size, sizeof(section_size));
+        {
+            std::ofstream corrupted(input_db_file, std::ios::binary);
+            corrupted << bytes;
+        }
+        std::ifstream input(input_db_file, std::ios::binary | std::ios::ate);
+        EXPECT_THROW(RowGroupReader reader(input), std::runtime_error);
+    }
     std::remove(input_csv_file);
     std::remove(input_db_file);
 }
 
-TEST(GlobalAggregationOperatorTest, ManyAggregations) {
+TEST(BasicOperatorsTest, NgramIndexPruneTest) {
     const char* input_csv_file = "test.csv";
     {
         std::ofstream out(input_csv_file);
-        out << "Name,Age,City\n"
-            << "Jane,20,NYC\n"
-            << "Jane,21,LA";
+        out << "Name,Age,City";
+        for (int64_t i = 0; i < 100; ++i) {
+            out << "\nn" << i << "," << i << ",http://www.example" << i << ".com/search";
+        }
     }
     const char* output_file = "db_file.egg";
     Scheme scheme;
@@ -482,35 +885,108 @@ TEST(GlobalAggregationOperatorTest, ManyAggregations) {
     parser.SetScheme(scheme, GetSimpleCsvTypes());
     std::ofstream output(output_file, std::ios::binary);
     RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.SetNgramIndex("City", 0.001);
+    EXPECT_THROW(writer.SetNgramIndex("Age"), std::runtime_error);
     writer.WriteAll();
     output.close();
 
     const char* input_db_file = "db_file.egg";
-    std::vector<std::string> columns{"Name", "Age", "City"};
-    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
-    std::vector<std::string> aggr_cols = {"Name", "Age", "City"};
-    std::vector<GlobalAggregationOperator::Op> aggr_op = {GlobalAggregationOperator::Op::CountDistinct, GlobalAggregationOperator::Op::SUM, GlobalAggregationOperator::Op::MAX};
-    std::unique_ptr<IOperator> aggr_operator = std::make_unique<GlobalAggregationOperator>(aggr_cols, std::move(scan_operator), aggr_op, scheme);
-    std::optional<Batch> batch = aggr_operator->Next();
-    std::vector<std::string> expected = {"1", "41", "NYC"};
-    std::vector<std::string> result;
-    result.push_back(batch.value()[0]->GetColumnAsString().front());
-    result.push_back(batch.value()[1]->GetColumnAsString().front());
-    result.push_back(batch.value()[2]->GetColumnAsString().front());
-    EXPECT_EQ(expected, result);
+    std::vector<std::string> columns{"Name", "City"};
+    auto run_filter = [&](const std::string& pattern, int64_t& evaluate_calls) {
+        std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+        std::unique_ptr<FilterCondition> like = std::make_unique<LikeFilter>("City", pattern, scheme);
+        std::unique_ptr<FilterCondition> counting = std::make_unique<CountingFilter>(std::move(like), evaluate_calls);
+        std::unique_ptr<IOperator> filter_operator = std::make_unique<FilterOperator>(std::move(scan_operator), std::move(counting));
+        std::optional<Batch> batch = filter_operator->Next();
+        return batch.has_value() ? batch.value()[0]->GetColumnAsString() : std::vector<std::string>{};
+    };
+    int64_t evaluate_calls = 0;
+    EXPECT_EQ(run_filter("%google%", evaluate_calls), std::vector<std::string>{});
+    EXPECT_EQ(evaluate_calls, 0);
+    EXPECT_EQ(run_filter("%example42.%", evaluate_calls), std::vector<std::string>({"n42"}));
+    EXPECT_EQ(evaluate_calls, 1);
+    EXPECT_EQ(run_filter("http://%.org/%", evaluate_calls), std::vector<std::string>{});
+    EXPECT_EQ(evaluate_calls, 1);
+    EXPECT_EQ(run_filter("%xample7_.com/sea%", evaluate_calls).size(), 10);
+    EXPECT_EQ(evaluate_calls, 2);
+    EXPECT_EQ(run_filter("%xample7_.net%", evaluate_calls), std::vector<std::string>{});
+    EXPECT_EQ(evaluate_calls, 2);
+    EXPECT_EQ(run_filter("%g%", evaluate_calls), std::vector<std::string>{});
+    EXPECT_EQ(evaluate_calls, 3);
     std::remove(input_csv_file);
     std::remove(input_db_file);
 }
 
-TEST(GroupByAggregationOperatorTest, BasicTest) {
+TEST(StringFunctionsTest, LikeMatcher) {
+    EXPECT_EQ(FindSubstring("abcdefghijklmnopqrstuvwxyz google", "google"), 27);
+    EXPECT_EQ(FindSubstring("googl", "google"), std::string_view::npos);
+    EXPECT_EQ(FindSubstring(std::string(100, 'g') + "oogle", "google"), 99);
+    EXPECT_TRUE(LikeMatcher("abc").Match("abc"));
+    EXPECT_FALSE(LikeMatcher("abc").Match("abcd"));
+    EXPECT_TRUE(LikeMatcher("ab%").Match("abcd"));
+    EXPECT_TRUE(LikeMatcher("%cd").Match("abcd"));
+    EXPECT_TRUE(LikeMatcher("%").Match(""));
+    EXPECT_TRUE(LikeMatcher("a%c%e").Match("abcde"));
+    EXPECT_FALSE(LikeMatcher("a%c%e").Match("abcdf"));
+    EXPECT_FALSE(LikeMatcher("a%a").Match("a"));
+    EXPECT_TRUE(LikeMatcher("a_c%").Match("abcd"));
+    EXPECT_FALSE(LikeMatcher("a_c").Match("ac"));
+    EXPECT_TRUE(LikeMatcher("%\\%%").Match("100%"));
+    EXPECT_FALSE(LikeMatcher("%\\%%").Match("100"));
+    EXPECT_EQ(LikeMatcher("http://%google%").GetPrefix(), "http://");
+    EXPECT_EQ(LikeMatcher("%goo_le%.com").GetLiterals(), std::vector<std::string>({"goo", "le", ".com"}));
+}
+
+TEST(StringFunctionsTest, UrlFunctions) {
+    EXPECT_EQ(ExtractUrlDomain("https://www.google.com/search?q=1#top"), "www.google.com");
+    EXPECT_EQ(ExtractUrlDomain("http://user@example.org:8080/path"), "example.org");
+    EXPECT_EQ(ExtractUrlDomain("example.org/path"), "example.org");
+    EXPECT_EQ(ExtractUrlDomainWithoutWww("https://www.google.com/"), "google.com");
+    EXPECT_EQ(ExtractUrlPath("https://www.google.com/search?q=1#top"), "/search");
+    EXPECT_EQ(ExtractUrlPath("https://www.google.com"), "");
+    EXPECT_EQ(ExtractUrlQueryString("https://www.google.com/search?q=1&x=2#top"), "q=1&x=2");
+    EXPECT_EQ(ExtractUrlQueryString("https://www.google.com/search"), "");
+    EXPECT_EQ(ToLower("GooGle.COM"), "google.com");
+    EXPECT_EQ(ToUpper("GooGle.com"), "GOOGLE.COM");
+}
+
+TEST(RegexTest, SearchFindReplace) {
+    Regex host("^https?://(?:www\\.)?([^/]+)/.*$");
+    EXPECT_EQ(host.GetGroupCount(), 1);
+    EXPECT_TRUE(host.Search("https://www.google.com/search"));
+    EXPECT_FALSE(host.Search("ftp://google.com/"));
+    EXPECT_FALSE(host.Search("https://google.com"));
+    EXPECT_EQ(host.Replace("https://www.google.com/search", "\\1"), "google.com");
+    EXPECT_EQ(host.Replace("http://yandex.ru/", "\\1"), "yandex.ru");
+    EXPECT_EQ(host.Replace("not a url", "\\1"), "not a url");
+
+    Regex digits("\\d+");
+    std::vector<int64_t> captures;
+    ASSERT_TRUE(digits.Find("ab123cd45", 0, captures));
+    EXPECT_EQ(captures, std::vector<int64_t>({2, 5}));
+    ASSERT_TRUE(digits.Find("ab123cd45", 5, captures));
+    EXPECT_EQ(captures, std::vector<int64_t>({7, 9}));
+    EXPECT_EQ(digits.Replace("ab123cd45", "#"), "ab#cd#");
+
+    EXPECT_TRUE(Regex("a(b|c){2,3}d").Search("xxabcbdyy"));
+    EXPECT_FALSE(Regex("a(b|c){2,3}d").Search("abd"));
+    EXPECT_TRUE(Regex("colou?r$").Search("my colour"));
+    EXPECT_FALSE(Regex("^colou?r").Search("my color"));
+    EXPECT_TRUE(Regex("^$").Search(""));
+    EXPECT_EQ(Regex("a*?").Replace("baa", "-"), "-b-a-a-");
+    EXPECT_EQ(Regex("(\\w+)@(\\w+)").Replace("x joe@mail y", "\\2:\\1"), "x mail:joe y");
+    EXPECT_THROW(Regex("(ab"), std::runtime_error);
+    EXPECT_THROW(Regex("*a"), std::runtime_error);
+}
+
+TEST(GlobalAggregationOperatorTest, Sum) {
     const char* input_csv_file = "test.csv";
     {
         std::ofstream out(input_csv_file);
         out << "Name,Age,City\n"
-            << "Jane,20,NYC\n"
-            << "Johm,20,NYC\n"
-            << "Clon,20,LA\n"
-            << "Bon,21,LA";
+            << "John,25,NYC\n"
+            << "Jane,30,LA\n"
+            << "Jane,60,NYC";
     }
     const char* output_file = "db_file.egg";
     Scheme scheme;
@@ -524,30 +1000,25 @@ TEST(GroupByAggregationOperatorTest, BasicTest) {
     const char* input_db_file = "db_file.egg";
     std::vector<std::string> columns{"Name", "Age", "City"};
     std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
-    std::vector<std::string> aggr_cols{"Age"};
-    std::vector<std::string> group_by_fields{"City"};
+    std::vector<std::string> aggr_cols = {"Age"};
     std::vector<GlobalAggregationOperator::Op> aggr_op = {GlobalAggregationOperator::Op::SUM};
-    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme);
-    std::optional<Batch> batch = group_by_operator->Next();
-    std::vector<std::string> col1{"NYC", "LA"};
-    std::vector<std::string> col2{"40", "41"};
-    std::vector<std::string> col1_res = batch.value()[0]->GetColumnAsString();
-    std::vector<std::string> col2_res = batch.value()[1]->GetColumnAsString();
-    EXPECT_EQ(col1, col1_res);
-    EXPECT_EQ(col2, col2_res);
+    std::unique_ptr<IOperator> aggr_operator = std::make_unique<GlobalAggregationOperator>(aggr_cols, std::move(scan_operator), aggr_op, scheme);
+    std::optional<Batch> batch = aggr_operator->Next();
+    std::vector<std::string> expected = {"115"};
+    std::vector<std::string> result = batch.value()[0]->GetColumnAsString();
+    EXPECT_EQ(expected, result);
     std::remove(input_csv_file);
     std::remove(input_db_file);
 }
 
-TEST(OrderByLimitKOperatorTest, BasicTest) {
+TEST(GlobalAggregationOperatorTest, Max) {
     const char* input_csv_file = "test.csv";
     {
         std::ofstream out(input_csv_file);
         out << "Name,Age,City\n"
-            << "Jane,20,NYC\n"
-            << "John,23,London\n"
-            << "Clon,21,Chicago\n"
-            << "Bon,22,LA";
+            << "John,25,NYC\n"
+            << "Jane,30,LA\n"
+            << "Jane,60,NYC";
     }
     const char* output_file = "db_file.egg";
     Scheme scheme;
@@ -561,33 +1032,1089 @@ TEST(OrderByLimitKOperatorTest, BasicTest) {
     const char* input_db_file = "db_file.egg";
     std::vector<std::string> columns{"Name", "Age", "City"};
     std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
-    int k = 3;
-    std::vector<int> order_by_ids{1};
-    bool is_desc{true};
-    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(scan_operator), k, is_desc, order_by_ids, scheme);
-    std::optional<Batch> batch = order_by_limit_operator->Next();
-    std::vector<std::string> col0_expected{"John", "Bon", "Clon"};
-    std::vector<std::string> col1_expected{"23", "22", "21"};
-    std::vector<std::string> col2_expected{"London", "LA", "Chicago"};
-    std::vector<std::string> col0_result = batch.value()[0]->GetColumnAsString();
-    std::vector<std::string> col1_result = batch.value()[1]->GetColumnAsString();
-    std::vector<std::string> col2_result = batch.value()[2]->GetColumnAsString();
-    EXPECT_EQ(col0_expected, col0_result);
-    EXPECT_EQ(col1_expected, col1_result);
-    EXPECT_EQ(col2_expected, col2_result);
+    std::vector<std::string> aggr_cols = {"Age"};
+    std::vector<GlobalAggregationOperator::Op> aggr_op = {GlobalAggregationOperator::Op::MAX};
+    std::unique_ptr<IOperator> aggr_operator = std::make_unique<GlobalAggregationOperator>(aggr_cols, std::move(scan_operator), aggr_op, scheme);
+    std::optional<Batch> batch = aggr_operator->Next();
+    std::vector<std::string> expected = {"60"};
+    std::vector<std::string> result = batch.value()[0]->GetColumnAsString();
+    EXPECT_EQ(expected, result);
     std::remove(input_csv_file);
     std::remove(input_db_file);
 }
 
-TEST(OrderByOperatorTest, BasicTest) {
+TEST(GlobalAggregationOperatorTest, CountDistinct) {
     const char* input_csv_file = "test.csv";
     {
         std::ofstream out(input_csv_file);
         out << "Name,Age,City\n"
-            << "Jane,20,NYC\n"
-            << "John,23,London\n"
-            << "Clon,21,Chicago\n"
-            << "Bon,22,LA";
+            << "John,25,NYC\n"
+            << "Jane,30,LA\n"
+            << "Jane,60,NYC";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+    std::vector<std::string> aggr_cols = {"Age"};
+    std::vector<GlobalAggregationOperator::Op> aggr_op = {GlobalAggregationOperator::Op::CountDistinct};
+    std::unique_ptr<IOperator> aggr_operator = std::make_unique<GlobalAggregationOperator>(aggr_cols, std::move(scan_operator), aggr_op, scheme);
+    std::optional<Batch> batch = aggr_operator->Next();
+    std::vector<std::string> expected = {"3"};
+    std::vector<std::string> result = batch.value()[0]->GetColumnAsString();
+    EXPECT_EQ(expected, result);
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(GlobalAggregationOperatorTest, ApproxCountDistinct) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "John,25,NYC\n"
+            << "Jane,30,LA\n"
+            << "Jane,60,NYC";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+    std::vector<std::string> aggr_cols = {"Age", "City"};
+    std::vector<GlobalAggregationOperator::Op> aggr_op = {
+        GlobalAggregationOperator::Op::ApproxCountDistinct,
+        GlobalAggregationOperator::Op::ApproxCountDistinct
+    };
+    auto aggr_operator = std::make_unique<GlobalAggregationOperator>(aggr_cols, std::move(scan_operator), aggr_op, scheme);
+    aggr_operator->SetApproxPrecision(10);
+    std::optional<Batch> batch = aggr_operator->Next();
+    EXPECT_EQ(std::vector<std::string>{"3"}, batch.value()[0]->GetColumnAsString());
+    EXPECT_EQ(std::vector<std::string>{"2"}, batch.value()[1]->GetColumnAsString());
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(HashSetTest, DistinctSets) {
+    std::vector<int64_t> dense(100000);
+    for (size_t i = 0; i < dense.size(); ++i) {
+        dense[i] = 1000 + i % 50000;
+    }
+    Int64DistinctSet dense_set;
+    dense_set.InsertBatch(dense.data(), dense.size());
+    EXPECT_TRUE(dense_set.IsBitmap());
+    EXPECT_EQ(dense_set.Size(), 50000);
+    std::vector<int64_t> outliers{5, INT64_MIN, INT64_MAX, 1000, 5};
+    dense_set.InsertBatch(outliers.data(), outliers.size());
+    EXPECT_FALSE(dense_set.IsBitmap());
+    EXPECT_EQ(dense_set.Size(), 50003);
+
+    std::vector<int32_t> sparse{1, 1 << 30, -(1 << 30), 1};
+    Int64DistinctSet sparse_set;
+    sparse_set.InsertMasked(sparse.data(), std::vector<uint64_t>{0, 1, 2, 3});
+    EXPECT_FALSE(sparse_set.IsBitmap());
+    EXPECT_EQ(sparse_set.Size(), 3);
+
+    std::vector<std::string> strings{"", "a", "b", "", "a", std::string(3 << 20, 'x'), std::string(3 << 20, 'x')};
+    for (int i = 0; i < 1000; ++i) {
+        strings.push_back("value_" + std::to_string(i % 300));
+    }
+    StringHashSet string_set;
+    string_set.InsertBatch(strings.data(), strings.size());
+    EXPECT_EQ(string_set.Size(), 304);
+    EXPECT_FALSE(string_set.Insert("value_7"));
+    EXPECT_TRUE(string_set.Insert("value_300"));
+}
+
+TEST(HyperLogLogTest, EstimateAndMerge) {
+    HyperLogLog left;
+    HyperLogLog right;
+    const int64_t count = 200000;
+    for (int64_t i = 0; i < count; ++i) {
+        left.Add(HashInt64(i));
+        right.Add(HashInt64(i + count / 2));
+    }
+    EXPECT_FALSE(left.IsSparse());
+    EXPECT_NEAR(static_cast<double>(left.Estimate()), count, count * 0.03);
+    left.Merge(right);
+    EXPECT_NEAR(static_cast<double>(left.Estimate()), count * 1.5, count * 1.5 * 0.03);
+
+    HyperLogLog small(12);
+    for (int64_t i = 0; i < 100; ++i) {
+        small.Add(HashInt64(i % 40));
+    }
+    EXPECT_TRUE(small.IsSparse());
+    EXPECT_EQ(small.Estimate(), 40);
+    std::vector<uint8_t> dense_bytes = left.Serialize();
+    std::vector<uint8_t> sparse_bytes = small.Serialize();
+    EXPECT_EQ(HyperLogLog::Deserialize(dense_bytes.data(), dense_bytes.size()).Estimate(), left.Estimate());
+    EXPECT_EQ(HyperLogLog::Deserialize(sparse_bytes.data(), sparse_bytes.size()).Estimate(), 40);
+    EXPECT_THROW(HyperLogLog::Deserialize(dense_bytes.data(), 100), std::runtime_error);
+    EXPECT_THROW(HyperLogLog(2), std::runtime_error);
+}
+
+TEST(GlobalAggregationOperatorTest, Avg) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "John,20,NYC\n"
+            << "Jane,21,LA";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+    std::vector<std::string> aggr_cols = {"Age"};
+    std::vector<GlobalAggregationOperator::Op> aggr_op = {GlobalAggregationOperator::Op::AVG};
+    std::unique_ptr<IOperator> aggr_operator = std::make_unique<GlobalAggregationOperator>(aggr_cols, std::move(scan_operator), aggr_op, scheme);
+    std::optional<Batch> batch = aggr_operator->Next();
+    std::vector<std::string> expected = {"20.500000"};
+    std::vector<std::string> result = batch.value()[0]->GetColumnAsString();
+    EXPECT_EQ(expected, result);
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(GlobalAggregationOperatorTest, ManyAggregations) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "Jane,20,NYC\n"
+            << "Jane,21,LA";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+    std::vector<std::string> aggr_cols = {"Name", "Age", "City"};
+    std::vector<GlobalAggregationOperator::Op> aggr_op = {GlobalAggregationOperator::Op::CountDistinct, GlobalAggregationOperator::Op::SUM, GlobalAggregationOperator::Op::MAX};
+    std::unique_ptr<IOperator> aggr_operator = std::make_unique<GlobalAggregationOperator>(aggr_cols, std::move(scan_operator), aggr_op, scheme);
+    std::optional<Batch> batch = aggr_operator->Next();
+    std::vector<std::string> expected = {"1", "41", "NYC"};
+    std::vector<std::string> result;
+    result.push_back(batch.value()[0]->GetColumnAsString().front());
+    result.push_back(batch.value()[1]->GetColumnAsString().front());
+    result.push_back(batch.value()[2]->GetColumnAsString().front());
+    EXPECT_EQ(expected, result);
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(GlobalAggregationOperatorTest, StatsOnlyTest) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "John,25,NYC\n"
+            << "Jane,30,LA\n"
+            << "Jane,60,NYC";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.SetExtendedStats(true);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    ScanOperator skipped_scan(input_db_file, columns);
+    int64_t stats_rows = 0;
+    skipped_scan.SetStatsConsumer([&](const BatchBlockStats&, int64_t row_count) {
+        stats_rows += row_count;
+        return true;
+    });
+    EXPECT_FALSE(skipped_scan.Next().has_value());
+    EXPECT_EQ(stats_rows, 3);
+
+    std::vector<std::string> aggr_cols = {"Age", "Age", "City", "Name"};
+    std::vector<GlobalAggregationOperator::Op> aggr_op = {
+        GlobalAggregationOperator::Op::COUNT,
+        GlobalAggregationOperator::Op::MIN,
+        GlobalAggregationOperator::Op::MAX,
+        GlobalAggregationOperator::Op::MIN
+    };
+    std::vector<std::pair<int64_t, std::vector<std::string>>> cases = {
+        {0, {"3", "25", "NYC", "Jane"}},
+        {26, {"2", "30", "NYC", "Jane"}}
+    };
+    for (const auto& [min_age, expected] : cases) {
+        std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+        std::unique_ptr<FilterCondition> condition = std::make_unique<CompareFilter<int64_t>>("Age", CompareFilter<int64_t>::Op::GE, min_age, scheme);
+        std::unique_ptr<IOperator> filter_operator = std::make_unique<FilterOperator>(std::move(scan_operator), std::move(condition));
+        std::unique_ptr<IOperator> aggr_operator = std::make_unique<GlobalAggregationOperator>(aggr_cols, std::move(filter_operator), aggr_op, scheme);
+        std::optional<Batch> batch = aggr_operator->Next();
+        std::vector<std::string> result;
+        for (const auto& column : batch.value()) {
+            result.push_back(column->GetColumnAsString().front());
+        }
+        EXPECT_EQ(expected, result);
+    }
+
+    auto make_stacked_filter = [&]() -> std::unique_ptr<IOperator> {
+        std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+        std::unique_ptr<FilterCondition> name_condition = std::make_unique<CompareFilter<std::string>>("Name", CompareFilter<std::string>::Op::EQ, std::string("Jane"), scheme);
+        std::unique_ptr<IOperator> inner_filter = std::make_unique<FilterOperator>(std::move(scan_operator), std::move(name_condition));
+        std::unique_ptr<FilterCondition> age_condition = std::make_unique<CompareFilter<int64_t>>("Age", CompareFilter<int64_t>::Op::GE, 0, scheme);
+        return std::make_unique<FilterOperator>(std::move(inner_filter), std::move(age_condition));
+    };
+    GlobalAggregationOperator stacked_aggr(aggr_cols, make_stacked_filter(), aggr_op, scheme);
+    std::optional<Batch> batch = stacked_aggr.Next();
+    std::vector<std::string> result;
+    for (const auto& column : batch.value()) {
+        result.push_back(column->GetColumnAsString().front());
+    }
+    EXPECT_EQ(result, std::vector<std::string>({"2", "30", "NYC", "Jane"}));
+    std::vector<std::string> sum_cols = {"Age", "Age"};
+    std::vector<GlobalAggregationOperator::Op> sum_op = {GlobalAggregationOperator::Op::SUM, GlobalAggregationOperator::Op::AVG};
+    GlobalAggregationOperator stacked_sum(sum_cols, make_stacked_filter(), sum_op, scheme);
+    batch = stacked_sum.Next();
+    EXPECT_EQ(batch.value()[0]->GetCellAsString(0), "90");
+    EXPECT_EQ(std::get<double>(batch.value()[1]->Get(0)), 45.0);
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(GroupByAggregationOperatorTest, BasicTest) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "Jane,20,NYC\n"
+            << "Johm,20,NYC\n"
+            << "Clon,20,LA\n"
+            << "Bon,21,LA";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+    std::vector<std::string> aggr_cols{"Age"};
+    std::vector<std::string> group_by_fields{"City"};
+    std::vector<GlobalAggregationOperator::Op> aggr_op = {GlobalAggregationOperator::Op::SUM};
+    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme);
+    std::optional<Batch> batch = group_by_operator->Next();
+    std::vector<std::string> col1{"NYC", "LA"};
+    std::vector<std::string> col2{"40", "41"};
+    std::vector<std::string> col1_res = batch.value()[0]->GetColumnAsString();
+    std::vector<std::string> col2_res = batch.value()[1]->GetColumnAsString();
+    EXPECT_EQ(col1, col1_res);
+    EXPECT_EQ(col2, col2_res);
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(ExpressionTest, FilterAndAggregateExpressions) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "John,25,NYC\n"
+            << "Jane,30,LA\n"
+            << "Bob,60,NYC\n"
+            << "Al,10,LA";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+    ExpressionPtr name = std::make_shared<ColumnRefExpression>("Name", scheme);
+    ExpressionPtr age = std::make_shared<ColumnRefExpression>("Age", scheme);
+    std::unique_ptr<FilterCondition> condition = std::make_unique<ExpressionFilter>(std::make_shared<ComparisonExpression>(
+        Column::Op::GT,
+        std::make_shared<ArithmeticExpression>(ArithmeticOp::Add, std::make_shared<StringLengthExpression>(name), age),
+        std::make_shared<LiteralExpression>(static_cast<int64_t>(20))
+    ));
+    std::optional<Batch> rows = ScanOperator(input_db_file, columns).Next();
+    std::vector<bool> row_matches;
+    for (size_t r = 0; r < 4; ++r) {
+        row_matches.push_back(condition->Evaluate(rows.value(), r));
+    }
+    EXPECT_EQ(row_matches, std::vector<bool>({true, true, true, false}));
+    ExpressionFilter constant(std::make_shared<ComparisonExpression>(
+        Column::Op::GT, std::make_shared<LiteralExpression>(static_cast<int64_t>(1)), std::make_shared<LiteralExpression>(static_cast<int64_t>(0))));
+    EXPECT_TRUE(constant.Evaluate(rows.value(), 2));
+    std::unique_ptr<IOperator> filter_operator = std::make_unique<FilterOperator>(std::move(scan_operator), std::move(condition));
+
+    std::vector<AggregationTransform> transforms(2);
+    transforms[0].expression = std::make_shared<CaseExpression>(
+        std::vector<std::pair<ExpressionPtr, ExpressionPtr>>{{
+            std::make_shared<ComparisonExpression>(Column::Op::GT, age, std::make_shared<LiteralExpression>(static_cast<int64_t>(40))),
+            std::make_shared<ArithmeticExpression>(ArithmeticOp::Multiply, age, std::make_shared<LiteralExpression>(static_cast<int64_t>(2)))
+        }},
+        age
+    );
+    transforms[1].expression = std::make_shared<PositionExpression>(name, "o");
+    std::vector<AggregationTransform> group_by_transforms(1);
+    group_by_transforms[0].expression = std::make_shared<SubstringExpression>(std::make_shared<ColumnRefExpression>("City", scheme), 1, 1);
+    std::vector<std::string> aggr_cols{"Age", "Name"};
+    std::vector<std::string> group_by_fields{"City"};
+    std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::SUM, GlobalAggregationOperator::Op::SUM};
+    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(
+        std::move(filter_operator),
+        group_by_fields,
+        aggr_cols,
+        aggr_op,
+        scheme,
+        transforms,
+        group_by_transforms
+    );
+    std::optional<Batch> batch = group_by_operator->Next();
+    ASSERT_TRUE(batch.has_value());
+    EXPECT_EQ(batch.value()[0]->GetColumnAsString(), std::vector<std::string>({"N", "L"}));
+    EXPECT_EQ(batch.value()[1]->GetColumnAsString(), std::vector<std::string>({"145", "30"}));
+    EXPECT_EQ(batch.value()[2]->GetColumnAsString(), std::vector<std::string>({"4", "0"}));
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(ExpressionTest, DateTimeExpressions) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Time,Day\n"
+            << "2013-07-14 10:23:45,2013-07-14\n"
+            << "2013-07-15 23:59:01,2013-07-15";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, {static_cast<int64_t>(Types::TypeTimestamp), static_cast<int64_t>(Types::TypeDate)});
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, std::vector<std::string>{"Time", "Day"});
+    std::optional<Batch> batch = scan_operator->Next();
+    ASSERT_TRUE(batch.has_value());
+    ExpressionPtr time = std::make_shared<ColumnRefExpression>("Time", scheme);
+    ExpressionPtr day = std::make_shared<ColumnRefExpression>("Day", scheme);
+    EXPECT_EQ(ExtractExpression(DatePart::Minute, time).Evaluate(batch.value())->GetColumnAsString(), std::vector<std::string>({"23", "59"}));
+    EXPECT_EQ(ExtractExpression(DatePart::Hour, time).Evaluate(batch.value())->GetColumnAsString(), std::vector<std::string>({"10", "23"}));
+    EXPECT_EQ(ExtractExpression(DatePart::Day, day).Evaluate(batch.value())->GetColumnAsString(), std::vector<std::string>({"14", "15"}));
+    EXPECT_EQ(
+        DateTruncExpression(DatePart::Minute, time).Evaluate(batch.value())->GetColumnAsString(),
+        std::vector<std::string>({"2013-07-14 10:23:00", "2013-07-15 23:59:00"})
+    );
+    EXPECT_EQ(
+        DateTruncExpression(DatePart::Day, time).Evaluate(batch.value())->GetColumnAsString(),
+        std::vector<std::string>({"2013-07-14 00:00:00", "2013-07-15 00:00:00"})
+    );
+    ComparisonExpression after_first_day(Column::Op::GT, day, std::make_shared<LiteralExpression>(std::string("2013-07-14")));
+    EXPECT_EQ(after_first_day.Evaluate(batch.value())->GetColumnAsString(), std::vector<std::string>({"0", "1"}));
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(ExpressionTest, StringAndRegexpExpressions) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "John,25,https://www.google.com/maps\n"
+            << "Jane,30,http://yandex.ru/search?q=1\n"
+            << "Bob,60,https://www.google.com/mail\n"
+            << "Al,10,plain";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+    ExpressionPtr city = std::make_shared<ColumnRefExpression>("City", scheme);
+    std::unique_ptr<FilterCondition> condition =
+        std::make_unique<ExpressionFilter>(std::make_shared<RegexpMatchExpression>(city, "^https?://"));
+    std::unique_ptr<IOperator> filter_operator = std::make_unique<FilterOperator>(std::move(scan_operator), std::move(condition));
+    auto projection_operator = std::make_unique<ProjectionOperator>(
+        std::move(filter_operator),
+        std::vector<ExpressionPtr>{
+            std::make_shared<StringFunctionExpression>(StringFunction::DomainWithoutWww, city),
+            std::make_shared<StringFunctionExpression>(StringFunction::Path, city),
+            std::make_shared<StringFunctionExpression>(StringFunction::Upper, std::make_shared<ColumnRefExpression>("Name", scheme)),
+            std::make_shared<RegexpReplaceExpression>(city, "^https?://(?:www\\.)?([^/]+)/.*$", "\\1")
+        },
+        std::vector<std::string>{"Domain", "Path", "Name", "Host"}
+    );
+    std::optional<Batch> batch = projection_operator->Next();
+    ASSERT_TRUE(batch.has_value());
+    EXPECT_EQ(batch.value()[0]->GetColumnAsString(), std::vector<std::string>({"google.com", "yandex.ru", "google.com"}));
+    EXPECT_EQ(batch.value()[1]->GetColumnAsString(), std::vector<std::string>({"/maps", "/search", "/mail"}));
+    EXPECT_EQ(batch.value()[2]->GetColumnAsString(), std::vector<std::string>({"JOHN", "JANE", "BOB"}));
+    EXPECT_EQ(batch.value()[3]->GetColumnAsString(), std::vector<std::string>({"google.com", "yandex.ru", "google.com"}));
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(ProjectionOperatorTest, DerivedColumns) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "John,25,NYC\n"
+            << "Jane,30,LA\n"
+            << "Bob,60,NYC\n"
+            << "Al,10,LA";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+    ExpressionPtr age = std::make_shared<ColumnRefExpression>("Age", scheme);
+    auto projection_operator = std::make_unique<ProjectionOperator>(
+        std::move(scan_operator),
+        std::vector<ExpressionPtr>{
+            std::make_shared<ColumnRefExpression>("City", scheme),
+            std::make_shared<ArithmeticExpression>(ArithmeticOp::Multiply, age, std::make_shared<LiteralExpression>(static_cast<int64_t>(2))),
+            age
+        },
+        std::vector<std::string>{"City", "DoubleAge", "Age"}
+    );
+    Scheme projection_scheme = projection_operator->GetScheme();
+    EXPECT_EQ(projection_operator->GetCurrColIds(), std::vector<int>({0, 1, 2}));
+    EXPECT_EQ(projection_operator->GetCurrColTypes()[1], static_cast<int64_t>(Types::TypeInt64));
+
+    std::unique_ptr<FilterCondition> condition = std::make_unique<CompareFilter<int64_t>>(
+        "DoubleAge", CompareFilter<int64_t>::Op::GT, static_cast<int64_t>(50), projection_scheme
+    );
+    std::unique_ptr<IOperator> filter_operator = std::make_unique<FilterOperator>(std::move(projection_operator), std::move(condition));
+    std::vector<std::string> aggr_cols{"DoubleAge", "Age"};
+    std::vector<std::string> group_by_fields{"City"};
+    std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::SUM, GlobalAggregationOperator::Op::SUM};
+    std::unique_ptr<IOperator> group_by_operator = std::make_unique<GroupByAggregationOperator>(
+        std::move(filter_operator), group_by_fields, aggr_cols, aggr_op, projection_scheme
+    );
+    std::optional<Batch> batch = group_by_operator->Next();
+    ASSERT_TRUE(batch.has_value());
+    EXPECT_EQ(batch.value()[0]->GetColumnAsString(), std::vector<std::string>({"LA", "NYC"}));
+    EXPECT_EQ(batch.value()[1]->GetColumnAsString(), std::vector<std::string>({"60", "120"}));
+    EXPECT_EQ(batch.value()[2]->GetColumnAsString(), std::vector<std::string>({"30", "60"}));
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(ProjectionOperatorTest, PushPipelineTest) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "John,25,NYC\n"
+            << "Jane,30,LA\n"
+            << "Bob,60,NYC\n"
+            << "Al,10,LA";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+    std::unique_ptr<FilterCondition> condition = std::make_unique<CompareFilter<int64_t>>("Age", CompareFilter<int64_t>::Op::GE, 25, scheme);
+    std::unique_ptr<IOperator> filter_operator = std::make_unique<FilterOperator>(std::move(scan_operator), std::move(condition));
+    auto projection_operator = std::make_unique<ProjectionOperator>(
+        std::move(filter_operator),
+        std::vector<ExpressionPtr>{std::make_shared<ColumnRefExpression>("Name", scheme), std::make_shared<ColumnRefExpression>("Age", scheme)},
+        std::vector<std::string>{"Name", "Age"}
+    );
+    Scheme projection_scheme = projection_operator->GetScheme();
+    std::vector<std::string> aggr_cols{"Age"};
+    std::vector<GlobalAggregationOperator::Op> aggr_op{GlobalAggregationOperator::Op::SUM};
+    GlobalAggregationOperator sink(aggr_cols, nullptr, aggr_op, projection_scheme);
+    std::vector<std::string> names;
+    projection_operator->Produce([&](Batch& batch) {
+        for (const auto& name : batch[0]->GetColumnAsString()) {
+            names.push_back(name);
+        }
+        sink.ConsumeBatch(batch);
+    });
+    EXPECT_EQ(names, std::vector<std::string>({"John", "Jane", "Bob"}));
+    std::optional<Batch> batch = sink.Next();
+    ASSERT_TRUE(batch.has_value());
+    EXPECT_EQ(batch.value()[0]->GetColumnAsString(), std::vector<std::string>({"115"}));
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(GroupByAggregationOperatorTest, CountDistinctTest) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "Jane,20,NYC\n"
+            << "Jane,21,NYC\n"
+            << "Clon,20,LA\n"
+            << "Bon,20,LA\n"
+            << "Jane,20,LA\n"
+            << "Bon,22,NYC";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    std::vector<std::string> aggr_cols{"Name", "Age"};
+    std::vector<std::string> group_by_fields{"City"};
+    std::vector<GlobalAggregationOperator::Op> aggr_op = {
+        GlobalAggregationOperator::Op::CountDistinct,
+        GlobalAggregationOperator::Op::CountDistinct
+    };
+    for (bool is_approx : {false, true}) {
+        std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+        auto group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme);
+        group_by_operator->SetApproxDistinct(is_approx);
+        std::optional<Batch> batch = group_by_operator->Next();
+        std::vector<std::string> col0{"NYC", "LA"};
+        std::vector<std::string> col1{"2", "3"};
+        std::vector<std::string> col2{"3", "1"};
+        EXPECT_EQ(col0, batch.value()[0]->GetColumnAsString());
+        EXPECT_EQ(col1, batch.value()[1]->GetColumnAsString());
+        EXPECT_EQ(col2, batch.value()[2]->GetColumnAsString());
+    }
+
+    GroupedDistinctState left_state;
+    GroupedDistinctState right_state;
+    GroupedCountDistinctAccumulator left(&left_state, 0);
+    GroupedCountDistinctAccumulator right(&right_state, 1);
+    GroupedCountDistinctAccumulator other_group(&right_state, 0);
+    left.Update(std::make_unique<String>(std::vector<std::string>{"a", "b"}).get());
+    right.Update(std::make_unique<String>(std::vector<std::string>{"b", "c", "d"}).get());
+    other_group.Update(std::make_unique<String>(std::vector<std::string>{"e"}).get());
+    left.Merge(right);
+    EXPECT_EQ(left.GetResult(), CellTypes(int64_t{4}));
+    other_group.Merge(right);
+    EXPECT_EQ(other_group.GetResult(), CellTypes(int64_t{4}));
+    EXPECT_EQ(right.GetResult(), CellTypes(int64_t{3}));
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(QueryArenaTest, AllocationAndReleaseTest) {
+    QueryArena arena(false, 4096);
+    {
+        std::pmr::vector<int64_t> values(&arena);
+        for (int64_t i = 0; i < 1000; ++i) {
+            values.push_back(i);
+        }
+        EXPECT_EQ(values[999], 999);
+        void* aligned = arena.allocate(24, 64);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 64, 0);
+    }
+    EXPECT_GE(arena.GetBytesAllocated(), 1000 * sizeof(int64_t));
+    EXPECT_GE(arena.GetBytesReserved(), arena.GetBytesAllocated());
+    EXPECT_EQ(arena.GetBytesReserved() % 4096, 0);
+
+    StringHashSet set(&arena);
+    std::string long_value(5000, 'x');
+    EXPECT_TRUE(set.Insert("abc"));
+    EXPECT_TRUE(set.Insert(long_value));
+    EXPECT_FALSE(set.Insert("abc"));
+    EXPECT_TRUE(set.Contains(long_value));
+    EXPECT_EQ(set.Size(), 2);
+
+    arena.Release();
+    EXPECT_EQ(arena.GetBytesAllocated(), 0);
+    EXPECT_EQ(arena.GetBytesReserved(), 0);
+    EXPECT_EQ(arena.GetBlockCount(), 0);
+}
+
+TEST(QueryArenaTest, GroupByTest) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "Jane,20,NYC\n"
+            << "Jane,21,NYC\n"
+            << "Clon,20,LA\n"
+            << "Bon,20,LA\n"
+            << "Jane,20,LA\n"
+            << "Bon,22,NYC";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    std::vector<std::string> aggr_cols{"Name", "Age"};
+    std::vector<std::string> group_by_fields{"City"};
+    std::vector<GlobalAggregationOperator::Op> aggr_op = {
+        GlobalAggregationOperator::Op::CountDistinct,
+        GlobalAggregationOperator::Op::SUM
+    };
+    QueryArena arena(true);
+    {
+        std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+        auto group_by_operator = std::make_unique<GroupByAggregationOperator>(std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme);
+        group_by_operator->SetMemoryResource(&arena);
+        std::optional<Batch> batch = group_by_operator->Next();
+        std::vector<std::string> col0{"NYC", "LA"};
+        std::vector<std::string> col1{"2", "3"};
+        std::vector<std::string> col2{"63", "60"};
+        EXPECT_EQ(col0, batch.value()[0]->GetColumnAsString());
+        EXPECT_EQ(col1, batch.value()[1]->GetColumnAsString());
+        EXPECT_EQ(col2, batch.value()[2]->GetColumnAsString());
+        EXPECT_GT(arena.GetBytesAllocated(), 0);
+        EXPECT_THROW(group_by_operator->SetMemoryResource(std::pmr::get_default_resource()), std::runtime_error);
+    }
+    arena.Release();
+    EXPECT_EQ(arena.GetBytesReserved(), 0);
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(ThreadPoolTest, TaskGroupTest) {
+    ThreadPool pool(2);
+    std::atomic<int64_t> sum = 0;
+    TaskGroup group(pool);
+    for (int64_t i = 1; i <= 8; ++i) {
+        group.Submit([&pool, &sum, i]() {
+            TaskGroup nested(pool);
+            for (int64_t j = 0; j < 10; ++j) {
+                nested.Submit([&sum, i]() { sum += i; });
+            }
+            nested.Wait();
+        });
+    }
+    group.Wait();
+    EXPECT_EQ(sum.load(), 360);
+
+    TaskGroup failing(pool);
+    failing.Submit([]() { throw std::runtime_error("task failed"); });
+    failing.Submit([&sum]() { ++sum; });
+    EXPECT_THROW(failing.Wait(), std::runtime_error);
+    EXPECT_EQ(sum.load(), 361);
+}
+
+TEST(ParallelOperatorTest, MergeAndGatherTest) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "Jane,20,NYC\n"
+            << "Jane,21,NYC\n"
+            << "Clon,20,LA\n"
+            << "Bon,20,LA\n"
+            << "Jane,20,LA\n"
+            << "Bon,22,NYC";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    std::vector<std::string> aggr_cols{"Name", "Age"};
+    std::vector<std::string> group_by_fields{"City"};
+    std::vector<GlobalAggregationOperator::Op> aggr_op = {
+        GlobalAggregationOperator::Op::CountDistinct,
+        GlobalAggregationOperator::Op::SUM
+    };
+    auto make_group_by = [&](std::unique_ptr<IOperator> child) {
+        return std::make_unique<GroupByAggregationOperator>(std::move(child), group_by_fields, aggr_cols, aggr_op, scheme);
+    };
+
+    auto merged = make_group_by(std::make_unique<ScanOperator>(input_db_file, columns));
+    auto partial = make_group_by(std::make_unique<ScanOperator>(input_db_file, columns));
+    merged->MergeFrom(*partial);
+    std::optional<Batch> batch = merged->Next();
+    EXPECT_EQ(batch.value()[0]->GetColumnAsString(), std::vector<std::string>({"NYC", "LA"}));
+    EXPECT_EQ(batch.value()[1]->GetColumnAsString(), std::vector<std::string>({"2", "3"}));
+    EXPECT_EQ(batch.value()[2]->GetColumnAsString(), std::vector<std::string>({"126", "120"}));
+
+    ThreadPool pool(4);
+    ParallelOperator group_by(
+        [&](std::shared_ptr<MorselQueue> morsels) {
+            auto scan = std::make_unique<ScanOperator>(input_db_file, columns);
+            scan->SetMorselQueue(std::move(morsels));
+            return make_group_by(std::move(scan));
+        },
+        pool
+    );
+    batch = group_by.Next();
+    EXPECT_EQ(batch.value()[0]->GetColumnAsString(), std::vector<std::string>({"NYC", "LA"}));
+    EXPECT_EQ(batch.value()[1]->GetColumnAsString(), std::vector<std::string>({"2", "3"}));
+    EXPECT_EQ(batch.value()[2]->GetColumnAsString(), std::vector<std::string>({"63", "60"}));
+
+    ParallelOperator global(
+        [&](std::shared_ptr<MorselQueue> morsels) -> std::unique_ptr<IOperator> {
+            auto scan = std::make_unique<ScanOperator>(input_db_file, columns);
+            scan->SetMorselQueue(std::move(morsels));
+            std::vector<std::string> global_cols{"Age", "Age"};
+            std::vector<GlobalAggregationOperator::Op> ops{GlobalAggregationOperator::Op::MAX, GlobalAggregationOperator::Op::COUNT};
+            return std::make_unique<GlobalAggregationOperator>(global_cols, std::move(scan), ops, scheme);
+        },
+        pool
+    );
+    batch = global.Next();
+    EXPECT_EQ(batch.value()[0]->GetColumnAsString(), std::vector<std::string>({"22"}));
+    EXPECT_EQ(batch.value()[1]->GetColumnAsString(), std::vector<std::string>({"6"}));
+
+    ParallelOperator gather(
+        [&](std::shared_ptr<MorselQueue> morsels) -> std::unique_ptr<IOperator> {
+            auto scan = std::make_unique<ScanOperator>(input_db_file, columns);
+            scan->SetMorselQueue(std::move(morsels));
+            auto condition = std::make_unique<CompareFilter<int64_t>>("Age", Column::Op::EQ, 20, scheme);
+            return std::make_unique<FilterOperator>(std::move(scan), std::move(condition));
+        },
+        pool
+    );
+    std::vector<std::string> names;
+    while (auto filtered = gather.Next()) {
+        for (const auto& name : filtered.value()[0]->GetColumnAsString()) {
+            names.push_back(name);
+        }
+    }
+    EXPECT_EQ(names, std::vector<std::string>({"Jane", "Clon", "Bon", "Jane"}));
+
+    ParallelOperator top_k(
+        [&](std::shared_ptr<MorselQueue> morsels) -> std::unique_ptr<IOperator> {
+            auto scan = std::make_unique<ScanOperator>(input_db_file, columns);
+            scan->SetMorselQueue(std::move(morsels));
+            return std::make_unique<OrderByLimitKOperator>(std::move(scan), 2, true, std::vector<int>{1}, scheme);
+        },
+        pool
+    );
+    batch = top_k.Next();
+    EXPECT_EQ(batch.value()[1]->GetColumnAsString(), std::vector<std::string>({"22", "21"}));
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(ParallelOperatorTest, BoundedGatherTest) {
+    const char* input_csv_file = "test.csv";
+    const int64_t row_count = 300;
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City";
+        for (int64_t i = 0; i < row_count; ++i) {
+            out << "\nn" << i << "," << i << ",c" << i % 7;
+        }
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.SetRowGroupSize(1);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    ThreadPool pool(4);
+    for (size_t pipeline_count : {size_t{1}, size_t{4}}) {
+        ParallelOperator gather(
+            [&](std::shared_ptr<MorselQueue> morsels) -> std::unique_ptr<IOperator> {
+                auto scan = std::make_unique<ScanOperator>(input_db_file, columns);
+                scan->SetMorselQueue(std::move(morsels));
+                return scan;
+            },
+            pool,
+            pipeline_count
+        );
+        int64_t age_sum = 0;
+        int64_t batch_count = 0;
+        while (auto batch = gather.Next()) {
+            ++batch_count;
+            for (const auto& age : batch.value()[1]->GetColumnAsString()) {
+                age_sum += std::stoll(age);
+            }
+        }
+        EXPECT_EQ(batch_count, row_count);
+        EXPECT_EQ(age_sum, row_count * (row_count - 1) / 2);
+    }
+    {
+        ParallelOperator cancelled(
+            [&](std::shared_ptr<MorselQueue> morsels) -> std::unique_ptr<IOperator> {
+                auto scan = std::make_unique<ScanOperator>(input_db_file, columns);
+                scan->SetMorselQueue(std::move(morsels));
+                return scan;
+            },
+            pool
+        );
+        EXPECT_TRUE(cancelled.Next().has_value());
+    }
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(OrderByLimitKOperatorTest, BasicTest) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "Jane,20,NYC\n"
+            << "John,23,London\n"
+            << "Clon,21,Chicago\n"
+            << "Bon,22,LA";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+    int k = 3;
+    std::vector<int> order_by_ids{1};
+    bool is_desc{true};
+    std::unique_ptr<IOperator> order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(scan_operator), k, is_desc, order_by_ids, scheme);
+    std::optional<Batch> batch = order_by_limit_operator->Next();
+    std::vector<std::string> col0_expected{"John", "Bon", "Clon"};
+    std::vector<std::string> col1_expected{"23", "22", "21"};
+    std::vector<std::string> col2_expected{"London", "LA", "Chicago"};
+    std::vector<std::string> col0_result = batch.value()[0]->GetColumnAsString();
+    std::vector<std::string> col1_result = batch.value()[1]->GetColumnAsString();
+    std::vector<std::string> col2_result = batch.value()[2]->GetColumnAsString();
+    EXPECT_EQ(col0_expected, col0_result);
+    EXPECT_EQ(col1_expected, col1_result);
+    EXPECT_EQ(col2_expected, col2_result);
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(OrderByLimitKOperatorTest, StatsOrderedScanTest) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "Jane,30,NYC\n"
+            << "John,10,London\n"
+            << "Clon,50,Chicago\n"
+            << "Bon,20,LA\n"
+            << "Ron,60,Boston\n"
+            << "Don,40,Paris";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.SetRowGroupSize(1);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"City", "Age"};
+    ScanOperator ordered_scan(input_db_file, columns);
+    ordered_scan.OrderBatchesByStats(1, true);
+    std::vector<std::string> scanned_ages;
+    while (std::optional<Batch> batch = ordered_scan.Next()) {
+        scanned_ages.push_back(batch.value()[1]->GetCellAsString(0));
+    }
+    EXPECT_EQ(scanned_ages, std::vector<std::string>({"60", "50", "40", "30", "20", "10"}));
+
+    auto run_top_k = [&](bool stats_ordered, int64_t& evaluate_calls) {
+        std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+        std::unique_ptr<FilterCondition> condition = std::make_unique<LikeFilter>("City", "%", scheme);
+        std::unique_ptr<FilterCondition> counting = std::make_unique<CountingFilter>(std::move(condition), evaluate_calls);
+        std::unique_ptr<IOperator> filter_operator = std::make_unique<FilterOperator>(std::move(scan_operator), std::move(counting));
+        auto order_by_limit_operator = std::make_unique<OrderByLimitKOperator>(std::move(filter_operator), 2, false, std::vector<int>{1}, scheme);
+        if (stats_ordered) {
+            order_by_limit_operator->EnableStatsOrderedScan();
+        }
+        return order_by_limit_operator->Next();
+    };
+    int64_t evaluate_calls = 0;
+    std::optional<Batch> batch = run_top_k(false, evaluate_calls);
+    EXPECT_EQ(batch.value()[0]->GetColumnAsString(), std::vector<std::string>({"London", "LA"}));
+    EXPECT_EQ(batch.value()[1]->GetColumnAsString(), std::vector<std::string>({"10", "20"}));
+    EXPECT_EQ(evaluate_calls, 3);
+    evaluate_calls = 0;
+    batch = run_top_k(true, evaluate_calls);
+    EXPECT_EQ(batch.value()[0]->GetColumnAsString(), std::vector<std::string>({"London", "LA"}));
+    EXPECT_EQ(batch.value()[1]->GetColumnAsString(), std::vector<std::string>({"10", "20"}));
+    EXPECT_EQ(evaluate_calls, 2);
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(OrderByLimitKOperatorTest, LateMaterializedTest) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "Jane,20,NYC\n"
+            << "John,23,London\n"
+            << "Clon,21,Chicago\n"
+            << "Bon,22,LA";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> narrow_columns{"Age"};
+    auto scan_operator = std::make_unique<ScanOperator>(input_db_file, narrow_columns);
+    scan_operator->EnableRowIds();
+    std::unique_ptr<FilterCondition> condition = std::make_unique<CompareFilter<int64_t>>("Age", CompareFilter<int64_t>::Op::NE, 23, scheme);
+    std::unique_ptr<IOperator> filter_operator = std::make_unique<FilterOperator>(std::move(scan_operator), std::move(condition));
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    std::vector<int> order_by_ids{0};
+    std::unique_ptr<IOperator> top_k_operator = std::make_unique<LateMaterializedTopKOperator>(std::move(filter_operator), 2, true, order_by_ids, input_db_file, columns, scheme);
+    std::optional<Batch> batch = top_k_operator->Next();
+    std::vector<std::string> col0_expected{"Bon", "Clon"};
+    std::vector<std::string> col1_expected{"22", "21"};
+    std::vector<std::string> col2_expected{"LA", "Chicago"};
+    EXPECT_EQ(col0_expected, batch.value()[0]->GetColumnAsString());
+    EXPECT_EQ(col1_expected, batch.value()[1]->GetColumnAsString());
+    EXPECT_EQ(col2_expected, batch.value()[2]->GetColumnAsString());
+    EXPECT_FALSE(top_k_operator->Next().has_value());
+
+    auto empty_scan = std::make_unique<ScanOperator>(input_db_file, narrow_columns);
+    empty_scan->EnableRowIds();
+    std::unique_ptr<FilterCondition> no_rows = std::make_unique<AndFilter>(
+        std::make_unique<CompareFilter<int64_t>>("Age", CompareFilter<int64_t>::Op::EQ, 20, scheme),
+        std::make_unique<CompareFilter<int64_t>>("Age", CompareFilter<int64_t>::Op::EQ, 22, scheme));
+    std::unique_ptr<IOperator> empty_filter = std::make_unique<FilterOperator>(std::move(empty_scan), std::move(no_rows));
+    LateMaterializedTopKOperator empty_top_k(std::move(empty_filter), 2, true, order_by_ids, input_db_file, columns, scheme);
+    batch = empty_top_k.Next();
+    ASSERT_TRUE(batch.has_value());
+    ASSERT_EQ(batch.value().size(), columns.size());
+    for (const auto& column : batch.value()) {
+        EXPECT_EQ(column->GetRowCount(), 0);
+    }
+    EXPECT_EQ(batch.value()[1]->GetColumnAsString(), std::vector<std::string>{});
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(OrderByLimitKOperatorTest, ThresholdFilterTest) {
+    BatchBlockStats batch_stats{
+        ColumnBlockStats{.min_value = CellTypes(std::string("a")), .max_value = CellTypes(std::string("z"))},
+        ColumnBlockStats{.min_value = CellTypes(int64_t{10}), .max_value = CellTypes(int64_t{20})}
+    };
+    TopKThresholdFilter asc_filter(1, false, true);
+    EXPECT_FALSE(asc_filter.CanSkipBatch(batch_stats));
+    asc_filter.SetThreshold(CellTypes(int64_t{15}));
+    EXPECT_FALSE(asc_filter.CanSkipBatch(batch_stats));
+    asc_filter.SetThreshold(CellTypes(int64_t{10}));
+    EXPECT_TRUE(asc_filter.CanSkipBatch(batch_stats));
+
+    TopKThresholdFilter asc_ties_filter(1, false, false);
+    asc_ties_filter.SetThreshold(CellTypes(int64_t{10}));
+    EXPECT_FALSE(asc_ties_filter.CanSkipBatch(batch_stats));
+    asc_ties_filter.SetThreshold(CellTypes(int64_t{9}));
+    EXPECT_TRUE(asc_ties_filter.CanSkipBatch(batch_stats));
+
+    TopKThresholdFilter desc_filter(0, true, true);
+    desc_filter.SetThreshold(CellTypes(std::string("y")));
+    EXPECT_FALSE(desc_filter.CanSkipBatch(batch_stats));
+    desc_filter.SetThreshold(CellTypes(std::string("z")));
+    EXPECT_TRUE(desc_filter.CanSkipBatch(batch_stats));
+}
+
+TEST(OrderByOperatorTest, BasicTest) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "Jane,20,NYC\n"
+            << "John,23,London\n"
+            << "Clon,21,Chicago\n"
+            << "Bon,22,LA";
     }
     const char* output_file = "db_file.egg";
     Scheme scheme;
@@ -618,3 +2145,215 @@ TEST(OrderByOperatorTest, BasicTest) {
     std::remove(input_csv_file);
     std::remove(input_db_file);
 }
+
+TEST(OrderByOperatorTest, MixedDirectionTest) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "Jane,20,NYC\n"
+            << "John,-23,London\n"
+            << "Clon,21,NYC\n"
+            << "Bon,22,LA\n"
+            << "Ron,24,London\n"
+            << "Al,21,NY";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+    std::vector<int> order_by_ids{2, 1};
+    std::vector<bool> is_desc{false, true};
+    std::unique_ptr<IOperator> order_by_operator = std::make_unique<OrderByOperator>(std::move(scan_operator), order_by_ids, is_desc, scheme);
+    std::optional<Batch> batch = order_by_operator->Next();
+    std::vector<std::string> col0_expected{"Bon", "Ron", "John", "Al", "Clon", "Jane"};
+    std::vector<std::string> col1_expected{"22", "24", "-23", "21", "21", "20"};
+    std::vector<std::string> col2_expected{"LA", "London", "London", "NY", "NYC", "NYC"};
+    std::vector<std::string> col0_result = batch.value()[0]->GetColumnAsString();
+    std::vector<std::string> col1_result = batch.value()[1]->GetColumnAsString();
+    std::vector<std::string> col2_result = batch.value()[2]->GetColumnAsString();
+    EXPECT_EQ(col0_expected, col0_result);
+    EXPECT_EQ(col1_expected, col1_result);
+    EXPECT_EQ(col2_expected, col2_result);
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(OrderByOperatorTest, SpillTest) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "Jane,20,NYC\n"
+            << "John,-23,London\n"
+            << "Clon,21,NYC\n"
+            << "Bon,22,LA\n"
+            << "Ron,24,London\n"
+            << "Al,21,NY";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+    std::vector<int> order_by_ids{2, 1};
+    std::vector<bool> is_desc{false, true};
+    auto order_by_operator = std::make_unique<OrderByOperator>(std::move(scan_operator), order_by_ids, is_desc, scheme);
+    order_by_operator->SetMemoryLimit(1);
+    std::optional<Batch> batch = order_by_operator->Next();
+    std::vector<std::string> col0_expected{"Bon", "Ron", "John", "Al", "Clon", "Jane"};
+    std::vector<std::string> col1_expected{"22", "24", "-23", "21", "21", "20"};
+    std::vector<std::string> col2_expected{"LA", "London", "London", "NY", "NYC", "NYC"};
+    EXPECT_EQ(col0_expected, batch.value()[0]->GetColumnAsString());
+    EXPECT_EQ(col1_expected, batch.value()[1]->GetColumnAsString());
+    EXPECT_EQ(col2_expected, batch.value()[2]->GetColumnAsString());
+    EXPECT_FALSE(order_by_operator->Next().has_value());
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(OrderByOperatorTest, SpillManyRunsTest) {
+    const char* input_csv_file = "test.csv";
+    const int64_t row_count = 20000;
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City";
+        for (int64_t i = 0; i < row_count; ++i) {
+            out << "\nn" << i << "," << i * 7919 % row_count << ",c" << i % 3;
+        }
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    auto scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+    scan_operator->SetVectorSize(9000);
+    auto order_by_operator = std::make_unique<OrderByOperator>(std::move(scan_operator), std::vector<int>{1}, true, scheme);
+    order_by_operator->SetMemoryLimit(1);
+    std::vector<std::string> ages;
+    while (std::optional<Batch> batch = order_by_operator->Next()) {
+        std::vector<std::string> values = batch.value()[1]->GetColumnAsString();
+        ages.insert(ages.end(), values.begin(), values.end());
+    }
+    ASSERT_EQ(ages.size(), static_cast<size_t>(row_count));
+    for (int64_t i = 0; i < row_count; ++i) {
+        EXPECT_EQ(ages[i], std::to_string(row_count - 1 - i));
+    }
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}
+
+TEST(ExternalSortTest, MergeRuns) {
+    std::vector<std::vector<int64_t>> runs_values{{1, 4, 7, 10}, {2, 5, 8}, {3, 6, 9, 11, 12}};
+    std::vector<std::string> paths;
+    Batch prototype;
+    prototype.push_back(std::make_unique<Int64>());
+    for (size_t i = 0; i < runs_values.size(); ++i) {
+        Batch batch;
+        batch.push_back(std::make_unique<Int64>());
+        std::vector<std::string> keys;
+        for (int64_t value : runs_values[i]) {
+            batch[0]->AddCell(CellTypes(value));
+        }
+        keys.resize(runs_values[i].size());
+        batch[0]->AppendSortKeys(keys, false);
+        paths.push_back("run_" + std::to_string(i) + ".tmp");
+        SortRunWriter run_writer(paths.back(), 2);
+        run_writer.Write(batch, keys);
+    }
+    std::vector<std::unique_ptr<SortRunReader>> runs;
+    for (const auto& path : paths) {
+        runs.push_back(std::make_unique<SortRunReader>(path, prototype));
+    }
+    LoserTree tree(runs.size(), [&](int64_t a, int64_t b) {
+        if (runs[a]->IsExhausted()) {
+            return false;
+        }
+        return runs[b]->IsExhausted() || runs[a]->GetKey() < runs[b]->GetKey();
+    });
+    std::vector<std::string> result;
+    while (!runs[tree.GetWinner()]->IsExhausted()) {
+        auto& run = *runs[tree.GetWinner()];
+        result.push_back(run.GetChunk()[0]->GetCellAsString(run.GetRow()));
+        run.Advance();
+        tree.Replay();
+    }
+    std::vector<std::string> expected{"1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11", "12"};
+    EXPECT_EQ(expected, result);
+    runs.clear();
+    for (const auto& path : paths) {
+        EXPECT_FALSE(std::filesystem::exists(path));
+    }
+}
+
+TEST(GroupByOrderByLimitKOperatorTest, BasicTest) {
+    const char* input_csv_file = "test.csv";
+    {
+        std::ofstream out(input_csv_file);
+        out << "Name,Age,City\n"
+            << "Jane,20,NYC\n"
+            << "John,23,London\n"
+            << "Clon,21,NYC\n"
+            << "Bon,22,LA\n"
+            << "Ron,24,London\n"
+            << "Don,25,NYC";
+    }
+    const char* output_file = "db_file.egg";
+    Scheme scheme;
+    CSVWrapper parser(input_csv_file);
+    parser.SetScheme(scheme, GetSimpleCsvTypes());
+    std::ofstream output(output_file, std::ios::binary);
+    RowGroupWriter writer(std::move(parser), output, scheme);
+    writer.WriteAll();
+    output.close();
+
+    const char* input_db_file = "db_file.egg";
+    std::vector<std::string> columns{"Name", "Age", "City"};
+    std::unique_ptr<IOperator> scan_operator = std::make_unique<ScanOperator>(input_db_file, columns);
+    std::vector<std::string> group_by_fields{"City"};
+    std::vector<std::string> aggr_cols{"Age", "Age"};
+    std::vector<GlobalAggregationOperator::Op> aggr_op = {GlobalAggregationOperator::Op::COUNT, GlobalAggregationOperator::Op::SUM};
+    int k = 2;
+    std::vector<int> order_by_ids{1, 2};
+    bool is_desc{true};
+    std::unique_ptr<IOperator> top_k_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::move(scan_operator), group_by_fields, aggr_cols, aggr_op, scheme, k, is_desc, order_by_ids);
+    std::optional<Batch> batch = top_k_operator->Next();
+    std::vector<std::string> col0_expected{"NYC", "London"};
+    std::vector<std::string> col1_expected{"3", "2"};
+    std::vector<std::string> col2_expected{"66", "47"};
+    EXPECT_EQ(col0_expected, batch.value()[0]->GetColumnAsString());
+    EXPECT_EQ(col1_expected, batch.value()[1]->GetColumnAsString());
+    EXPECT_EQ(col2_expected, batch.value()[2]->GetColumnAsString());
+    EXPECT_FALSE(top_k_operator->Next().has_value());
+
+    std::unique_ptr<IOperator> by_name_operator = std::make_unique<GroupByOrderByLimitKOperator>(
+        std::make_unique<ScanOperator>(input_db_file, columns), group_by_fields, aggr_cols, aggr_op, scheme, 5, false, std::vector<int>{0});
+    batch = by_name_operator->Next();
+    EXPECT_EQ(std::vector<std::string>({"LA", "London", "NYC"}), batch.value()[0]->GetColumnAsString());
+    EXPECT_EQ(std::vector<std::string>({"1", "2", "3"}), batch.value()[1]->GetColumnAsString());
+    std::remove(input_csv_file);
+    std::remove(input_db_file);
+}